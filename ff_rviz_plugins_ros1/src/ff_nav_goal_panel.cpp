@@ -96,7 +96,8 @@ void FFNavToolPanel::send_nav_goal()
     };
   }
 
-  if (!_free_fleet_server->send_destination_request(destination_request))
+  if (!_free_fleet_server->send_destination_request(
+      std::move(destination_request)))
   {
     std::string debug_str = "Failed to send navigation request...";
     _debug_label->setText(QString::fromStdString(debug_str));
@@ -18,7 +18,9 @@
 #ifndef FREE_FLEET__INCLUDE__FREE_FLEET__CLIENT_HPP
 #define FREE_FLEET__INCLUDE__FREE_FLEET__CLIENT_HPP
 
+#include <chrono>
 #include <memory>
+#include <cstdint>
 
 #include <free_fleet/ClientConfig.hpp>
 
@@ -26,6 +28,7 @@
 #include <free_fleet/messages/ModeRequest.hpp>
 #include <free_fleet/messages/PathRequest.hpp>
 #include <free_fleet/messages/DestinationRequest.hpp>
+#include <free_fleet/messages/RequestAck.hpp>
 
 namespace free_fleet {
 
@@ -44,15 +47,24 @@ public:
   static SharedPtr make(const ClientConfig& config);
 
   /// Attempts to send a new robot state to the free fleet server, to be 
-  /// registered by the fleet management system.
+  /// registered by the fleet management system. With a state keyframe
+  /// interval configured, only the fields that changed since the last full
+  /// robot state are sent, unless a new keyframe is due.
   ///
   /// \param[in] new_robot_state
   ///   Current robot state to be sent to the free fleet server to update the
   ///   fleet management system.
   /// \return
-  ///   True if robot state was successfully sent, false otherwise.
+  ///   True if robot state was successfully sent, or queued to be sent with
+  ///   async_publish enabled, false otherwise, or if it cannot be encoded in
+  ///   the configured message format.
   bool send_robot_state(const messages::RobotState& new_robot_state);
 
+  /// Same as sending a copy of the robot state, except that the state is
+  /// moved into the queue with async_publish enabled. The state is left
+  /// unspecified after it was sent, and untouched if it was not.
+  bool send_robot_state(messages::RobotState&& new_robot_state);
+
   /// Attempts to read and receive a new mode request from the free fleet
   /// server, for commanding the robot client.
   ///
@@ -70,7 +82,8 @@ public:
   ///   Newly received robot path request from the free fleet server, to be
   ///   handled by the robot client.
   /// \return
-  ///   True if a new path request was received, false otherwise.
+  ///   True if a new path request was received, false otherwise, or if its
+  ///   compressed path could not be decompressed.
   bool read_path_request(messages::PathRequest& path_request);
 
   /// Attempts to read and receive a new destination request from the free
@@ -84,6 +97,33 @@ public:
   bool read_destination_request(
       messages::DestinationRequest& destination_request);
 
+  /// Attempts to acknowledge a request that was read, which lets the server
+  /// know that the request arrived, and whether it was accepted. Requests
+  /// that are sent again with the same task ID should be acknowledged again,
+  /// as the previous acknowledgement may have been lost.
+  ///
+  /// \param[in] request_ack
+  ///   Acknowledgement of the request, carrying the fleet name, robot name
+  ///   and task ID of the request.
+  /// \return
+  ///   True if the acknowledgement was successfully sent, false otherwise.
+  bool send_request_ack(const messages::RequestAck& request_ack);
+
+  /// Blocks until a new mode, path or destination request is available to
+  /// be read, or until the timeout passes. This wakes up as soon as a request
+  /// arrives, which avoids having to poll the read functions.
+  ///
+  /// \param[in] timeout
+  ///   Maximum duration to wait for.
+  /// \return
+  ///   True if a new request is available, false if it timed out.
+  bool wait_for_requests(std::chrono::nanoseconds timeout);
+
+  /// Number of robot states that were dropped when sending asynchronously,
+  /// either because the queue was full or because writing failed. Always
+  /// zero when async_publish is not enabled in the client configuration.
+  uint64_t get_async_dropped_count() const;
+
   /// Destructor
   ~Client();
 
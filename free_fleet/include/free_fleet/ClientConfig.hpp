@@ -19,6 +19,10 @@
 #define FREE_FLEET__INCLUDE__FREE_FLEET__CLIENTCONFIG_HPP
 
 #include <string>
+#include <cstddef>
+
+#include <free_fleet/QoSProfile.hpp>
+#include <free_fleet/MessageFormat.hpp>
 
 namespace free_fleet {
 
@@ -29,6 +33,67 @@ struct ClientConfig
   std::string dds_mode_request_topic = "mode_request";
   std::string dds_path_request_topic = "path_request";
   std::string dds_destination_request_topic = "destination_request";
+  std::string dds_state_delta_topic = "robot_state_delta";
+  std::string dds_registration_topic = "robot_registration";
+  std::string dds_registered_state_topic = "registered_robot_state";
+  std::string dds_registered_mode_request_topic = "registered_mode_request";
+  std::string dds_registered_path_request_topic = "registered_path_request";
+  std::string dds_registered_destination_request_topic =
+      "registered_destination_request";
+  std::string dds_request_ack_topic = "request_ack";
+
+  /// QoS profiles used for each of the topics, these need to be compatible
+  /// with the profiles configured on the other side. The registered topics
+  /// use the profiles of their matching topics addressed by name.
+  QoSProfile dds_state_qos = QoSProfile::make_state_profile();
+  QoSProfile dds_mode_request_qos = QoSProfile::make_request_profile();
+  QoSProfile dds_path_request_qos = QoSProfile::make_request_profile();
+  QoSProfile dds_destination_request_qos =
+      QoSProfile::make_request_profile();
+  QoSProfile dds_registration_qos = QoSProfile::make_registration_profile();
+  QoSProfile dds_request_ack_qos = QoSProfile::make_request_profile();
+
+  /// Message types used for robot states and path requests, see
+  /// MessageFormat for their trade-offs, such as the flat format always
+  /// sending full size paths.
+  MessageFormat message_format = MessageFormat::STANDARD;
+
+  /// Encoded size of a path in bytes from which it is compressed, only used
+  /// with the compressed message format. A waypoint takes 24 bytes plus the
+  /// length of its level name.
+  size_t path_compression_threshold = 1024;
+
+  /// Sends robot states asynchronously, send_robot_state then only queues
+  /// the state, which is converted and written by a dedicated writer thread.
+  /// States are dropped when the queue is full.
+  bool async_publish = false;
+  size_t async_publish_queue_size = 64;
+
+  /// Sends a full robot state as a keyframe at least once every this many
+  /// robot states, and only the fields that changed since the keyframe in
+  /// between, on the robot state delta topic. A keyframe is also sent
+  /// whenever the path changes. Deltas are matched to their keyframe using
+  /// the time of the keyframe location, so robot locations need to be
+  /// stamped. Requires robot_state_deltas to be enabled on the server,
+  /// 0 disables deltas and always sends full robot states.
+  size_t state_keyframe_interval = 0;
+
+  /// Identity of the robot that this client is running on. When both are
+  /// set, requests addressed to other fleets or robots are filtered out by
+  /// DDS, and will never be returned by the client.
+  std::string fleet_name = "";
+  std::string robot_name = "";
+
+  /// Addresses robot states and requests by a numeric robot ID assigned by
+  /// the server, instead of by the fleet and robot names. Until the server
+  /// has assigned an ID to this robot, and once every
+  /// robot_id_announce_interval robot states, a full robot state with the
+  /// robot name is sent as an announcement. Requires robot_ids to be enabled
+  /// on the server, the standard message format, and both the fleet name and
+  /// robot name to be set. Robot states are not addressed by ID while state
+  /// deltas are enabled.
+  bool robot_ids = false;
+  size_t robot_id_announce_interval = 10;
 
   void print_config() const;
 };
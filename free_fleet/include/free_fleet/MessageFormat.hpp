@@ -0,0 +1,76 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef FREE_FLEET__INCLUDE__FREE_FLEET__MESSAGEFORMAT_HPP
+#define FREE_FLEET__INCLUDE__FREE_FLEET__MESSAGEFORMAT_HPP
+
+namespace free_fleet {
+
+/// DDS message types used for the path carrying topics, robot states and
+/// path requests. Servers and clients of a deployment need to use the same
+/// format, as the types of different formats do not match over DDS.
+enum class MessageFormat
+{
+  /// Unbounded strings and sequences.
+  STANDARD,
+
+  /// Bounded strings of at most 63 characters and paths of at most 64
+  /// waypoints, so that samples are fixed size and do not need any heap
+  /// allocations. Messages exceeding these bounds fail to be sent.
+  ///
+  /// Paths are fixed size arrays rather than bounded sequences, as the
+  /// generated C types of bounded sequences still point to a separately
+  /// allocated buffer. The price is that all 64 waypoints are always
+  /// serialized, about 1.8 kB per message on the wire even for an empty
+  /// path, and a sample takes about 5.4 kB in memory. This only pays off for
+  /// fleets whose paths are mostly close to 64 waypoints, the standard or
+  /// compact formats are smaller on the wire for short paths.
+  FLAT,
+
+  /// Paths are delta encoded with quantized positions, yaw and times, and
+  /// level names are only sent once per path, which makes paths of 100
+  /// waypoints or more about five times smaller on the wire. Positions are
+  /// exact to 1 mm unless consecutive waypoints are more than 32 m apart,
+  /// and times to 1 ms unless they are more than 32 s apart.
+  COMPACT,
+
+  /// Same as the standard format, except that paths larger than the
+  /// configured path_compression_threshold are sent LZ4 compressed, which
+  /// keeps long multi-level paths within fewer UDP fragments. Paths are
+  /// decompressed before they are returned, and are exact. Only available
+  /// when free fleet is built with LZ4.
+  COMPRESSED
+};
+
+inline const char* message_format_name(MessageFormat _format)
+{
+  switch (_format)
+  {
+    case MessageFormat::FLAT:
+      return "flat";
+    case MessageFormat::COMPACT:
+      return "compact";
+    case MessageFormat::COMPRESSED:
+      return "compressed";
+    default:
+      return "standard";
+  }
+}
+
+} // namespace free_fleet
+
+#endif // FREE_FLEET__INCLUDE__FREE_FLEET__MESSAGEFORMAT_HPP
@@ -0,0 +1,90 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef FREE_FLEET__INCLUDE__FREE_FLEET__QOSPROFILE_HPP
+#define FREE_FLEET__INCLUDE__FREE_FLEET__QOSPROFILE_HPP
+
+#include <cstdint>
+
+namespace free_fleet {
+
+/// DDS quality of service settings used for the reader or writer of a single
+/// topic. Both sides of a topic need compatible profiles for them to match.
+struct QoSProfile
+{
+  enum class Reliability
+  {
+    BEST_EFFORT,
+    RELIABLE
+  };
+
+  enum class History
+  {
+    KEEP_LAST,
+    KEEP_ALL
+  };
+
+  enum class Durability
+  {
+    VOLATILE,
+    TRANSIENT_LOCAL
+  };
+
+  Reliability reliability = Reliability::BEST_EFFORT;
+
+  History history = History::KEEP_LAST;
+
+  /// Only used with KEEP_LAST history.
+  int32_t history_depth = 1;
+
+  Durability durability = Durability::VOLATILE;
+
+  /// Maximum expected period between samples in seconds, non-positive values
+  /// leave the deadline infinite.
+  double deadline = 0.0;
+
+  /// Time in seconds after which a writer is considered not alive by its
+  /// readers, if its participant has not automatically asserted its
+  /// liveliness in the meantime. Non-positive values leave the lease
+  /// duration infinite.
+  double liveliness_lease_duration = 0.0;
+
+  /// Acceptable delay from writing to delivering a sample in seconds.
+  double latency_budget = 0.0;
+
+  int32_t transport_priority = 0;
+
+  void print_profile(const char* topic_label) const;
+
+  /// Best effort and keeping only the newest sample, for periodic telemetry
+  /// where a lost sample is superseded by the next one anyway.
+  static QoSProfile make_state_profile();
+
+  /// Reliable delivery with a latency budget of 10 ms, for commands that
+  /// should not be lost and are expected to arrive promptly. Readers and
+  /// writers only match when the budget of the writer does not exceed the
+  /// budget of the reader.
+  static QoSProfile make_request_profile();
+
+  /// Reliable and durable, keeping the newest sample of every instance, so
+  /// that readers which join later still receive the current value.
+  static QoSProfile make_registration_profile();
+};
+
+} // namespace free_fleet
+
+#endif // FREE_FLEET__INCLUDE__FREE_FLEET__QOSPROFILE_HPP
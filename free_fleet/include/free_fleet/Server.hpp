@@ -18,8 +18,13 @@
 #ifndef FREE_FLEET__INCLUDE__FREE_FLEET__SERVER_HPP
 #define FREE_FLEET__INCLUDE__FREE_FLEET__SERVER_HPP
 
+#include <chrono>
 #include <memory>
+#include <string>
 #include <vector>
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
 
 #include <free_fleet/ServerConfig.hpp>
 
@@ -27,6 +32,7 @@
 #include <free_fleet/messages/ModeRequest.hpp>
 #include <free_fleet/messages/PathRequest.hpp>
 #include <free_fleet/messages/DestinationRequest.hpp>
+#include <free_fleet/messages/RequestAck.hpp>
 
 namespace free_fleet {
 
@@ -36,6 +42,64 @@ public:
 
   using SharedPtr = std::shared_ptr<Server>;
 
+  using RobotStateCallback =
+      std::function<void(const messages::RobotState& robot_state)>;
+
+  /// Presence of a robot, see robot_presence in the server configuration.
+  enum class RobotPresence
+  {
+    /// The robot is alive, and sent a robot state within the deadline.
+    ALIVE,
+
+    /// The robot is alive, but has not sent a robot state within the
+    /// deadline, for example because it slowed down its updates while idle.
+    STALE,
+
+    /// The robot is no longer alive, its liveliness lease expired or its
+    /// client shut down.
+    LOST
+  };
+
+  using RobotPresenceCallback = std::function<
+      void(const std::string& robot_name, RobotPresence presence)>;
+
+  /// Called for the first acknowledgement of every request sent while
+  /// request_acks is configured, with the time from sending the request
+  /// until the acknowledgement arrived.
+  using RequestAckCallback = std::function<
+      void(const messages::RequestAck& request_ack,
+          std::chrono::nanoseconds latency)>;
+
+  /// Percentiles of the times from sending a request until it was
+  /// acknowledged, over the latest acknowledged requests. Requests that were
+  /// sent more than once are left out, as it is unknown which of the sends
+  /// the acknowledgement belongs to.
+  struct RequestAckLatency
+  {
+    size_t count = 0;
+    std::chrono::nanoseconds p50 = std::chrono::nanoseconds::zero();
+    std::chrono::nanoseconds p90 = std::chrono::nanoseconds::zero();
+    std::chrono::nanoseconds p99 = std::chrono::nanoseconds::zero();
+    std::chrono::nanoseconds max = std::chrono::nanoseconds::zero();
+  };
+
+  /// Request that was sent but not acknowledged yet, identified like a
+  /// messages::RequestAck.
+  struct UnacknowledgedRequest
+  {
+    std::string fleet_name;
+    std::string robot_name;
+    std::string task_id;
+    uint32_t request_type;
+
+    /// Time since the request was last sent.
+    std::chrono::nanoseconds age;
+  };
+
+  /// Latest robot state of every robot, by robot name.
+  using FleetSnapshot = std::unordered_map<
+      std::string, std::shared_ptr<const messages::RobotState>>;
+
   /// Factory function that creates an instance of the Free Fleet Server.
   ///
   /// \param[in] config
@@ -45,33 +109,158 @@ public:
   static SharedPtr make(const ServerConfig& config);
 
   /// Attempts to read new incoming robot states sent by free fleet clients
-  /// over DDS.
+  /// over DDS. All pending robot states are taken, in batches of the
+  /// configured robot_state_batch_size, until none are left. Robot states
+  /// are keyed by robot name, so only the newest state of each robot since
+  /// the previous read is returned, regardless of how often this is called.
+  /// With ingest_thread configured, the robot states were already taken and
+  /// converted by the ingest thread, and are only handed over here. Robot
+  /// states whose compressed path cannot be decompressed are dropped.
   ///
   /// \param[out] new_robot_states
   ///   A vector of new incoming robot states sent by clients to update the
-  ///   fleet management system.
+  ///   fleet management system, with at most one state per robot. Passing
+  ///   the same vector on every call reuses the memory of its states.
   /// \return
   ///   True if new robot states were received, false otherwise.
   bool read_robot_states(std::vector<messages::RobotState>& new_robot_states);
 
+  /// Blocks until new robot states are available to be read, or until the
+  /// timeout passes. This wakes up as soon as a robot state arrives, which
+  /// avoids having to poll read_robot_states. Returns false right away once
+  /// the robot states are delivered to callbacks instead, see on_robot_state.
+  ///
+  /// \param[in] timeout
+  ///   Maximum duration to wait for.
+  /// \return
+  ///   True if new robot states are available, false if it timed out.
+  bool wait_for_robot_states(std::chrono::nanoseconds timeout);
+
+  /// Registers a callback to be called for every new incoming robot state,
+  /// as soon as it arrives. Callbacks are driven by a DDS listener and are
+  /// called on a DDS thread, so they should return quickly. Once a callback
+  /// is registered, new robot states are delivered to the callbacks and
+  /// read_robot_states always returns false. With ingest_thread
+  /// configured, callbacks are called on the ingest thread instead, and the
+  /// robot states are still returned by read_robot_states as well. No lock
+  /// of the server is held while the callbacks are called, so they may call
+  /// back into the server, including to register further callbacks.
+  ///
+  /// \param[in] callback
+  ///   Function to be called with each new robot state, the reference is
+  ///   only valid for the duration of the call.
+  void on_robot_state(RobotStateCallback callback);
+
+  /// Snapshot of the latest robot state of every robot that the server has
+  /// received a robot state from. The server keeps every robot state that is
+  /// returned by read_robot_states or passed to the robot state callbacks,
+  /// so snapshots are only as recent as the last read or callback. Snapshots
+  /// are immutable and are replaced rather than modified, so they can be
+  /// taken and held on to from any number of threads without taking locks.
+  ///
+  /// \return
+  ///   Shared pointer to the current snapshot of the fleet.
+  std::shared_ptr<const FleetSnapshot> fleet_snapshot() const;
+
+  /// Latest robot state of a single robot, see fleet_snapshot.
+  ///
+  /// \param[in] robot_name
+  ///   Name of the robot.
+  /// \return
+  ///   Shared pointer to the latest robot state of the robot, or nullptr if
+  ///   no robot state of this robot has been received.
+  std::shared_ptr<const messages::RobotState> get_robot_state(
+      const std::string& robot_name) const;
+
+  /// Current presence of a robot. Requires robot_presence to be configured,
+  /// otherwise no robots are known.
+  ///
+  /// \param[in] robot_name
+  ///   Name of the robot.
+  /// \param[out] presence
+  ///   Current presence of the robot.
+  /// \return
+  ///   True if the robot is known, false otherwise.
+  bool get_robot_presence(
+      const std::string& robot_name, RobotPresence& presence) const;
+
+  /// Registers a callback to be called whenever the presence of a robot
+  /// changes, including when a robot is first seen. Callbacks are called on
+  /// the thread that noticed the change, which is either a DDS thread or the
+  /// thread receiving the robot states, or on a thread that is still calling
+  /// the callbacks for earlier changes, so they should return quickly. The
+  /// callbacks see the changes in the order they happened, and no lock of
+  /// the server is held while they are called.
+  ///
+  /// \param[in] callback
+  ///   Function to be called with the robot name and its new presence.
+  void on_robot_presence(RobotPresenceCallback callback);
+
+  /// Finds the robots on a level that are closest to a position, using the
+  /// latest robot states that are kept for fleet_snapshot. Requires a
+  /// spatial_index_cell_size to be configured, otherwise no robots are found.
+  /// Robots that expired or were lost are not found, see
+  /// ServerConfig::robot_state_expiry.
+  ///
+  /// \param[in] level_name
+  ///   Level to search on.
+  /// \param[in] x
+  /// \param[in] y
+  ///   Position to search around.
+  /// \param[in] k
+  ///   Maximum number of robots to find.
+  /// \return
+  ///   Names of up to k robots, ordered by increasing distance.
+  std::vector<std::string> find_nearest_robots(
+      const std::string& level_name, double x, double y, size_t k) const;
+
+  /// Finds the robots on a level within a radius of a position, see
+  /// find_nearest_robots.
+  ///
+  /// \return
+  ///   Names of the robots, in no particular order.
+  std::vector<std::string> find_robots_in_radius(
+      const std::string& level_name, double x, double y,
+      double radius) const;
+
+  /// Finds the robots on a level within a rectangle, bounds included, see
+  /// find_nearest_robots.
+  ///
+  /// \return
+  ///   Names of the robots, in no particular order.
+  std::vector<std::string> find_robots_in_rectangle(
+      const std::string& level_name,
+      double min_x, double min_y, double max_x, double max_y) const;
+
   /// Attempts to send a new mode request to all the clients. Clients are in
-  /// charge to identify if requests are targetted towards them.
-  /// 
+  /// charge to identify if requests are targetted towards them. With
+  /// async_publish enabled, the request is only queued to be sent.
+  ///
   /// \param[in] mode_request
   ///   New mode request to be sent out to the clients.
   /// \return
   ///   True if the mode request was successfully sent, false otherwise.
   bool send_mode_request(const messages::ModeRequest& mode_request);
 
+  /// Same as sending a copy of the mode request, except that the request is
+  /// moved into the queue with async_publish enabled. The request is left
+  /// unspecified after it was sent, and untouched if it was not.
+  bool send_mode_request(messages::ModeRequest&& mode_request);
+
   /// Attempts to send a new path request to all the clients. Clients are in
   /// charge to identify if requests are targetted towards them.
   ///
   /// \param[in] path_request
   ///   New path request to be sent out to the clients.
   /// \return
-  ///   True if the path request was successfully sent, false otherwise.
+  ///   True if the path request was successfully sent, false otherwise, or
+  ///   if it cannot be encoded in the configured message format.
   bool send_path_request(const messages::PathRequest& path_request);
 
+  /// Same as sending a copy of the path request, see the mode request that
+  /// is moved.
+  bool send_path_request(messages::PathRequest&& path_request);
+
   /// Attempts to send a new destination request to all the clients. Clients 
   /// are in charge to identify if requests are targetted towards them.
   ///
@@ -82,6 +271,75 @@ public:
   bool send_destination_request(
       const messages::DestinationRequest& destination_request);
 
+  /// Same as sending a copy of the destination request, see the mode request
+  /// that is moved.
+  bool send_destination_request(
+      messages::DestinationRequest&& destination_request);
+
+  /// Attempts to send a batch of mode requests to all the clients. With
+  /// dds_write_batching enabled in the server configuration, the requests
+  /// are flushed out at once, see ServerConfig::dds_write_batching, instead
+  /// of being sent out individually.
+  ///
+  /// \param[in] mode_requests
+  ///   New mode requests to be sent out to the clients.
+  /// \return
+  ///   True if all the mode requests were successfully sent, false otherwise.
+  bool send_mode_requests(
+      const std::vector<messages::ModeRequest>& mode_requests);
+
+  /// Attempts to send a batch of path requests to all the clients, see
+  /// send_mode_requests regarding batching.
+  ///
+  /// \param[in] path_requests
+  ///   New path requests to be sent out to the clients.
+  /// \return
+  ///   True if all the path requests were successfully sent, false otherwise.
+  bool send_path_requests(
+      const std::vector<messages::PathRequest>& path_requests);
+
+  /// Attempts to send a batch of destination requests to all the clients,
+  /// see send_mode_requests regarding batching.
+  ///
+  /// \param[in] destination_requests
+  ///   New destination requests to be sent out to the clients.
+  /// \return
+  ///   True if all the destination requests were successfully sent, false
+  ///   otherwise.
+  bool send_destination_requests(
+      const std::vector<messages::DestinationRequest>& destination_requests);
+
+  /// Registers a callback to be called whenever a client acknowledges one
+  /// of the requests sent by this server. Callbacks are driven by a DDS
+  /// listener, so they should return quickly. No lock of the server is held
+  /// while they are called, so they may look up get_request_ack_latency or
+  /// get_unacknowledged_requests. Requires request_acks to be configured.
+  ///
+  /// \param[in] callback
+  ///   Function to be called with each acknowledgement and its latency.
+  void on_request_ack(RequestAckCallback callback);
+
+  /// Latency percentiles of the latest acknowledged requests, see
+  /// RequestAckLatency.
+  RequestAckLatency get_request_ack_latency() const;
+
+  /// Requests that were sent but not acknowledged yet, for example to send
+  /// only the lost requests again. Requests that are sent again keep being
+  /// tracked until they are acknowledged once.
+  ///
+  /// \param[in] min_age
+  ///   Only requests that were last sent at least this long ago are
+  ///   returned, this should be above the usual acknowledgement latency.
+  /// \return
+  ///   Unacknowledged requests, the ones sent longest ago first.
+  std::vector<UnacknowledgedRequest> get_unacknowledged_requests(
+      std::chrono::nanoseconds min_age) const;
+
+  /// Number of requests that were dropped when sending asynchronously,
+  /// either because the queue was full or because writing failed. Always
+  /// zero when async_publish is not enabled in the server configuration.
+  uint64_t get_async_dropped_count() const;
+
   /// Destructor
   ~Server();
 
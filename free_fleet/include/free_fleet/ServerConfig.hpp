@@ -20,6 +20,10 @@
 
 #include <string>
 
+#include <free_fleet/QoSProfile.hpp>
+#include <free_fleet/MessageFormat.hpp>
+#include <cstddef>
+
 namespace free_fleet {
 
 struct ServerConfig
@@ -29,6 +33,111 @@ struct ServerConfig
   std::string dds_mode_request_topic = "mode_request";
   std::string dds_path_request_topic = "path_request";
   std::string dds_destination_request_topic = "destination_request";
+  std::string dds_robot_state_delta_topic = "robot_state_delta";
+  std::string dds_robot_registration_topic = "robot_registration";
+  std::string dds_registered_robot_state_topic = "registered_robot_state";
+  std::string dds_registered_mode_request_topic = "registered_mode_request";
+  std::string dds_registered_path_request_topic = "registered_path_request";
+  std::string dds_registered_destination_request_topic =
+      "registered_destination_request";
+  std::string dds_request_ack_topic = "request_ack";
+
+  /// QoS profiles used for each of the topics, these need to be compatible
+  /// with the profiles configured on the other side. The registered topics
+  /// use the profiles of their matching topics addressed by name.
+  QoSProfile dds_robot_state_qos = QoSProfile::make_state_profile();
+  QoSProfile dds_mode_request_qos = QoSProfile::make_request_profile();
+  QoSProfile dds_path_request_qos = QoSProfile::make_request_profile();
+  QoSProfile dds_destination_request_qos =
+      QoSProfile::make_request_profile();
+  QoSProfile dds_registration_qos = QoSProfile::make_registration_profile();
+  QoSProfile dds_request_ack_qos = QoSProfile::make_request_profile();
+
+  /// Message types used for robot states and path requests, see
+  /// MessageFormat for their trade-offs, such as the flat format always
+  /// sending full size paths.
+  MessageFormat message_format = MessageFormat::STANDARD;
+
+  /// Encoded size of a path in bytes from which it is compressed, only used
+  /// with the compressed message format. A waypoint takes 24 bytes plus the
+  /// length of its level name.
+  size_t path_compression_threshold = 1024;
+
+  /// Sends requests asynchronously, the send functions then only queue
+  /// the messages, which are converted and written by a dedicated writer
+  /// thread. Messages are dropped when the queue is full.
+  bool async_publish = false;
+  size_t async_publish_queue_size = 64;
+
+  /// Maximum number of robot states taken from DDS in a single batch, reading
+  /// robot states keeps taking batches until no new states are left.
+  size_t robot_state_batch_size = 10;
+
+  /// Receives robot state deltas from clients that have a
+  /// state_keyframe_interval configured, and rebuilds full robot states from
+  /// the deltas and the last full robot state received from each robot.
+  bool robot_state_deltas = false;
+
+  /// Flushes the requests of a batched send out at once after the last
+  /// request, instead of after every request. DDS only packs unflushed
+  /// requests together with write batching enabled in the CycloneDDS
+  /// configuration, using Internal/WriteBatch. The server leaves that
+  /// process-wide setting alone, as it would also hold back the writes of
+  /// any other DDS writers in this process that do not flush. The writers of
+  /// free fleet always flush their own writes.
+  bool dds_write_batching = false;
+
+  /// Assigns a numeric ID to every robot on its first full robot state, and
+  /// publishes it to the client of that robot. Robot states and requests are
+  /// then addressed by ID instead of by the fleet and robot names, which
+  /// only go out in the periodic full robot states of the clients. Requests
+  /// to robots that have no ID yet are sent with their names as usual.
+  /// Requires the standard message format. IDs are only unique for this
+  /// server, requests sent by ID are therefore not matched against the fleet
+  /// name by the clients.
+  bool robot_ids = false;
+
+  /// Size in meters of the grid cells of the spatial index of the robot
+  /// positions, which answers the robot queries of the server by position.
+  /// Should be around the radius of the typical queries, 0 disables the
+  /// spatial index.
+  double spatial_index_cell_size = 0.0;
+
+  /// Time in seconds after which a robot that sent no robot states is
+  /// removed from the spatial index, so that robots which went offline are
+  /// no longer found by its queries, and its keyframe for robot state deltas
+  /// is released. The robot is added back with its next robot state, and
+  /// its deltas apply again from its next keyframe. With robot_presence,
+  /// robots are also removed as soon as they are lost. Non-positive values
+  /// keep the robots forever.
+  double robot_state_expiry = 300.0;
+
+  /// Takes and converts the incoming robot states on a dedicated ingest
+  /// thread as soon as they arrive, instead of when read_robot_states is
+  /// called, so that a slow application does not overflow the DDS reader
+  /// history. The latest state of every robot is held until the next read,
+  /// and robot state callbacks are called from the ingest thread.
+  bool ingest_thread = false;
+
+  /// Tracks the presence of every robot, see Server::RobotPresence. A robot
+  /// becomes stale when it misses the deadline of dds_robot_state_qos, and
+  /// lost when its liveliness lease duration expires, which its client keeps
+  /// renewing even while it sends robot states less often. The clients need
+  /// a deadline and lease duration no longer than those of the server for
+  /// their robot states to be received at all. Presence follows the robot
+  /// states as they are read, it is therefore most accurate with the
+  /// ingest_thread or robot state callbacks.
+  bool robot_presence = false;
+
+  /// Receives the acknowledgements of the requests from the clients, and
+  /// tracks the sent requests until they are acknowledged, see
+  /// Server::get_unacknowledged_requests. At most request_ack_max_pending
+  /// requests are tracked, beyond that the ones sent longest ago are no
+  /// longer tracked. Latency percentiles are taken over the latest
+  /// request_ack_latency_window acknowledgements.
+  bool request_acks = false;
+  size_t request_ack_max_pending = 1024;
+  size_t request_ack_latency_window = 1024;
 
   void print_config() const;
 };
@@ -0,0 +1,128 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef FREE_FLEET__INCLUDE__FREE_FLEET__MESSAGES__PATHSOA_HPP
+#define FREE_FLEET__INCLUDE__FREE_FLEET__MESSAGES__PATHSOA_HPP
+
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+#include "Location.hpp"
+
+namespace free_fleet {
+namespace messages {
+
+/// Path stored as a structure of arrays, with the times, positions and
+/// orientations of the waypoints in contiguous arrays, and the level of each
+/// waypoint as an index into a table of level names. Computations over the
+/// whole path, such as its length, only touch the arrays they need and do
+/// not stride over the level name strings of the waypoints.
+class PathSoA
+{
+public:
+
+  PathSoA();
+
+  /// Creates the structure of arrays of the path.
+  ///
+  /// \param[in] path
+  ///   Path as stored in the path requests and robot states.
+  explicit PathSoA(const std::vector<Location>& path);
+
+  /// Replaces the waypoints with the waypoints of the path, reusing the
+  /// capacity of the arrays.
+  void assign(const std::vector<Location>& path);
+
+  /// Appends a waypoint at the end of the path.
+  void push_back(const Location& location);
+
+  /// Converts the path back into the locations of its waypoints, reusing
+  /// the capacity of the output.
+  void to_locations(std::vector<Location>& path) const;
+
+  Location location(size_t index) const;
+
+  void reserve(size_t size);
+
+  void clear();
+
+  size_t size() const;
+
+  bool empty() const;
+
+  const std::vector<int32_t>& sec() const;
+
+  const std::vector<uint32_t>& nanosec() const;
+
+  const std::vector<float>& x() const;
+
+  const std::vector<float>& y() const;
+
+  const std::vector<float>& yaw() const;
+
+  /// Index of the level of each waypoint into level_names.
+  const std::vector<uint32_t>& level_index() const;
+
+  /// Names of the levels of the path, each appearing once.
+  const std::vector<std::string>& level_names() const;
+
+  /// Planar distance from the position to a waypoint.
+  double distance_to(size_t index, double x, double y) const;
+
+  /// Planar length of the path from a waypoint to the end of the path,
+  /// which is the remaining distance to travel for a robot at that waypoint.
+  /// Segments that change levels are counted as well.
+  ///
+  /// \param[in] begin
+  ///   Index of the waypoint to start from.
+  /// \return
+  ///   Length of the path in meters, 0 if there are fewer than 2 waypoints
+  ///   after begin.
+  double length(size_t begin = 0) const;
+
+  /// Length of the longest segment between two consecutive waypoints.
+  double max_segment_length() const;
+
+  /// Time in seconds from a waypoint to the last waypoint of the path, which
+  /// is the estimated time of arrival for a robot at that waypoint.
+  double duration(size_t begin = 0) const;
+
+  /// Index of the waypoint closest to the position, regardless of its level.
+  ///
+  /// \return
+  ///   Index of the closest waypoint, or size() if the path is empty.
+  size_t nearest_waypoint(double x, double y) const;
+
+private:
+
+  uint32_t find_level(const std::string& level_name);
+
+  std::vector<int32_t> secs;
+  std::vector<uint32_t> nanosecs;
+  std::vector<float> xs;
+  std::vector<float> ys;
+  std::vector<float> yaws;
+  std::vector<uint32_t> level_indices;
+  std::vector<std::string> levels;
+};
+
+} // namespace messages
+} // namespace free_fleet
+
+#endif // FREE_FLEET__INCLUDE__FREE_FLEET__MESSAGES__PATHSOA_HPP
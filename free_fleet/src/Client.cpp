@@ -15,6 +15,13 @@
  *
  */
 
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <functional>
+
 #include <dds/dds.h>
 
 #include <free_fleet/Client.hpp>
@@ -22,13 +29,74 @@
 #include "ClientImpl.hpp"
 
 #include "messages/FleetMessages.h"
+#include "messages/message_utils.hpp"
+#include "messages/PathCompressor.hpp"
 #include "dds_utils/DDSPublishHandler.hpp"
 #include "dds_utils/DDSSubscribeHandler.hpp"
+#include "dds_utils/ConvertingPublishHandler.hpp"
+#include "dds_utils/ConvertingSubscribeHandler.hpp"
+#include "dds_utils/common.hpp"
 
 namespace free_fleet {
 
+namespace {
+
+/// Creates a content filter that only lets through requests that are
+/// addressed to the fleet and robot configured for this client.
+/// Compares the name field of a request, which is either an unbounded string
+/// that might be null, or the array of a bounded string.
+bool name_matches(const char* _request_name, const std::string& _name)
+{
+  return _request_name && _name == _request_name;
+}
+
+template <typename Request>
+std::function<bool(const Request&)> make_request_filter(
+    const ClientConfig& _config)
+{
+  const std::string fleet_name = _config.fleet_name;
+  const std::string robot_name = _config.robot_name;
+  return [fleet_name, robot_name](const Request& _request)
+  {
+    return name_matches(_request.fleet_name, fleet_name) &&
+        name_matches(_request.robot_name, robot_name);
+  };
+}
+
+/// Creates a content filter that only lets through requests that are
+/// addressed to the robot ID that the server assigned to this client, which
+/// rejects every request until the robot has been assigned an ID.
+template <typename Request>
+std::function<bool(const Request&)> make_registered_request_filter(
+    const std::shared_ptr<std::atomic<uint32_t>>& _robot_id)
+{
+  std::shared_ptr<const std::atomic<uint32_t>> robot_id = _robot_id;
+  return [robot_id](const Request& _request)
+  {
+    return _request.robot_id != 0 && _request.robot_id == robot_id->load();
+  };
+}
+
+} // anonymous namespace
+
 Client::SharedPtr Client::make(const ClientConfig& _config)
 {
+  if (_config.message_format == MessageFormat::COMPRESSED &&
+      !messages::path_compression_available())
+  {
+    DDS_FATAL("compressed message format requires LZ4\n");
+    return nullptr;
+  }
+
+  if (_config.robot_ids &&
+      (_config.message_format != MessageFormat::STANDARD ||
+          _config.fleet_name.empty() || _config.robot_name.empty()))
+  {
+    DDS_FATAL("robot ids require the standard message format, a fleet name "
+        "and a robot name\n");
+    return nullptr;
+  }
+
   SharedPtr client = SharedPtr(new Client(_config));
 
   dds_entity_t participant = dds_create_participant(
@@ -39,41 +107,341 @@ Client::SharedPtr Client::make(const ClientConfig& _config)
     return nullptr;
   }
 
-  dds::DDSPublishHandler<FreeFleetData_RobotState>::SharedPtr state_pub(
-      new dds::DDSPublishHandler<FreeFleetData_RobotState>(
-          participant, &FreeFleetData_RobotState_desc,
-          _config.dds_state_topic));
+  // Robot states and path requests are only created in the configured
+  // message format, and the client only sees them through handlers that
+  // convert from and into that format. The robot state writer carries the
+  // robot name as its user data, which lets the server tell which robot a
+  // change of its liveliness belongs to.
+  dds::ConvertingPublishHandler<messages::RobotState>::SharedPtr state_pub;
+  dds::ConvertingSubscribeHandler<messages::PathRequest>::SharedPtr
+      path_request_sub;
+  dds::DDSPublishHandler<FreeFleetData_RobotState>::SharedPtr
+      standard_state_pub;
+  bool path_topics_ready = false;
+  const bool filter_requests =
+      !_config.fleet_name.empty() && !_config.robot_name.empty();
+
+  switch (_config.message_format)
+  {
+    case MessageFormat::FLAT:
+    {
+      dds::DDSPublishHandler<FreeFleetData_FlatRobotState>::SharedPtr
+          flat_state_pub(
+              new dds::DDSPublishHandler<FreeFleetData_FlatRobotState>(
+                  participant, &FreeFleetData_FlatRobotState_desc,
+                  _config.dds_state_topic,
+                  _config.dds_state_qos,
+                  _config.robot_name));
+      dds::DDSSubscribeHandler<FreeFleetData_FlatPathRequest>::SharedPtr
+          flat_path_request_sub(
+              new dds::DDSSubscribeHandler<FreeFleetData_FlatPathRequest>(
+                  participant, &FreeFleetData_FlatPathRequest_desc,
+                  _config.dds_path_request_topic,
+                  1,
+                  _config.dds_path_request_qos));
+      path_topics_ready =
+          flat_state_pub->is_ready() && flat_path_request_sub->is_ready();
+      if (path_topics_ready && filter_requests)
+        flat_path_request_sub->set_filter(
+            make_request_filter<FreeFleetData_FlatPathRequest>(_config));
+      state_pub = dds::ConvertingPublishHandler<messages::RobotState>::
+          make<FreeFleetData_FlatRobotState>(
+              std::move(flat_state_pub),
+              [](const messages::RobotState& _robot_state)
+              {
+                return messages::fits_flat_message(_robot_state);
+              });
+      path_request_sub =
+          dds::ConvertingSubscribeHandler<messages::PathRequest>::
+              make<FreeFleetData_FlatPathRequest>(
+                  std::move(flat_path_request_sub));
+      break;
+    }
+
+    case MessageFormat::COMPACT:
+    {
+      dds::DDSPublishHandler<FreeFleetData_CompactRobotState>::SharedPtr
+          compact_state_pub(
+              new dds::DDSPublishHandler<FreeFleetData_CompactRobotState>(
+                  participant, &FreeFleetData_CompactRobotState_desc,
+                  _config.dds_state_topic,
+                  _config.dds_state_qos,
+                  _config.robot_name));
+      dds::DDSSubscribeHandler<FreeFleetData_CompactPathRequest>::SharedPtr
+          compact_path_request_sub(
+              new dds::DDSSubscribeHandler<FreeFleetData_CompactPathRequest>(
+                  participant, &FreeFleetData_CompactPathRequest_desc,
+                  _config.dds_path_request_topic,
+                  1,
+                  _config.dds_path_request_qos));
+      path_topics_ready = compact_state_pub->is_ready() &&
+          compact_path_request_sub->is_ready();
+      if (path_topics_ready && filter_requests)
+        compact_path_request_sub->set_filter(
+            make_request_filter<FreeFleetData_CompactPathRequest>(_config));
+      state_pub = dds::ConvertingPublishHandler<messages::RobotState>::
+          make<FreeFleetData_CompactRobotState>(
+              std::move(compact_state_pub),
+              [](const messages::RobotState& _robot_state)
+              {
+                return messages::fits_compact_message(_robot_state);
+              });
+      path_request_sub =
+          dds::ConvertingSubscribeHandler<messages::PathRequest>::
+              make<FreeFleetData_CompactPathRequest>(
+                  std::move(compact_path_request_sub));
+      break;
+    }
+
+    case MessageFormat::COMPRESSED:
+    {
+      dds::DDSPublishHandler<FreeFleetData_CompressedRobotState>::SharedPtr
+          compressed_state_pub(
+              new dds::DDSPublishHandler<FreeFleetData_CompressedRobotState>(
+                  participant, &FreeFleetData_CompressedRobotState_desc,
+                  _config.dds_state_topic,
+                  _config.dds_state_qos,
+                  _config.robot_name));
+      dds::DDSSubscribeHandler<
+          FreeFleetData_CompressedPathRequest>::SharedPtr
+              compressed_path_request_sub(
+                  new dds::DDSSubscribeHandler<
+                      FreeFleetData_CompressedPathRequest>(
+                          participant,
+                          &FreeFleetData_CompressedPathRequest_desc,
+                          _config.dds_path_request_topic,
+                          1,
+                          _config.dds_path_request_qos));
+      path_topics_ready = compressed_state_pub->is_ready() &&
+          compressed_path_request_sub->is_ready();
+      if (path_topics_ready && filter_requests)
+        compressed_path_request_sub->set_filter(
+            make_request_filter<FreeFleetData_CompressedPathRequest>(
+                _config));
+      state_pub = dds::ConvertingPublishHandler<messages::RobotState>::
+          make_with_converter<FreeFleetData_CompressedRobotState>(
+              std::move(compressed_state_pub),
+              std::make_shared<messages::PathCompressor>(
+                  _config.path_compression_threshold));
+      path_request_sub =
+          dds::ConvertingSubscribeHandler<messages::PathRequest>::
+              make<FreeFleetData_CompressedPathRequest>(
+                  std::move(compressed_path_request_sub));
+      break;
+    }
+
+    default:
+    {
+      standard_state_pub.reset(
+          new dds::DDSPublishHandler<FreeFleetData_RobotState>(
+              participant, &FreeFleetData_RobotState_desc,
+              _config.dds_state_topic,
+              _config.dds_state_qos,
+              _config.robot_name));
+      dds::DDSSubscribeHandler<FreeFleetData_PathRequest>::SharedPtr
+          standard_path_request_sub(
+              new dds::DDSSubscribeHandler<FreeFleetData_PathRequest>(
+                  participant, &FreeFleetData_PathRequest_desc,
+                  _config.dds_path_request_topic,
+                  1,
+                  _config.dds_path_request_qos));
+      path_topics_ready = standard_state_pub->is_ready() &&
+          standard_path_request_sub->is_ready();
+      if (path_topics_ready && filter_requests)
+        standard_path_request_sub->set_filter(
+            make_request_filter<FreeFleetData_PathRequest>(_config));
+      path_request_sub =
+          dds::ConvertingSubscribeHandler<messages::PathRequest>::
+              make<FreeFleetData_PathRequest>(
+                  std::move(standard_path_request_sub));
+      break;
+    }
+  }
 
   dds::DDSSubscribeHandler<FreeFleetData_ModeRequest>::SharedPtr 
       mode_request_sub(
           new dds::DDSSubscribeHandler<FreeFleetData_ModeRequest>(
               participant, &FreeFleetData_ModeRequest_desc,
-              _config.dds_mode_request_topic));
-
-  dds::DDSSubscribeHandler<FreeFleetData_PathRequest>::SharedPtr 
-      path_request_sub(
-          new dds::DDSSubscribeHandler<FreeFleetData_PathRequest>(
-              participant, &FreeFleetData_PathRequest_desc,
-              _config.dds_path_request_topic));
+              _config.dds_mode_request_topic,
+              1,
+              _config.dds_mode_request_qos));
 
   dds::DDSSubscribeHandler<FreeFleetData_DestinationRequest>::SharedPtr
       destination_request_sub(
           new dds::DDSSubscribeHandler<FreeFleetData_DestinationRequest>(
               participant, &FreeFleetData_DestinationRequest_desc,
-              _config.dds_destination_request_topic));
+              _config.dds_destination_request_topic,
+              1,
+              _config.dds_destination_request_qos));
+
+  dds::ConvertingPublishHandler<messages::RobotStateDelta>::SharedPtr
+      state_delta_pub;
+  if (_config.state_keyframe_interval > 0)
+  {
+    dds::DDSPublishHandler<FreeFleetData_RobotStateDelta>::SharedPtr
+        raw_state_delta_pub(
+            new dds::DDSPublishHandler<FreeFleetData_RobotStateDelta>(
+                participant, &FreeFleetData_RobotStateDelta_desc,
+                _config.dds_state_delta_topic,
+                _config.dds_state_qos));
+    if (!raw_state_delta_pub->is_ready())
+      return nullptr;
+    state_delta_pub =
+        dds::ConvertingPublishHandler<messages::RobotStateDelta>::
+            make<FreeFleetData_RobotStateDelta>(
+                std::move(raw_state_delta_pub));
+  }
 
-  if (!state_pub->is_ready() ||
+  if (!path_topics_ready ||
       !mode_request_sub->is_ready() ||
-      !path_request_sub->is_ready() ||
       !destination_request_sub->is_ready())
     return nullptr;
 
+  if (filter_requests)
+  {
+    mode_request_sub->set_filter(
+        make_request_filter<FreeFleetData_ModeRequest>(_config));
+    destination_request_sub->set_filter(
+        make_request_filter<FreeFleetData_DestinationRequest>(_config));
+  }
+
+  std::vector<dds_entity_t> request_readers = {
+      mode_request_sub->get_reader(),
+      path_request_sub->get_reader(),
+      destination_request_sub->get_reader()};
+
+  // The registration and the topics addressed by robot ID are only created
+  // with robot_ids enabled.
+  dds::DDSSubscribeHandler<FreeFleetData_RobotRegistration>::SharedPtr
+      registration_sub;
+  dds::DDSPublishHandler<FreeFleetData_RegisteredRobotState>::SharedPtr
+      registered_state_pub;
+  dds::DDSSubscribeHandler<FreeFleetData_RegisteredModeRequest>::SharedPtr
+      registered_mode_request_sub;
+  dds::DDSSubscribeHandler<FreeFleetData_RegisteredPathRequest>::SharedPtr
+      registered_path_request_sub;
+  dds::DDSSubscribeHandler<
+      FreeFleetData_RegisteredDestinationRequest>::SharedPtr
+          registered_destination_request_sub;
+  std::shared_ptr<std::atomic<uint32_t>> robot_id;
+  if (_config.robot_ids)
+  {
+    robot_id = std::make_shared<std::atomic<uint32_t>>(0);
+    registration_sub.reset(
+        new dds::DDSSubscribeHandler<FreeFleetData_RobotRegistration>(
+            participant, &FreeFleetData_RobotRegistration_desc,
+            _config.dds_registration_topic,
+            1,
+            _config.dds_registration_qos));
+    registered_mode_request_sub.reset(
+        new dds::DDSSubscribeHandler<FreeFleetData_RegisteredModeRequest>(
+            participant, &FreeFleetData_RegisteredModeRequest_desc,
+            _config.dds_registered_mode_request_topic,
+            1,
+            _config.dds_mode_request_qos));
+    registered_path_request_sub.reset(
+        new dds::DDSSubscribeHandler<FreeFleetData_RegisteredPathRequest>(
+            participant, &FreeFleetData_RegisteredPathRequest_desc,
+            _config.dds_registered_path_request_topic,
+            1,
+            _config.dds_path_request_qos));
+    registered_destination_request_sub.reset(
+        new dds::DDSSubscribeHandler<
+            FreeFleetData_RegisteredDestinationRequest>(
+                participant, &FreeFleetData_RegisteredDestinationRequest_desc,
+                _config.dds_registered_destination_request_topic,
+                1,
+                _config.dds_destination_request_qos));
+    if (!registration_sub->is_ready() ||
+        !registered_mode_request_sub->is_ready() ||
+        !registered_path_request_sub->is_ready() ||
+        !registered_destination_request_sub->is_ready())
+      return nullptr;
+
+    // Robot state deltas are always addressed by name, the server only
+    // addresses requests by ID once it receives a state addressed by ID.
+    if (!state_delta_pub)
+    {
+      registered_state_pub.reset(
+          new dds::DDSPublishHandler<FreeFleetData_RegisteredRobotState>(
+              participant, &FreeFleetData_RegisteredRobotState_desc,
+              _config.dds_registered_state_topic,
+              _config.dds_state_qos));
+      if (!registered_state_pub->is_ready())
+        return nullptr;
+    }
+
+    const std::string robot_name = _config.robot_name;
+    registration_sub->set_filter(
+        [robot_name](const FreeFleetData_RobotRegistration& _registration)
+        {
+          return name_matches(_registration.robot_name, robot_name);
+        });
+    registered_mode_request_sub->set_filter(
+        make_registered_request_filter<FreeFleetData_RegisteredModeRequest>(
+            robot_id));
+    registered_path_request_sub->set_filter(
+        make_registered_request_filter<FreeFleetData_RegisteredPathRequest>(
+            robot_id));
+    registered_destination_request_sub->set_filter(
+        make_registered_request_filter<
+            FreeFleetData_RegisteredDestinationRequest>(robot_id));
+
+    request_readers.push_back(registered_mode_request_sub->get_reader());
+    request_readers.push_back(registered_path_request_sub->get_reader());
+    request_readers.push_back(
+        registered_destination_request_sub->get_reader());
+  }
+
+  dds::DDSPublishHandler<FreeFleetData_RequestAck>::SharedPtr
+      request_ack_pub(
+          new dds::DDSPublishHandler<FreeFleetData_RequestAck>(
+              participant, &FreeFleetData_RequestAck_desc,
+              _config.dds_request_ack_topic,
+              _config.dds_request_ack_qos));
+  if (!request_ack_pub->is_ready())
+    return nullptr;
+
+  // Robot states are addressed by the robot ID that the server assigned
+  // once the client received it, which the client looks up while writing.
+  if (registered_state_pub)
+  {
+    ClientImpl* impl = client->impl.get();
+    state_pub = std::make_shared<
+        dds::ConvertingPublishHandler<messages::RobotState>>(
+            [impl, standard_state_pub](
+                const messages::RobotState& _robot_state)
+            {
+              return impl->write_registered_robot_state(
+                  *standard_state_pub, _robot_state);
+            });
+  }
+  else if (standard_state_pub)
+  {
+    state_pub = dds::ConvertingPublishHandler<messages::RobotState>::
+        make<FreeFleetData_RobotState>(std::move(standard_state_pub));
+  }
+
+  dds_entity_t request_waitset =
+      common::dds_create_read_waitset(participant, request_readers);
+  if (request_waitset < 0)
+    return nullptr;
+
   client->impl->start(ClientImpl::Fields{
       std::move(participant),
       std::move(state_pub),
       std::move(mode_request_sub),
       std::move(path_request_sub),
-      std::move(destination_request_sub)});
+      std::move(destination_request_sub),
+      std::move(request_waitset),
+      std::move(state_delta_pub),
+      std::move(registration_sub),
+      std::move(registered_state_pub),
+      std::move(registered_mode_request_sub),
+      std::move(registered_path_request_sub),
+      std::move(registered_destination_request_sub),
+      std::move(robot_id),
+      std::move(request_ack_pub)});
   return client;
 }
 
@@ -90,6 +458,11 @@ bool Client::send_robot_state(const messages::RobotState& _new_robot_state)
   return impl->send_robot_state(_new_robot_state);
 }
 
+bool Client::send_robot_state(messages::RobotState&& _new_robot_state)
+{
+  return impl->send_robot_state(std::move(_new_robot_state));
+}
+
 bool Client::read_mode_request(messages::ModeRequest& _mode_request)
 {
   return impl->read_mode_request(_mode_request);
@@ -106,4 +479,19 @@ bool Client::read_destination_request(
   return impl->read_destination_request(_destination_request);
 }
 
+bool Client::send_request_ack(const messages::RequestAck& _request_ack)
+{
+  return impl->send_request_ack(_request_ack);
+}
+
+bool Client::wait_for_requests(std::chrono::nanoseconds _timeout)
+{
+  return impl->wait_for_requests(_timeout);
+}
+
+uint64_t Client::get_async_dropped_count() const
+{
+  return impl->get_async_dropped_count();
+}
+
 } // namespace free_fleet
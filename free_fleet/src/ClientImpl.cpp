@@ -17,15 +17,49 @@
 
 #include "ClientImpl.hpp"
 #include "messages/message_utils.hpp"
+#include "dds_utils/common.hpp"
 
 namespace free_fleet {
 
+namespace {
+
+/// Takes a request addressed by robot ID, and fills in the fleet and robot
+/// names of the client that it was addressed to.
+template <typename Sample, typename Request>
+bool take_registered_request(
+    dds::DDSSubscribeHandler<Sample>* _sub,
+    const ClientConfig& _config,
+    Request& _request)
+{
+  if (!_sub)
+    return false;
+
+  auto requests = _sub->take_loaned();
+  if (requests.empty())
+    return false;
+
+  convert(*(requests[0]), _request);
+  _request.fleet_name = _config.fleet_name;
+  _request.robot_name = _config.robot_name;
+  return true;
+}
+
+} // anonymous namespace
+
+//==============================================================================
+
 Client::ClientImpl::ClientImpl(const ClientConfig& _config) :
   client_config(_config)
 {}
 
 Client::ClientImpl::~ClientImpl()
 {
+  // The writer threads need to be stopped before their writers are deleted
+  if (fields.state_pub)
+    fields.state_pub->stop_async();
+  if (fields.state_delta_pub)
+    fields.state_delta_pub->stop_async();
+
   dds_return_t return_code = dds_delete(fields.participant);
   if (return_code != DDS_RETCODE_OK)
   {
@@ -36,52 +70,164 @@ Client::ClientImpl::~ClientImpl()
 void Client::ClientImpl::start(Fields _fields)
 {
   fields = std::move(_fields);
+
+  // The robot ID is taken as soon as the registration arrives, rather than
+  // while sending, as requests addressed by the ID are filtered with it even
+  // when robot states are never sent addressed by it. Registrations that
+  // arrived before the listener was installed are taken right away.
+  if (fields.registration_sub)
+  {
+    fields.registration_sub->set_data_available_callback(
+        [this]() { update_robot_id(); });
+    update_robot_id();
+  }
+
+  if (!client_config.async_publish)
+    return;
+
+  const size_t queue_size = client_config.async_publish_queue_size;
+  fields.state_pub->start_async(queue_size);
+  if (fields.state_delta_pub)
+    fields.state_delta_pub->start_async(queue_size);
+}
+
+bool Client::ClientImpl::send_robot_state(
+    const messages::RobotState& _new_robot_state)
+{
+  if (!fields.state_delta_pub)
+    return fields.state_pub->publish(_new_robot_state);
+
+  if (!keyframe_due(_new_robot_state))
+    return send_robot_state_delta(_new_robot_state);
+
+  if (!fields.state_pub->publish(_new_robot_state))
+    return false;
+  keyframe = _new_robot_state;
+  has_keyframe = true;
+  states_since_keyframe = 0;
+  return true;
 }
 
 bool Client::ClientImpl::send_robot_state(
+    messages::RobotState&& _new_robot_state)
+{
+  if (!fields.state_delta_pub)
+    return fields.state_pub->publish(std::move(_new_robot_state));
+
+  if (!keyframe_due(_new_robot_state))
+    return send_robot_state_delta(_new_robot_state);
+
+  // The keyframe is kept before the state is moved, and dropped again if the
+  // state could not be sent, so that the next state is sent in full.
+  keyframe = _new_robot_state;
+  states_since_keyframe = 0;
+  has_keyframe = fields.state_pub->publish(std::move(_new_robot_state));
+  return has_keyframe;
+}
+
+bool Client::ClientImpl::keyframe_due(
+    const messages::RobotState& _new_robot_state) const
+{
+  return !has_keyframe ||
+      states_since_keyframe + 1 >= client_config.state_keyframe_interval ||
+      _new_robot_state.name != keyframe.name ||
+      !messages::same_path(_new_robot_state.path, keyframe.path);
+}
+
+bool Client::ClientImpl::send_robot_state_delta(
     const messages::RobotState& _new_robot_state)
 {
-  FreeFleetData_RobotState* new_rs = FreeFleetData_RobotState__alloc();
-  convert(_new_robot_state, *new_rs);
-  bool sent = fields.state_pub->write(new_rs);
-  FreeFleetData_RobotState_free(new_rs, DDS_FREE_ALL);
-  return sent;
+  ++states_since_keyframe;
+  messages::make_robot_state_delta(keyframe, _new_robot_state, state_delta);
+  return fields.state_delta_pub->publish(state_delta);
+}
+
+bool Client::ClientImpl::write_registered_robot_state(
+    dds::DDSPublishHandler<FreeFleetData_RobotState>& _state_pub,
+    const messages::RobotState& _new_robot_state)
+{
+  // The robot name only goes out in the full robot states, which the server
+  // assigns the robot ID from, and which keep announcing the robot to
+  // servers that joined later.
+  const uint32_t robot_id = fields.robot_id->load();
+  if (robot_id == 0 ||
+      states_since_announcement + 1 >=
+          client_config.robot_id_announce_interval ||
+      _new_robot_state.name != client_config.robot_name)
+  {
+    states_since_announcement = 0;
+    return _state_pub.write_converted(_new_robot_state);
+  }
+
+  ++states_since_announcement;
+  return fields.registered_state_pub->write_converted(
+      messages::Registered<messages::RobotState>{
+          robot_id, &_new_robot_state});
+}
+
+void Client::ClientImpl::update_robot_id()
+{
+  std::vector<std::shared_ptr<const FreeFleetData_RobotRegistration>>
+      registrations;
+  fields.registration_sub->take_all_loaned(registrations);
+  if (!registrations.empty())
+    fields.robot_id->store(registrations.back()->robot_id);
 }
 
 bool Client::ClientImpl::read_mode_request
     (messages::ModeRequest& _mode_request)
 {
-  auto mode_requests = fields.mode_request_sub->read();
+  auto mode_requests = fields.mode_request_sub->take_loaned();
   if (!mode_requests.empty())
   {
     convert(*(mode_requests[0]), _mode_request);
     return true;
   }
-  return false;
+  return take_registered_request(
+      fields.registered_mode_request_sub.get(), client_config, _mode_request);
 }
 
 bool Client::ClientImpl::read_path_request(
     messages::PathRequest& _path_request)
 {
-  auto path_requests = fields.path_request_sub->read();
-  if (!path_requests.empty())
-  {
-    convert(*(path_requests[0]), _path_request);
+  if (fields.path_request_sub->take(_path_request))
     return true;
-  }
-  return false;
+  return take_registered_request(
+      fields.registered_path_request_sub.get(), client_config, _path_request);
 }
 
 bool Client::ClientImpl::read_destination_request(
     messages::DestinationRequest& _destination_request)
 {
-  auto destination_requests = fields.destination_request_sub->read();
+  auto destination_requests = fields.destination_request_sub->take_loaned();
   if (!destination_requests.empty())
   {
     convert(*(destination_requests[0]), _destination_request);
     return true;
   }
-  return false;
+  return take_registered_request(
+      fields.registered_destination_request_sub.get(), client_config,
+      _destination_request);
+}
+
+bool Client::ClientImpl::send_request_ack(
+    const messages::RequestAck& _request_ack)
+{
+  return fields.request_ack_pub->write_converted(_request_ack);
+}
+
+bool Client::ClientImpl::wait_for_requests(std::chrono::nanoseconds _timeout)
+{
+  return common::dds_wait(
+      fields.request_waitset, static_cast<dds_duration_t>(_timeout.count()));
+}
+
+uint64_t Client::ClientImpl::get_async_dropped_count() const
+{
+  uint64_t dropped_count = fields.state_pub->get_dropped_count();
+  if (fields.state_delta_pub)
+    dropped_count += fields.state_delta_pub->get_dropped_count();
+  return dropped_count;
 }
 
 } // namespace free_fleet
@@ -18,6 +18,11 @@
 #ifndef FREE_FLEET__SRC__CLIENTIMPL_HPP
 #define FREE_FLEET__SRC__CLIENTIMPL_HPP
 
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <cstdint>
+
 #include <free_fleet/messages/RobotState.hpp>
 #include <free_fleet/messages/ModeRequest.hpp>
 #include <free_fleet/messages/PathRequest.hpp>
@@ -28,8 +33,11 @@
 #include <dds/dds.h>
 
 #include "messages/FleetMessages.h"
+#include "messages/RobotStateDelta.hpp"
 #include "dds_utils/DDSPublishHandler.hpp"
 #include "dds_utils/DDSSubscribeHandler.hpp"
+#include "dds_utils/ConvertingPublishHandler.hpp"
+#include "dds_utils/ConvertingSubscribeHandler.hpp"
 
 namespace free_fleet {
 
@@ -43,22 +51,63 @@ public:
     /// DDS participant that is tied to the configured dds_domain_id
     dds_entity_t participant;
 
-    /// DDS publisher that handles sending out current robot states to the 
-    /// server
-    dds::DDSPublishHandler<FreeFleetData_RobotState>::SharedPtr
+    /// DDS publisher that handles sending out current robot states to the
+    /// server, in the configured message format
+    dds::ConvertingPublishHandler<messages::RobotState>::SharedPtr
         state_pub;
 
     /// DDS subscriber for mode requests coming from the server
     dds::DDSSubscribeHandler<FreeFleetData_ModeRequest>::SharedPtr 
         mode_request_sub;
 
-    /// DDS subscriber for path requests coming from the server
-    dds::DDSSubscribeHandler<FreeFleetData_PathRequest>::SharedPtr 
+    /// DDS subscriber for path requests coming from the server, in the
+    /// configured message format
+    dds::ConvertingSubscribeHandler<messages::PathRequest>::SharedPtr
         path_request_sub;
 
     /// DDS subscriber for destination requests coming from the server
     dds::DDSSubscribeHandler<FreeFleetData_DestinationRequest>::SharedPtr
         destination_request_sub;
+
+    /// DDS waitset that triggers when any of the requests are available
+    dds_entity_t request_waitset;
+
+    /// DDS publisher for robot state deltas, only created when a state
+    /// keyframe interval is configured
+    dds::ConvertingPublishHandler<messages::RobotStateDelta>::SharedPtr
+        state_delta_pub;
+
+    /// DDS subscriber for the robot ID assigned by the server, only created
+    /// when robot_ids is enabled, which only lets through the registration
+    /// of this robot
+    dds::DDSSubscribeHandler<FreeFleetData_RobotRegistration>::SharedPtr
+        registration_sub;
+
+    /// DDS publisher for robot states addressed by robot ID, only created
+    /// when robot_ids is enabled and state deltas are not
+    dds::DDSPublishHandler<FreeFleetData_RegisteredRobotState>::SharedPtr
+        registered_state_pub;
+
+    /// DDS subscribers for requests addressed by robot ID, only created when
+    /// robot_ids is enabled, which only let through requests for robot_id
+    dds::DDSSubscribeHandler<FreeFleetData_RegisteredModeRequest>::SharedPtr
+        registered_mode_request_sub;
+
+    dds::DDSSubscribeHandler<FreeFleetData_RegisteredPathRequest>::SharedPtr
+        registered_path_request_sub;
+
+    dds::DDSSubscribeHandler<
+        FreeFleetData_RegisteredDestinationRequest>::SharedPtr
+            registered_destination_request_sub;
+
+    /// Robot ID assigned by the server, 0 until the registration of this
+    /// robot has been received. Shared with the filters of the registered
+    /// request subscribers.
+    std::shared_ptr<std::atomic<uint32_t>> robot_id;
+
+    /// DDS publisher for the acknowledgements of the requests
+    dds::DDSPublishHandler<FreeFleetData_RequestAck>::SharedPtr
+        request_ack_pub;
   };
 
   ClientImpl(const ClientConfig& config);
@@ -69,6 +118,8 @@ public:
 
   bool send_robot_state(const messages::RobotState& new_robot_state);
 
+  bool send_robot_state(messages::RobotState&& new_robot_state);
+
   bool read_mode_request(messages::ModeRequest& mode_request);
 
   bool read_path_request(messages::PathRequest& path_request);
@@ -76,12 +127,47 @@ public:
   bool read_destination_request(
       messages::DestinationRequest& destination_request);
 
+  bool send_request_ack(const messages::RequestAck& request_ack);
+
+  bool wait_for_requests(std::chrono::nanoseconds timeout);
+
+  uint64_t get_async_dropped_count() const;
+
+  /// Writes a robot state in the standard message format, addressed by the
+  /// robot ID once the server assigned one, which is only used when
+  /// registered_state_pub was created.
+  bool write_registered_robot_state(
+      dds::DDSPublishHandler<FreeFleetData_RobotState>& state_pub,
+      const messages::RobotState& new_robot_state);
+
 private:
 
   Fields fields;
 
   ClientConfig client_config;
 
+  /// Last full robot state that was sent, which deltas are taken against
+  messages::RobotState keyframe;
+
+  bool has_keyframe = false;
+
+  size_t states_since_keyframe = 0;
+
+  messages::RobotStateDelta state_delta;
+
+  /// Number of robot states sent by robot ID since the last full robot
+  /// state announcing the robot name
+  size_t states_since_announcement = 0;
+
+  /// Whether the robot state needs to be sent in full, as the next keyframe
+  bool keyframe_due(const messages::RobotState& new_robot_state) const;
+
+  bool send_robot_state_delta(const messages::RobotState& new_robot_state);
+
+  /// Takes the latest registration of this robot, from the listener of the
+  /// registration reader.
+  void update_robot_id();
+
 };
 
 } // namespace free_fleet
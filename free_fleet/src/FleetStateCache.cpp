@@ -0,0 +1,130 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <thread>
+
+#include "FleetStateCache.hpp"
+
+namespace free_fleet {
+
+constexpr size_t FleetStateCache::slot_count;
+
+FleetStateCache::FleetStateCache() :
+  current(0)
+{
+  for (Slot& slot : slots)
+    slot.readers.store(0);
+  slots[0].snapshot = std::make_shared<const Snapshot>();
+}
+
+void FleetStateCache::update(
+    const std::vector<messages::RobotState>& _robot_states,
+    size_t _robot_state_count,
+    std::vector<std::shared_ptr<const messages::RobotState>>* _stored)
+{
+  if (_stored)
+    _stored->clear();
+  if (_robot_state_count == 0)
+    return;
+
+  std::lock_guard<std::mutex> lock(update_mutex);
+  std::shared_ptr<Snapshot> snapshot = copy_current();
+  for (size_t i = 0; i < _robot_state_count; ++i)
+  {
+    auto& robot_state = (*snapshot)[_robot_states[i].name];
+    robot_state =
+        std::make_shared<const messages::RobotState>(_robot_states[i]);
+    if (_stored)
+      _stored->push_back(robot_state);
+  }
+  publish(std::move(snapshot));
+}
+
+void FleetStateCache::update(const messages::RobotState& _robot_state)
+{
+  std::lock_guard<std::mutex> lock(update_mutex);
+  std::shared_ptr<Snapshot> snapshot = copy_current();
+  (*snapshot)[_robot_state.name] =
+      std::make_shared<const messages::RobotState>(_robot_state);
+  publish(std::move(snapshot));
+}
+
+std::shared_ptr<const FleetStateCache::Snapshot>
+FleetStateCache::snapshot() const
+{
+  while (true)
+  {
+    const size_t index = current.load();
+    const Slot& slot = slots[index];
+    slot.readers.fetch_add(1);
+
+    // Once the slot is pinned, it can only be overwritten after the reader
+    // count drops back to zero. If the slot is still current after pinning
+    // it, no update could have started overwriting it before it was pinned
+    // either, as updates only overwrite slots that are not current.
+    if (current.load() == index)
+    {
+      std::shared_ptr<const Snapshot> snapshot = slot.snapshot;
+      slot.readers.fetch_sub(1);
+      return snapshot;
+    }
+    slot.readers.fetch_sub(1);
+  }
+}
+
+std::shared_ptr<const messages::RobotState> FleetStateCache::find(
+    const std::string& _robot_name) const
+{
+  std::shared_ptr<const Snapshot> fleet = snapshot();
+  auto it = fleet->find(_robot_name);
+  if (it == fleet->end())
+    return nullptr;
+  return it->second;
+}
+
+std::shared_ptr<FleetStateCache::Snapshot>
+FleetStateCache::copy_current() const
+{
+  // Only updates change the current slot, so it can be read directly.
+  return std::make_shared<Snapshot>(*slots[current.load()].snapshot);
+}
+
+void FleetStateCache::publish(std::shared_ptr<const Snapshot> _snapshot)
+{
+  const size_t current_index = current.load();
+  for (size_t i = 1; ; ++i)
+  {
+    const size_t index = (current_index + i) % slot_count;
+    if (index == current_index)
+    {
+      // Every other slot is pinned by a reader, which only takes as long as
+      // copying a shared pointer.
+      std::this_thread::yield();
+      continue;
+    }
+
+    Slot& slot = slots[index];
+    if (slot.readers.load() != 0)
+      continue;
+
+    slot.snapshot = std::move(_snapshot);
+    current.store(index);
+    return;
+  }
+}
+
+} // namespace free_fleet
@@ -0,0 +1,118 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef FREE_FLEET__SRC__FLEETSTATECACHE_HPP
+#define FREE_FLEET__SRC__FLEETSTATECACHE_HPP
+
+#include <array>
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+#include <free_fleet/Server.hpp>
+#include <free_fleet/messages/RobotState.hpp>
+
+namespace free_fleet {
+
+/// Keeps the latest robot state of every robot, and publishes it as
+/// immutable snapshots. Every update copies the map of the current snapshot,
+/// which only holds shared pointers to the robot states, and publishes the
+/// copy as the new snapshot.
+///
+/// As snapshots are immutable, the reused capacity of the converted robot
+/// states does not carry over into the cache. Each update allocates a map
+/// node for every robot of the fleet, and each stored robot state is copied
+/// into a new shared RobotState, which allocates for the state, its path, and
+/// every string longer than the inline buffer of std::string. For a fleet of
+/// 500 robots with 20 waypoint paths, that is about 1.5k allocations per
+/// read of a state from every robot, against the roughly 12k strings of
+/// those states, most of which are short enough to be copied inline.
+///
+/// Snapshots are kept in a small ring of slots, each with a count of the
+/// readers that are copying its snapshot. Readers never take a lock, they pin
+/// the current slot and only retry if a new snapshot got published in the
+/// meantime. Updates are serialized by a mutex, and only overwrite slots that
+/// are neither current nor pinned by a reader. Snapshots that readers still
+/// hold on to are freed once the last reader releases them.
+class FleetStateCache
+{
+public:
+
+  using Snapshot = Server::FleetSnapshot;
+
+  FleetStateCache();
+
+  /// Stores the first robot_state_count robot states, and publishes a single
+  /// new snapshot for all of them.
+  ///
+  /// \param[out] stored
+  ///   If given, is filled with the stored robot states in the same order,
+  ///   which are shared with the snapshots.
+  void update(
+      const std::vector<messages::RobotState>& robot_states,
+      size_t robot_state_count,
+      std::vector<std::shared_ptr<const messages::RobotState>>* stored =
+          nullptr);
+
+  /// Stores the robot state, and publishes a new snapshot.
+  void update(const messages::RobotState& robot_state);
+
+  /// Current snapshot, which is never modified.
+  std::shared_ptr<const Snapshot> snapshot() const;
+
+  /// Latest robot state of the robot, or nullptr if no robot state of this
+  /// robot has been stored.
+  std::shared_ptr<const messages::RobotState> find(
+      const std::string& robot_name) const;
+
+private:
+
+  struct Slot
+  {
+    std::shared_ptr<const Snapshot> snapshot;
+
+    mutable std::atomic<uint32_t> readers;
+
+    /// Keeps the reader counts of neighbouring slots on separate cache
+    /// lines.
+    char padding[64 - sizeof(std::atomic<uint32_t>)];
+  };
+
+  static constexpr size_t slot_count = 4;
+
+  std::array<Slot, slot_count> slots;
+
+  std::atomic<size_t> current;
+
+  std::mutex update_mutex;
+
+  /// Copies the map of the current snapshot for an update, only called while
+  /// holding the update mutex.
+  std::shared_ptr<Snapshot> copy_current() const;
+
+  /// Publishes the snapshot into a free slot, only called while holding the
+  /// update mutex.
+  void publish(std::shared_ptr<const Snapshot> snapshot);
+
+};
+
+} // namespace free_fleet
+
+#endif // FREE_FLEET__SRC__FLEETSTATECACHE_HPP
@@ -0,0 +1,169 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <iterator>
+#include <algorithm>
+
+#include "RequestAckTracker.hpp"
+
+namespace free_fleet {
+
+namespace {
+
+std::chrono::nanoseconds to_nanoseconds(RequestAckTracker::Clock::duration _d)
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(_d);
+}
+
+} // anonymous namespace
+
+//==============================================================================
+
+RequestAckTracker::RequestAckTracker(
+    size_t _max_pending, size_t _latency_window) :
+  max_pending(_max_pending > 0 ? _max_pending : 1),
+  latency_window(_latency_window > 0 ? _latency_window : 1)
+{
+  latencies.reserve(latency_window);
+}
+
+bool RequestAckTracker::sent(
+    uint32_t _request_type,
+    const std::string& _fleet_name,
+    const std::string& _robot_name,
+    const std::string& _task_id,
+    Clock::time_point _now)
+{
+  make_key(_request_type, _fleet_name, _robot_name, _task_id);
+  auto it = pending_keys.find(key);
+  if (it != pending_keys.end())
+  {
+    pending.splice(pending.end(), pending, it->second);
+    it->second->sent_time = _now;
+    it->second->resent = true;
+    return false;
+  }
+
+  if (pending.size() >= max_pending)
+  {
+    pending_keys.erase(pending.front().key);
+    pending.pop_front();
+  }
+  pending.push_back(
+      Pending{
+          key, _fleet_name, _robot_name, _task_id, _request_type, _now,
+          false});
+  pending_keys.emplace(key, std::prev(pending.end()));
+  return true;
+}
+
+void RequestAckTracker::unsent(
+    uint32_t _request_type,
+    const std::string& _fleet_name,
+    const std::string& _robot_name,
+    const std::string& _task_id)
+{
+  make_key(_request_type, _fleet_name, _robot_name, _task_id);
+  auto it = pending_keys.find(key);
+  if (it == pending_keys.end())
+    return;
+
+  pending.erase(it->second);
+  pending_keys.erase(it);
+}
+
+bool RequestAckTracker::acknowledged(
+    const messages::RequestAck& _request_ack,
+    Clock::time_point _now,
+    Clock::duration& _latency)
+{
+  make_key(
+      _request_ack.request_type, _request_ack.fleet_name,
+      _request_ack.robot_name, _request_ack.task_id);
+  auto it = pending_keys.find(key);
+  if (it == pending_keys.end())
+    return false;
+
+  _latency = _now - it->second->sent_time;
+  if (!it->second->resent)
+  {
+    if (latencies.size() < latency_window)
+      latencies.push_back(_latency);
+    else
+      latencies[next_latency] = _latency;
+    next_latency = (next_latency + 1) % latency_window;
+  }
+
+  pending.erase(it->second);
+  pending_keys.erase(it);
+  return true;
+}
+
+Server::RequestAckLatency RequestAckTracker::latency() const
+{
+  Server::RequestAckLatency latency;
+  latency.count = latencies.size();
+  if (latencies.empty())
+    return latency;
+
+  std::vector<Clock::duration> sorted(latencies);
+  auto percentile = [&sorted](size_t _percent)
+  {
+    const size_t index = (sorted.size() - 1) * _percent / 100;
+    std::nth_element(sorted.begin(), sorted.begin() + index, sorted.end());
+    return to_nanoseconds(sorted[index]);
+  };
+  latency.p50 = percentile(50);
+  latency.p90 = percentile(90);
+  latency.p99 = percentile(99);
+  latency.max = to_nanoseconds(*std::max_element(sorted.begin(), sorted.end()));
+  return latency;
+}
+
+void RequestAckTracker::unacknowledged(
+    Clock::time_point _now,
+    Clock::duration _min_age,
+    std::vector<Server::UnacknowledgedRequest>& _requests) const
+{
+  for (const Pending& request : pending)
+  {
+    const Clock::duration age = _now - request.sent_time;
+    if (age < _min_age)
+      break;
+    _requests.push_back(
+        Server::UnacknowledgedRequest{
+            request.fleet_name, request.robot_name, request.task_id,
+            request.request_type, to_nanoseconds(age)});
+  }
+}
+
+void RequestAckTracker::make_key(
+    uint32_t _request_type,
+    const std::string& _fleet_name,
+    const std::string& _robot_name,
+    const std::string& _task_id)
+{
+  key.assign(
+      reinterpret_cast<const char*>(&_request_type), sizeof(_request_type));
+  key.append(_fleet_name);
+  key.push_back('\0');
+  key.append(_robot_name);
+  key.push_back('\0');
+  key.append(_task_id);
+}
+
+} // namespace free_fleet
@@ -0,0 +1,131 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef FREE_FLEET__SRC__REQUESTACKTRACKER_HPP
+#define FREE_FLEET__SRC__REQUESTACKTRACKER_HPP
+
+#include <list>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <unordered_map>
+
+#include <free_fleet/Server.hpp>
+#include <free_fleet/messages/RequestAck.hpp>
+
+namespace free_fleet {
+
+/// Tracks the sent requests until they are acknowledged, and the latencies
+/// of the latest acknowledgements. Requests are identified by their type,
+/// fleet name, robot name and task ID, and are kept in the order they were
+/// last sent, so that the oldest ones can be dropped once too many are
+/// tracked. Not thread safe.
+class RequestAckTracker
+{
+public:
+
+  using Clock = std::chrono::steady_clock;
+
+  /// \param[in] max_pending
+  ///   Maximum number of unacknowledged requests that are tracked.
+  /// \param[in] latency_window
+  ///   Number of latest latencies that the percentiles are taken over.
+  RequestAckTracker(size_t max_pending, size_t latency_window);
+
+  /// Starts tracking the request, or restarts tracking it from now if it
+  /// was already sent before. Requests are tracked before they are
+  /// published, so that acknowledgements that arrive right away are not
+  /// missed.
+  ///
+  /// \return
+  ///   True if the request was not tracked yet.
+  bool sent(
+      uint32_t request_type,
+      const std::string& fleet_name,
+      const std::string& robot_name,
+      const std::string& task_id,
+      Clock::time_point now);
+
+  /// Stops tracking a request that failed to be published.
+  void unsent(
+      uint32_t request_type,
+      const std::string& fleet_name,
+      const std::string& robot_name,
+      const std::string& task_id);
+
+  /// Stops tracking the request that is acknowledged.
+  ///
+  /// \param[out] latency
+  ///   Time since the request was last sent.
+  /// \return
+  ///   True if the request was being tracked, false if it was already
+  ///   acknowledged, or never sent by this server.
+  bool acknowledged(
+      const messages::RequestAck& request_ack,
+      Clock::time_point now,
+      Clock::duration& latency);
+
+  Server::RequestAckLatency latency() const;
+
+  /// Appends the requests that were last sent at least min_age ago, the
+  /// ones sent longest ago first.
+  void unacknowledged(
+      Clock::time_point now,
+      Clock::duration min_age,
+      std::vector<Server::UnacknowledgedRequest>& requests) const;
+
+private:
+
+  struct Pending
+  {
+    std::string key;
+    std::string fleet_name;
+    std::string robot_name;
+    std::string task_id;
+    uint32_t request_type;
+    Clock::time_point sent_time;
+    bool resent;
+  };
+
+  size_t max_pending;
+
+  /// Unacknowledged requests, ordered by the time they were last sent.
+  std::list<Pending> pending;
+
+  std::unordered_map<std::string, std::list<Pending>::iterator> pending_keys;
+
+  /// Ring of the latest latencies
+  std::vector<Clock::duration> latencies;
+
+  size_t latency_window;
+
+  size_t next_latency = 0;
+
+  /// Reused to look up requests without allocating
+  std::string key;
+
+  void make_key(
+      uint32_t request_type,
+      const std::string& fleet_name,
+      const std::string& robot_name,
+      const std::string& task_id);
+};
+
+} // namespace free_fleet
+
+#endif // FREE_FLEET__SRC__REQUESTACKTRACKER_HPP
@@ -0,0 +1,105 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "RobotPresenceTracker.hpp"
+
+namespace free_fleet {
+
+RobotPresenceTracker::RobotPresenceTracker(
+    std::chrono::nanoseconds _deadline) :
+  deadline(std::chrono::duration_cast<Clock::duration>(_deadline))
+{}
+
+void RobotPresenceTracker::received(
+    const std::vector<messages::RobotState>& _robot_states,
+    size_t _robot_state_count,
+    Clock::time_point _now,
+    std::vector<Change>& _changes)
+{
+  for (size_t i = 0; i < _robot_state_count; ++i)
+  {
+    auto it = robots.find(_robot_states[i].name);
+    if (it == robots.end())
+      it = robots.emplace(_robot_states[i].name, Robot()).first;
+
+    Robot& robot = it->second;
+    robot.last_received = _now;
+    if (robot.presence == Presence::ALIVE)
+      alive_robots.splice(
+          alive_robots.end(), alive_robots, robot.alive_position);
+    else
+      set_presence(*it, Presence::ALIVE, _changes);
+  }
+}
+
+void RobotPresenceTracker::deadline_missed(
+    Clock::time_point _now, std::vector<Change>& _changes)
+{
+  if (deadline <= Clock::duration::zero())
+    return;
+
+  // DDS measures the deadline from when it received the last robot state,
+  // which is slightly earlier than when the state got here, so robots that
+  // are just short of missing the deadline are counted as having missed it.
+  const Clock::time_point cutoff = _now - (deadline - deadline / 10);
+  while (!alive_robots.empty() &&
+      alive_robots.front()->second.last_received <= cutoff)
+    set_presence(*alive_robots.front(), Presence::STALE, _changes);
+}
+
+void RobotPresenceTracker::liveliness_changed(
+    const std::string& _robot_name, bool _alive,
+    std::vector<Change>& _changes)
+{
+  auto it = robots.find(_robot_name);
+  if (!_alive)
+  {
+    if (it != robots.end() && it->second.presence != Presence::LOST)
+      set_presence(*it, Presence::LOST, _changes);
+    return;
+  }
+
+  if (it == robots.end())
+    it = robots.emplace(_robot_name, Robot()).first;
+  if (it->second.presence == Presence::LOST)
+    set_presence(*it, Presence::STALE, _changes);
+}
+
+bool RobotPresenceTracker::find(
+    const std::string& _robot_name, Presence& _presence) const
+{
+  auto it = robots.find(_robot_name);
+  if (it == robots.end())
+    return false;
+  _presence = it->second.presence;
+  return true;
+}
+
+void RobotPresenceTracker::set_presence(
+    Entry& _robot, Presence _presence, std::vector<Change>& _changes)
+{
+  Robot& robot = _robot.second;
+  if (robot.presence == Presence::ALIVE)
+    alive_robots.erase(robot.alive_position);
+  else if (_presence == Presence::ALIVE)
+    robot.alive_position = alive_robots.insert(alive_robots.end(), &_robot);
+
+  robot.presence = _presence;
+  _changes.push_back(Change{_robot.first, _presence});
+}
+
+} // namespace free_fleet
@@ -0,0 +1,110 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef FREE_FLEET__SRC__ROBOTPRESENCETRACKER_HPP
+#define FREE_FLEET__SRC__ROBOTPRESENCETRACKER_HPP
+
+#include <list>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <utility>
+#include <unordered_map>
+
+#include <free_fleet/Server.hpp>
+#include <free_fleet/messages/RobotState.hpp>
+
+namespace free_fleet {
+
+/// Tracks the presence of every robot from the robot states it receives, and
+/// from the deadline and liveliness events of DDS. Alive robots are kept in
+/// order of their last robot state, so that a missed deadline only visits
+/// the robots that actually became stale. Not thread safe.
+class RobotPresenceTracker
+{
+public:
+
+  using Presence = Server::RobotPresence;
+
+  using Clock = std::chrono::steady_clock;
+
+  struct Change
+  {
+    std::string robot_name;
+    Presence presence;
+  };
+
+  /// \param[in] deadline
+  ///   Longest time between robot states of an alive robot, robots never
+  ///   become stale with a non-positive deadline.
+  explicit RobotPresenceTracker(std::chrono::nanoseconds deadline);
+
+  /// Marks the robots of the first robot_state_count robot states as alive.
+  ///
+  /// \param[out] changes
+  ///   Vector that the resulting changes of presence are appended to.
+  void received(
+      const std::vector<messages::RobotState>& robot_states,
+      size_t robot_state_count,
+      Clock::time_point now,
+      std::vector<Change>& changes);
+
+  /// Marks the alive robots whose last robot state is older than the
+  /// deadline as stale.
+  void deadline_missed(Clock::time_point now, std::vector<Change>& changes);
+
+  /// Marks the robot as lost when its writer is no longer alive, or as
+  /// stale when its writer becomes alive before it sent any robot state.
+  void liveliness_changed(
+      const std::string& robot_name, bool alive,
+      std::vector<Change>& changes);
+
+  /// \return
+  ///   True if the robot is known, false otherwise.
+  bool find(const std::string& robot_name, Presence& presence) const;
+
+private:
+
+  struct Robot;
+
+  /// Element of robots, which keeps its address when robots get rehashed.
+  using Entry = std::pair<const std::string, Robot>;
+
+  struct Robot
+  {
+    Presence presence = Presence::LOST;
+
+    Clock::time_point last_received;
+
+    /// Position in alive_robots, only valid while the robot is alive.
+    std::list<Entry*>::iterator alive_position;
+  };
+
+  Clock::duration deadline;
+
+  std::unordered_map<std::string, Robot> robots;
+
+  /// Alive robots, ordered by the time of their last robot state.
+  std::list<Entry*> alive_robots;
+
+  void set_presence(
+      Entry& robot, Presence presence, std::vector<Change>& changes);
+};
+
+} // namespace free_fleet
+
+#endif // FREE_FLEET__SRC__ROBOTPRESENCETRACKER_HPP
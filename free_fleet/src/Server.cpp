@@ -22,13 +22,82 @@
 #include "ServerImpl.hpp"
 
 #include "messages/FleetMessages.h"
+#include "messages/message_utils.hpp"
+#include "messages/PathCompressor.hpp"
 #include "dds_utils/DDSPublishHandler.hpp"
 #include "dds_utils/DDSSubscribeHandler.hpp"
+#include "dds_utils/ConvertingPublishHandler.hpp"
+#include "dds_utils/ConvertingSubscribeHandler.hpp"
+#include "dds_utils/common.hpp"
 
 namespace free_fleet {
 
+namespace {
+
+/// Makes a publisher that addresses requests by the robot ID that the robot
+/// was assigned, and by name to robots that have no ID yet.
+template <typename Request, typename Message, typename RegisteredMessage>
+typename dds::ConvertingPublishHandler<Request>::SharedPtr
+make_registered_request_pub(
+    std::shared_ptr<dds::DDSPublishHandler<Message>> _pub,
+    std::shared_ptr<dds::DDSPublishHandler<RegisteredMessage>> _registered_pub,
+    std::function<uint32_t(const std::string&)> _find_robot_id)
+{
+  if (!_registered_pub)
+    return dds::ConvertingPublishHandler<Request>::template make<Message>(
+        _pub);
+
+  auto write = [_pub, _registered_pub, _find_robot_id](
+      const Request& _request)
+  {
+    const uint32_t robot_id = _find_robot_id(_request.robot_name);
+    if (robot_id == 0)
+      return _pub->write_converted(_request);
+    return _registered_pub->write_converted(
+        messages::Registered<Request>{robot_id, &_request});
+  };
+
+  auto write_batch = [_pub, _registered_pub, _find_robot_id](
+      const std::vector<Request>& _requests)
+  {
+    // Requests to robots without an ID are rare, these are written one by
+    // one while the rest is still written as a single batch.
+    std::vector<messages::Registered<Request>> registered_requests;
+    registered_requests.reserve(_requests.size());
+    bool all_written = true;
+    for (const auto& request : _requests)
+    {
+      const uint32_t robot_id = _find_robot_id(request.robot_name);
+      if (robot_id == 0)
+        all_written = _pub->write_converted(request) && all_written;
+      else
+        registered_requests.push_back({robot_id, &request});
+    }
+    return _registered_pub->write_converted_batch(registered_requests) &&
+        all_written;
+  };
+
+  return std::make_shared<dds::ConvertingPublishHandler<Request>>(
+      std::move(write), std::move(write_batch));
+}
+
+} // anonymous namespace
+
 Server::SharedPtr Server::make(const ServerConfig& _config)
 {
+  if (_config.message_format == MessageFormat::COMPRESSED &&
+      !messages::path_compression_available())
+  {
+    DDS_FATAL("compressed message format requires LZ4\n");
+    return nullptr;
+  }
+
+  if (_config.robot_ids && _config.message_format != MessageFormat::STANDARD)
+  {
+    DDS_FATAL("robot ids require the standard message format\n");
+    return nullptr;
+  }
+
   SharedPtr server = SharedPtr(new Server(_config));
 
   dds_entity_t participant = dds_create_participant(
@@ -39,33 +108,252 @@ Server::SharedPtr Server::make(const ServerConfig& _config)
     return nullptr;
   }
 
-  dds::DDSSubscribeHandler<FreeFleetData_RobotState, 10>::SharedPtr state_sub(
-      new dds::DDSSubscribeHandler<FreeFleetData_RobotState, 10>(
-          participant, &FreeFleetData_RobotState_desc,
-          _config.dds_robot_state_topic));
+  // The registration and the topics addressed by robot ID are only created
+  // with robot_ids enabled.
+  dds::DDSPublishHandler<FreeFleetData_RobotRegistration>::SharedPtr
+      registration_pub;
+  dds::DDSSubscribeHandler<FreeFleetData_RegisteredRobotState>::SharedPtr
+      registered_state_sub;
+  dds::DDSPublishHandler<FreeFleetData_RegisteredModeRequest>::SharedPtr
+      registered_mode_request_pub;
+  dds::DDSPublishHandler<FreeFleetData_RegisteredPathRequest>::SharedPtr
+      registered_path_request_pub;
+  dds::DDSPublishHandler<
+      FreeFleetData_RegisteredDestinationRequest>::SharedPtr
+          registered_destination_request_pub;
+  if (_config.robot_ids)
+  {
+    registration_pub.reset(
+        new dds::DDSPublishHandler<FreeFleetData_RobotRegistration>(
+            participant, &FreeFleetData_RobotRegistration_desc,
+            _config.dds_robot_registration_topic,
+            _config.dds_registration_qos));
+    registered_state_sub.reset(
+        new dds::DDSSubscribeHandler<FreeFleetData_RegisteredRobotState>(
+            participant, &FreeFleetData_RegisteredRobotState_desc,
+            _config.dds_registered_robot_state_topic,
+            _config.robot_state_batch_size,
+            _config.dds_robot_state_qos));
+    registered_mode_request_pub.reset(
+        new dds::DDSPublishHandler<FreeFleetData_RegisteredModeRequest>(
+            participant, &FreeFleetData_RegisteredModeRequest_desc,
+            _config.dds_registered_mode_request_topic,
+            _config.dds_mode_request_qos));
+    registered_path_request_pub.reset(
+        new dds::DDSPublishHandler<FreeFleetData_RegisteredPathRequest>(
+            participant, &FreeFleetData_RegisteredPathRequest_desc,
+            _config.dds_registered_path_request_topic,
+            _config.dds_path_request_qos));
+    registered_destination_request_pub.reset(
+        new dds::DDSPublishHandler<
+            FreeFleetData_RegisteredDestinationRequest>(
+                participant, &FreeFleetData_RegisteredDestinationRequest_desc,
+                _config.dds_registered_destination_request_topic,
+                _config.dds_destination_request_qos));
+    if (!registration_pub->is_ready() ||
+        !registered_state_sub->is_ready() ||
+        !registered_mode_request_pub->is_ready() ||
+        !registered_path_request_pub->is_ready() ||
+        !registered_destination_request_pub->is_ready())
+      return nullptr;
+  }
+
+  // Requests are addressed by the robot IDs that the server assigned, the
+  // server outlives the publishers that look them up.
+  ServerImpl* impl = server->impl.get();
+  const std::function<uint32_t(const std::string&)> find_robot_id =
+      [impl](const std::string& _robot_name)
+      {
+        return impl->find_robot_id(_robot_name);
+      };
+
+  // Robot states and path requests are only created in the configured
+  // message format, and the server only sees them through handlers that
+  // convert from and into that format.
+  dds::ConvertingSubscribeHandler<messages::RobotState>::SharedPtr state_sub;
+  dds::ConvertingPublishHandler<messages::PathRequest>::SharedPtr
+      path_request_pub;
+  bool path_topics_ready = false;
+
+  switch (_config.message_format)
+  {
+    case MessageFormat::FLAT:
+    {
+      dds::DDSSubscribeHandler<FreeFleetData_FlatRobotState>::SharedPtr
+          flat_state_sub(
+              new dds::DDSSubscribeHandler<FreeFleetData_FlatRobotState>(
+                  participant, &FreeFleetData_FlatRobotState_desc,
+                  _config.dds_robot_state_topic,
+                  _config.robot_state_batch_size,
+                  _config.dds_robot_state_qos));
+      dds::DDSPublishHandler<FreeFleetData_FlatPathRequest>::SharedPtr
+          flat_path_request_pub(
+              new dds::DDSPublishHandler<FreeFleetData_FlatPathRequest>(
+                  participant, &FreeFleetData_FlatPathRequest_desc,
+                  _config.dds_path_request_topic,
+                  _config.dds_path_request_qos));
+      path_topics_ready =
+          flat_state_sub->is_ready() && flat_path_request_pub->is_ready();
+      state_sub = dds::ConvertingSubscribeHandler<messages::RobotState>::
+          make<FreeFleetData_FlatRobotState>(std::move(flat_state_sub));
+      path_request_pub = dds::ConvertingPublishHandler<messages::PathRequest>::
+          make<FreeFleetData_FlatPathRequest>(
+              std::move(flat_path_request_pub),
+              [](const messages::PathRequest& _path_request)
+              {
+                return messages::fits_flat_message(_path_request);
+              });
+      break;
+    }
+
+    case MessageFormat::COMPACT:
+    {
+      dds::DDSSubscribeHandler<FreeFleetData_CompactRobotState>::SharedPtr
+          compact_state_sub(
+              new dds::DDSSubscribeHandler<FreeFleetData_CompactRobotState>(
+                  participant, &FreeFleetData_CompactRobotState_desc,
+                  _config.dds_robot_state_topic,
+                  _config.robot_state_batch_size,
+                  _config.dds_robot_state_qos));
+      dds::DDSPublishHandler<FreeFleetData_CompactPathRequest>::SharedPtr
+          compact_path_request_pub(
+              new dds::DDSPublishHandler<FreeFleetData_CompactPathRequest>(
+                  participant, &FreeFleetData_CompactPathRequest_desc,
+                  _config.dds_path_request_topic,
+                  _config.dds_path_request_qos));
+      path_topics_ready = compact_state_sub->is_ready() &&
+          compact_path_request_pub->is_ready();
+      state_sub = dds::ConvertingSubscribeHandler<messages::RobotState>::
+          make<FreeFleetData_CompactRobotState>(std::move(compact_state_sub));
+      path_request_pub = dds::ConvertingPublishHandler<messages::PathRequest>::
+          make<FreeFleetData_CompactPathRequest>(
+              std::move(compact_path_request_pub),
+              [](const messages::PathRequest& _path_request)
+              {
+                return messages::fits_compact_message(_path_request);
+              });
+      break;
+    }
+
+    case MessageFormat::COMPRESSED:
+    {
+      dds::DDSSubscribeHandler<FreeFleetData_CompressedRobotState>::SharedPtr
+          compressed_state_sub(
+              new dds::DDSSubscribeHandler<
+                  FreeFleetData_CompressedRobotState>(
+                      participant, &FreeFleetData_CompressedRobotState_desc,
+                      _config.dds_robot_state_topic,
+                      _config.robot_state_batch_size,
+                      _config.dds_robot_state_qos));
+      dds::DDSPublishHandler<FreeFleetData_CompressedPathRequest>::SharedPtr
+          compressed_path_request_pub(
+              new dds::DDSPublishHandler<
+                  FreeFleetData_CompressedPathRequest>(
+                      participant, &FreeFleetData_CompressedPathRequest_desc,
+                      _config.dds_path_request_topic,
+                      _config.dds_path_request_qos));
+      path_topics_ready = compressed_state_sub->is_ready() &&
+          compressed_path_request_pub->is_ready();
+      state_sub = dds::ConvertingSubscribeHandler<messages::RobotState>::
+          make<FreeFleetData_CompressedRobotState>(
+              std::move(compressed_state_sub));
+      path_request_pub = dds::ConvertingPublishHandler<messages::PathRequest>::
+          make_with_converter<FreeFleetData_CompressedPathRequest>(
+              std::move(compressed_path_request_pub),
+              std::make_shared<messages::PathCompressor>(
+                  _config.path_compression_threshold));
+      break;
+    }
+
+    default:
+    {
+      dds::DDSSubscribeHandler<FreeFleetData_RobotState>::SharedPtr
+          standard_state_sub(
+              new dds::DDSSubscribeHandler<FreeFleetData_RobotState>(
+                  participant, &FreeFleetData_RobotState_desc,
+                  _config.dds_robot_state_topic,
+                  _config.robot_state_batch_size,
+                  _config.dds_robot_state_qos));
+      dds::DDSPublishHandler<FreeFleetData_PathRequest>::SharedPtr
+          standard_path_request_pub(
+              new dds::DDSPublishHandler<FreeFleetData_PathRequest>(
+                  participant, &FreeFleetData_PathRequest_desc,
+                  _config.dds_path_request_topic,
+                  _config.dds_path_request_qos));
+      path_topics_ready = standard_state_sub->is_ready() &&
+          standard_path_request_pub->is_ready();
+      state_sub = dds::ConvertingSubscribeHandler<messages::RobotState>::
+          make<FreeFleetData_RobotState>(std::move(standard_state_sub));
+      path_request_pub = make_registered_request_pub<messages::PathRequest>(
+          std::move(standard_path_request_pub), registered_path_request_pub,
+          find_robot_id);
+      break;
+    }
+  }
 
   dds::DDSPublishHandler<FreeFleetData_ModeRequest>::SharedPtr 
-      mode_request_pub(
+      standard_mode_request_pub(
           new dds::DDSPublishHandler<FreeFleetData_ModeRequest>(
               participant, &FreeFleetData_ModeRequest_desc,
-              _config.dds_mode_request_topic));
-
-  dds::DDSPublishHandler<FreeFleetData_PathRequest>::SharedPtr 
-      path_request_pub(
-          new dds::DDSPublishHandler<FreeFleetData_PathRequest>(
-              participant, &FreeFleetData_PathRequest_desc,
-              _config.dds_path_request_topic));
+              _config.dds_mode_request_topic,
+              _config.dds_mode_request_qos));
 
   dds::DDSPublishHandler<FreeFleetData_DestinationRequest>::SharedPtr 
-      destination_request_pub(
+      standard_destination_request_pub(
           new dds::DDSPublishHandler<FreeFleetData_DestinationRequest>(
               participant, &FreeFleetData_DestinationRequest_desc,
-              _config.dds_destination_request_topic));
+              _config.dds_destination_request_topic,
+              _config.dds_destination_request_qos));
+
+  if (!path_topics_ready ||
+      !standard_mode_request_pub->is_ready() ||
+      !standard_destination_request_pub->is_ready())
+    return nullptr;
+
+  auto mode_request_pub = make_registered_request_pub<messages::ModeRequest>(
+      std::move(standard_mode_request_pub), registered_mode_request_pub,
+      find_robot_id);
+  auto destination_request_pub =
+      make_registered_request_pub<messages::DestinationRequest>(
+          std::move(standard_destination_request_pub),
+          registered_destination_request_pub, find_robot_id);
+
+  std::vector<dds_entity_t> state_readers = {state_sub->get_reader()};
+  if (registered_state_sub)
+    state_readers.push_back(registered_state_sub->get_reader());
+
+  dds::DDSSubscribeHandler<FreeFleetData_RobotStateDelta>::SharedPtr
+      state_delta_sub;
+  if (_config.robot_state_deltas)
+  {
+    state_delta_sub.reset(
+        new dds::DDSSubscribeHandler<FreeFleetData_RobotStateDelta>(
+            participant, &FreeFleetData_RobotStateDelta_desc,
+            _config.dds_robot_state_delta_topic,
+            _config.robot_state_batch_size,
+            _config.dds_robot_state_qos));
+    if (!state_delta_sub->is_ready())
+      return nullptr;
+    state_readers.push_back(state_delta_sub->get_reader());
+  }
+
+  dds::DDSSubscribeHandler<FreeFleetData_RequestAck>::SharedPtr
+      request_ack_sub;
+  if (_config.request_acks)
+  {
+    request_ack_sub.reset(
+        new dds::DDSSubscribeHandler<FreeFleetData_RequestAck>(
+            participant, &FreeFleetData_RequestAck_desc,
+            _config.dds_request_ack_topic,
+            _config.robot_state_batch_size,
+            _config.dds_request_ack_qos));
+    if (!request_ack_sub->is_ready())
+      return nullptr;
+  }
 
-  if (!state_sub->is_ready() ||
-      !mode_request_pub->is_ready() ||
-      !path_request_pub->is_ready() ||
-      !destination_request_pub->is_ready())
+  dds_entity_t robot_state_waitset = common::dds_create_read_waitset(
+      participant, state_readers);
+  if (robot_state_waitset < 0)
     return nullptr;
 
   server->impl->start(ServerImpl::Fields{
@@ -73,7 +361,12 @@ Server::SharedPtr Server::make(const ServerConfig& _config)
       std::move(state_sub),
       std::move(mode_request_pub),
       std::move(path_request_pub),
-      std::move(destination_request_pub)});
+      std::move(destination_request_pub),
+      std::move(robot_state_waitset),
+      std::move(state_delta_sub),
+      std::move(registration_pub),
+      std::move(registered_state_sub),
+      std::move(request_ack_sub)});
   return server;
 }
 
@@ -91,20 +384,128 @@ bool Server::read_robot_states(
   return impl->read_robot_states(_new_robot_states);
 }
 
+bool Server::wait_for_robot_states(std::chrono::nanoseconds _timeout)
+{
+  return impl->wait_for_robot_states(_timeout);
+}
+
+void Server::on_robot_state(RobotStateCallback _callback)
+{
+  impl->on_robot_state(std::move(_callback));
+}
+
+std::shared_ptr<const Server::FleetSnapshot> Server::fleet_snapshot() const
+{
+  return impl->fleet_snapshot();
+}
+
+std::shared_ptr<const messages::RobotState> Server::get_robot_state(
+    const std::string& _robot_name) const
+{
+  return impl->get_robot_state(_robot_name);
+}
+
+bool Server::get_robot_presence(
+    const std::string& _robot_name, RobotPresence& _presence) const
+{
+  return impl->get_robot_presence(_robot_name, _presence);
+}
+
+void Server::on_robot_presence(RobotPresenceCallback _callback)
+{
+  impl->on_robot_presence(std::move(_callback));
+}
+
+std::vector<std::string> Server::find_nearest_robots(
+    const std::string& _level_name, double _x, double _y, size_t _k) const
+{
+  return impl->find_nearest_robots(_level_name, _x, _y, _k);
+}
+
+std::vector<std::string> Server::find_robots_in_radius(
+    const std::string& _level_name, double _x, double _y,
+    double _radius) const
+{
+  return impl->find_robots_in_radius(_level_name, _x, _y, _radius);
+}
+
+std::vector<std::string> Server::find_robots_in_rectangle(
+    const std::string& _level_name,
+    double _min_x, double _min_y, double _max_x, double _max_y) const
+{
+  return impl->find_robots_in_rectangle(
+      _level_name, _min_x, _min_y, _max_x, _max_y);
+}
+
 bool Server::send_mode_request(const messages::ModeRequest& _mode_request)
 {
   return impl->send_mode_request(_mode_request);
 }
 
+bool Server::send_mode_request(messages::ModeRequest&& _mode_request)
+{
+  return impl->send_mode_request(std::move(_mode_request));
+}
+
 bool Server::send_path_request(const messages::PathRequest& _path_request)
 {
   return impl->send_path_request(_path_request);
 }
 
+bool Server::send_path_request(messages::PathRequest&& _path_request)
+{
+  return impl->send_path_request(std::move(_path_request));
+}
+
 bool Server::send_destination_request(
     const messages::DestinationRequest& _destination_request)
 {
   return impl->send_destination_request(_destination_request);
 }
 
+bool Server::send_destination_request(
+    messages::DestinationRequest&& _destination_request)
+{
+  return impl->send_destination_request(std::move(_destination_request));
+}
+
+bool Server::send_mode_requests(
+    const std::vector<messages::ModeRequest>& _mode_requests)
+{
+  return impl->send_mode_requests(_mode_requests);
+}
+
+bool Server::send_path_requests(
+    const std::vector<messages::PathRequest>& _path_requests)
+{
+  return impl->send_path_requests(_path_requests);
+}
+
+bool Server::send_destination_requests(
+    const std::vector<messages::DestinationRequest>& _destination_requests)
+{
+  return impl->send_destination_requests(_destination_requests);
+}
+
+void Server::on_request_ack(RequestAckCallback _callback)
+{
+  impl->on_request_ack(std::move(_callback));
+}
+
+Server::RequestAckLatency Server::get_request_ack_latency() const
+{
+  return impl->get_request_ack_latency();
+}
+
+std::vector<Server::UnacknowledgedRequest>
+Server::get_unacknowledged_requests(std::chrono::nanoseconds _min_age) const
+{
+  return impl->get_unacknowledged_requests(_min_age);
+}
+
+uint64_t Server::get_async_dropped_count() const
+{
+  return impl->get_async_dropped_count();
+}
+
 } // namespace free_fleet
@@ -15,17 +15,74 @@
  *
  */
 
+#include <random>
+
 #include "ServerImpl.hpp"
 #include "messages/message_utils.hpp"
+#include "dds_utils/common.hpp"
 
 namespace free_fleet {
 
+namespace {
+
+/// Robot IDs start from a random base, so that clients which still hold an
+/// ID assigned by a previous run of the server do not address another robot
+/// with it.
+uint32_t make_first_robot_id()
+{
+  std::random_device random;
+  return (static_cast<uint32_t>(random()) & 0xffff0000u) | 1u;
+}
+
+/// Longest time the ingest thread waits for robot states before checking
+/// whether it needs to stop.
+constexpr dds_duration_t ingest_wait_timeout = DDS_MSECS(100);
+
+} // anonymous namespace
+
+//==============================================================================
+
 Server::ServerImpl::ServerImpl(const ServerConfig& _config) :
-  server_config(_config)
-{}
+  server_config(_config),
+  robot_state_expiry(std::chrono::steady_clock::duration::zero()),
+  ingest_stopping(false),
+  next_robot_id(make_first_robot_id())
+{
+  if ((_config.spatial_index_cell_size > 0.0 || _config.robot_state_deltas) &&
+      _config.robot_state_expiry > 0.0)
+    robot_state_expiry =
+        std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            std::chrono::duration<double>(_config.robot_state_expiry));
+
+  if (_config.spatial_index_cell_size > 0.0)
+    spatial_index.reset(new SpatialIndex(_config.spatial_index_cell_size));
+
+  if (_config.request_acks)
+    request_acks.reset(new RequestAckTracker(
+        _config.request_ack_max_pending, _config.request_ack_latency_window));
+
+  if (_config.robot_presence)
+    robot_presence.reset(new RobotPresenceTracker(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::duration<double>(
+                _config.dds_robot_state_qos.deadline))));
+}
 
 Server::ServerImpl::~ServerImpl()
 {
+  // The ingest thread needs to be stopped before its readers are deleted
+  ingest_stopping.store(true);
+  if (ingest_thread.joinable())
+    ingest_thread.join();
+
+  // Writer threads need to be stopped before their writers are deleted
+  if (fields.mode_request_pub)
+  {
+    fields.mode_request_pub->stop_async();
+    fields.path_request_pub->stop_async();
+    fields.destination_request_pub->stop_async();
+  }
+
   dds_return_t return_code = dds_delete(fields.participant);
   if (return_code != DDS_RETCODE_OK)
   {
@@ -36,55 +93,961 @@ Server::ServerImpl::~ServerImpl()
 void Server::ServerImpl::start(Fields _fields)
 {
   fields = std::move(_fields);
+
+  if (robot_presence)
+    track_robot_presence();
+
+  if (fields.request_ack_sub)
+    fields.request_ack_sub->set_data_available_callback(
+        [this]() { receive_request_acks(); });
+
+  if (server_config.ingest_thread)
+    ingest_thread = std::thread(&ServerImpl::ingest_robot_states, this);
+
+  if (server_config.async_publish)
+  {
+    const size_t queue_size = server_config.async_publish_queue_size;
+    fields.mode_request_pub->start_async(queue_size);
+    fields.path_request_pub->start_async(queue_size);
+    fields.destination_request_pub->start_async(queue_size);
+  }
 }
 
 bool Server::ServerImpl::read_robot_states(
     std::vector<messages::RobotState>& _new_robot_states)
 {
-  auto robot_states = fields.robot_state_sub->read();
-  if (!robot_states.empty())
+  if (robot_state_listening.load())
+    return false;
+
+  if (!ingest_thread.joinable())
+    return take_new_robot_states(_new_robot_states);
+
+  // The states of the previous read are handed back to the ingest thread,
+  // which reuses their capacity.
+  std::lock_guard<std::mutex> lock(ingest_mutex);
+  if (ingested_count == 0)
+    return false;
+  ingested_robot_states.resize(ingested_count);
+  ingested_robot_states.swap(_new_robot_states);
+  ingested_count = 0;
+  ingested_indices.clear();
+  return true;
+}
+
+void Server::ServerImpl::ingest_robot_states()
+{
+  std::vector<messages::RobotState> robot_states;
+  while (!ingest_stopping.load())
   {
-    _new_robot_states.clear();
-    for (size_t i = 0; i < robot_states.size(); ++i)
+    if (!common::dds_wait(fields.robot_state_waitset, ingest_wait_timeout) ||
+        !take_new_robot_states(robot_states))
+      continue;
+
+    const auto callbacks = get_robot_state_callbacks();
+    if (callbacks)
     {
-      messages::RobotState tmp_robot_state;
-      convert(*(robot_states[i]), tmp_robot_state);
-      _new_robot_states.push_back(tmp_robot_state);
+      for (const auto& robot_state : robot_states)
+      {
+        for (const auto& callback : *callbacks)
+          callback(robot_state);
+      }
     }
-    return true;
+
+    // Only the latest state of every robot is held until the next read
+    {
+      std::lock_guard<std::mutex> lock(ingest_mutex);
+      for (auto& robot_state : robot_states)
+      {
+        const auto inserted =
+            ingested_indices.emplace(robot_state.name, ingested_count);
+        if (inserted.second)
+        {
+          if (ingested_robot_states.size() <= ingested_count)
+            ingested_robot_states.resize(ingested_count + 1);
+          ++ingested_count;
+        }
+        std::swap(ingested_robot_states[inserted.first->second], robot_state);
+      }
+    }
+    ingest_cv.notify_all();
+  }
+}
+
+bool Server::ServerImpl::take_new_robot_states(
+    std::vector<messages::RobotState>& _new_robot_states)
+{
+  // The states are converted in place, which keeps the capacity of their
+  // strings and paths from previous calls. Their writers are only needed to
+  // register the robots.
+  thread_local std::vector<dds_instance_handle_t> writers;
+  const size_t count = fields.robot_state_sub->take_all(
+      _new_robot_states, fields.registration_pub ? &writers : nullptr);
+  bool new_robot_states = count > 0;
+  if (new_robot_states)
+    _new_robot_states.resize(count);
+
+  if (fields.registration_pub)
+    register_robots(_new_robot_states, count, writers);
+
+  if (fields.registered_robot_state_sub)
+    new_robot_states = read_registered_robot_states(
+        _new_robot_states,
+        new_robot_states ? _new_robot_states.size() : 0) > 0;
+
+  if (!fields.robot_state_delta_sub)
+  {
+    if (new_robot_states)
+      store_robot_states(_new_robot_states, _new_robot_states.size());
+    return new_robot_states;
+  }
+
+  const size_t full_count = new_robot_states ? _new_robot_states.size() : 0;
+  if (!read_robot_state_deltas(_new_robot_states, full_count))
+    return false;
+
+  thread_local std::vector<std::shared_ptr<const messages::RobotState>>
+      stored;
+  store_robot_states(_new_robot_states, _new_robot_states.size(), &stored);
+  store_pending_keyframes(_new_robot_states, full_count, stored);
+  stored.clear();
+  return true;
+}
+
+std::shared_ptr<const Server::FleetSnapshot>
+Server::ServerImpl::fleet_snapshot() const
+{
+  return fleet_state_cache.snapshot();
+}
+
+std::shared_ptr<const messages::RobotState>
+Server::ServerImpl::get_robot_state(const std::string& _robot_name) const
+{
+  return fleet_state_cache.find(_robot_name);
+}
+
+bool Server::ServerImpl::get_robot_presence(
+    const std::string& _robot_name, RobotPresence& _presence) const
+{
+  if (!robot_presence)
+    return false;
+
+  std::lock_guard<std::mutex> lock(robot_presence_mutex);
+  return robot_presence->find(_robot_name, _presence);
+}
+
+void Server::ServerImpl::on_robot_presence(RobotPresenceCallback _callback)
+{
+  std::lock_guard<std::mutex> lock(robot_presence_mutex);
+  std::shared_ptr<std::vector<RobotPresenceCallback>> callbacks(
+      robot_presence_callbacks ?
+          new std::vector<RobotPresenceCallback>(*robot_presence_callbacks) :
+          new std::vector<RobotPresenceCallback>());
+  callbacks->push_back(std::move(_callback));
+  robot_presence_callbacks = std::move(callbacks);
+}
+
+void Server::ServerImpl::track_robot_presence()
+{
+  // The tracker finds the robots that went stale on its own, so the instance
+  // that missed its deadline is not needed.
+  fields.robot_state_sub->set_deadline_missed_callback(
+      [this](dds_instance_handle_t)
+      {
+        std::unique_lock<std::mutex> lock(robot_presence_mutex);
+        robot_presence->deadline_missed(
+            RobotPresenceTracker::Clock::now(), robot_presence_changes);
+        notify_robot_presence(lock);
+      });
+
+  const dds_entity_t reader = fields.robot_state_sub->get_reader();
+  fields.robot_state_sub->set_liveliness_changed_callback(
+      [this, reader](dds_instance_handle_t _writer, bool _alive)
+      {
+        update_robot_liveliness(reader, _writer, _alive);
+      });
+}
+
+void Server::ServerImpl::update_robot_liveliness(
+    dds_entity_t _reader, dds_instance_handle_t _writer, bool _alive)
+{
+  std::unique_lock<std::mutex> lock(robot_presence_mutex);
+  auto it = robot_state_writer_names.find(_writer);
+  if (it == robot_state_writer_names.end())
+  {
+    // Writers are always seen alive first, when they get matched
+    std::string robot_name;
+    if (!_alive ||
+        !common::dds_get_matched_user_data(_reader, _writer, robot_name))
+      return;
+    it = robot_state_writer_names.emplace(_writer, std::move(robot_name))
+        .first;
+  }
+
+  robot_presence->liveliness_changed(
+      it->second, _alive, robot_presence_changes);
+
+  // A writer that lost its liveliness was either deleted, or has its name
+  // looked up again from its user data if it comes back alive
+  if (!_alive)
+    robot_state_writer_names.erase(it);
+  notify_robot_presence(lock);
+}
+
+void Server::ServerImpl::notify_robot_presence(
+    std::unique_lock<std::mutex>& _lock)
+{
+  if (robot_presence_notifying)
+    return;
+
+  robot_presence_notifying = true;
+  std::vector<RobotPresenceTracker::Change> changes;
+  while (!robot_presence_changes.empty())
+  {
+    changes.clear();
+    changes.swap(robot_presence_changes);
+    const auto callbacks = robot_presence_callbacks;
+
+    _lock.unlock();
+    for (const auto& change : changes)
+    {
+      if (change.presence == RobotPresence::LOST)
+        forget_robot(change.robot_name);
+
+      if (!callbacks)
+        continue;
+      for (const auto& callback : *callbacks)
+        callback(change.robot_name, change.presence);
+    }
+    _lock.lock();
+  }
+  robot_presence_notifying = false;
+}
+
+std::vector<std::string> Server::ServerImpl::find_nearest_robots(
+    const std::string& _level_name, double _x, double _y, size_t _k) const
+{
+  std::vector<std::string> robot_names;
+  if (!spatial_index)
+    return robot_names;
+
+  std::lock_guard<std::mutex> lock(spatial_index_mutex);
+  spatial_index->find_nearest(
+      _level_name, static_cast<float>(_x), static_cast<float>(_y), _k,
+      robot_names);
+  return robot_names;
+}
+
+std::vector<std::string> Server::ServerImpl::find_robots_in_radius(
+    const std::string& _level_name, double _x, double _y,
+    double _radius) const
+{
+  std::vector<std::string> robot_names;
+  if (!spatial_index)
+    return robot_names;
+
+  std::lock_guard<std::mutex> lock(spatial_index_mutex);
+  spatial_index->find_in_radius(
+      _level_name, static_cast<float>(_x), static_cast<float>(_y),
+      static_cast<float>(_radius), robot_names);
+  return robot_names;
+}
+
+std::vector<std::string> Server::ServerImpl::find_robots_in_rectangle(
+    const std::string& _level_name,
+    double _min_x, double _min_y, double _max_x, double _max_y) const
+{
+  std::vector<std::string> robot_names;
+  if (!spatial_index)
+    return robot_names;
+
+  std::lock_guard<std::mutex> lock(spatial_index_mutex);
+  spatial_index->find_in_rectangle(
+      _level_name,
+      static_cast<float>(_min_x), static_cast<float>(_min_y),
+      static_cast<float>(_max_x), static_cast<float>(_max_y),
+      robot_names);
+  return robot_names;
+}
+
+void Server::ServerImpl::store_robot_states(
+    const std::vector<messages::RobotState>& _robot_states,
+    size_t _robot_state_count,
+    std::vector<std::shared_ptr<const messages::RobotState>>* _stored)
+{
+  fleet_state_cache.update(_robot_states, _robot_state_count, _stored);
+
+  if (spatial_index)
+  {
+    std::lock_guard<std::mutex> lock(spatial_index_mutex);
+    for (size_t i = 0; i < _robot_state_count; ++i)
+      spatial_index->update(_robot_states[i].name, _robot_states[i].location);
+  }
+
+  if (robot_state_expiry != std::chrono::steady_clock::duration::zero())
+    expire_robots(_robot_states, _robot_state_count);
+
+  if (robot_presence)
+  {
+    std::unique_lock<std::mutex> lock(robot_presence_mutex);
+    robot_presence->received(
+        _robot_states, _robot_state_count,
+        RobotPresenceTracker::Clock::now(), robot_presence_changes);
+    notify_robot_presence(lock);
+  }
+}
+
+void Server::ServerImpl::expire_robots(
+    const std::vector<messages::RobotState>& _robot_states,
+    size_t _robot_state_count)
+{
+  const auto now = std::chrono::steady_clock::now();
+  std::vector<std::string> expired_robot_names;
+  {
+    std::lock_guard<std::mutex> lock(robot_expiry_mutex);
+    for (size_t i = 0; i < _robot_state_count; ++i)
+      robot_update_times[_robot_states[i].name] = now;
+
+    // Checking every half expiry keeps the scan rare, while robots are still
+    // forgotten at most one and a half expiries after their last state.
+    if (now < next_robot_expiry_check)
+      return;
+    next_robot_expiry_check = now + robot_state_expiry / 2;
+
+    const auto expired_time = now - robot_state_expiry;
+    for (auto it = robot_update_times.begin(); it != robot_update_times.end();)
+    {
+      if (it->second < expired_time)
+      {
+        expired_robot_names.push_back(it->first);
+        it = robot_update_times.erase(it);
+      }
+      else
+        ++it;
+    }
+  }
+
+  for (const auto& robot_name : expired_robot_names)
+    forget_robot(robot_name);
+}
+
+void Server::ServerImpl::forget_robot(const std::string& _robot_name)
+{
+  if (spatial_index)
+  {
+    std::lock_guard<std::mutex> lock(spatial_index_mutex);
+    spatial_index->remove(_robot_name);
+  }
+
+  std::lock_guard<std::mutex> lock(keyframes_mutex);
+  keyframes.erase(_robot_name);
+}
+
+void Server::ServerImpl::register_robots(
+    const std::vector<messages::RobotState>& _robot_states,
+    size_t _robot_state_count,
+    const std::vector<dds_instance_handle_t>& _writers)
+{
+  for (size_t i = 0; i < _robot_state_count; ++i)
+    register_robot(_robot_states[i].name, _writers[i]);
+}
+
+void Server::ServerImpl::register_robot(
+    const std::string& _robot_name, dds_instance_handle_t _writer)
+{
+  if (_robot_name.empty())
+    return;
+
+  std::lock_guard<std::mutex> lock(robot_ids_mutex);
+  auto it = robot_ids.find(_robot_name);
+  if (it == robot_ids.end())
+  {
+    it = robot_ids.emplace(_robot_name, next_robot_id).first;
+    registered_robots[next_robot_id] =
+        RegisteredRobot{_robot_name, _writer, false, false};
+    if (++next_robot_id == 0)
+      next_robot_id = 1;
+  }
+
+  // A state addressed by name from another writer comes from a client that
+  // restarted, which needs to learn its robot ID again before requests are
+  // addressed by it.
+  RegisteredRobot& robot = registered_robots[it->second];
+  if (robot.writer != _writer)
+  {
+    robot.writer = _writer;
+    robot.confirmed = false;
+  }
+
+  // Registrations are kept by DDS for clients that join later, so they only
+  // need to be written again if writing them failed.
+  if (robot.published)
+    return;
+  robot.published = fields.registration_pub->write_converted(
+      messages::RobotRegistration{_robot_name, it->second});
+}
+
+uint32_t Server::ServerImpl::find_robot_id(const std::string& _robot_name)
+{
+  std::lock_guard<std::mutex> lock(robot_ids_mutex);
+  auto it = robot_ids.find(_robot_name);
+  if (it == robot_ids.end() || !registered_robots[it->second].confirmed)
+    return 0;
+  return it->second;
+}
+
+bool Server::ServerImpl::find_robot_name(
+    uint32_t _robot_id, std::string& _robot_name)
+{
+  std::lock_guard<std::mutex> lock(robot_ids_mutex);
+  auto it = registered_robots.find(_robot_id);
+  if (it == registered_robots.end())
+    return false;
+  it->second.confirmed = true;
+  _robot_name = it->second.name;
+  return true;
+}
+
+size_t Server::ServerImpl::read_registered_robot_states(
+    std::vector<messages::RobotState>& _robot_states,
+    size_t _robot_state_count)
+{
+  std::vector<std::shared_ptr<const FreeFleetData_RegisteredRobotState>>
+      samples;
+  fields.registered_robot_state_sub->take_all_loaned(samples);
+  if (samples.empty())
+    return _robot_state_count;
+
+  // States of robots with unknown IDs are dropped, these were assigned by
+  // another server, and the robot keeps announcing itself by name anyway.
+  size_t count = _robot_state_count;
+  _robot_states.resize(count + samples.size());
+  for (const auto& sample : samples)
+  {
+    if (convert_robot_state(*sample, _robot_states[count]))
+      ++count;
+  }
+  _robot_states.resize(count);
+  return count;
+}
+
+bool Server::ServerImpl::convert_robot_state(
+    const FreeFleetData_RegisteredRobotState& _sample,
+    messages::RobotState& _robot_state)
+{
+  if (!find_robot_name(_sample.robot_id, _robot_state.name))
+    return false;
+  convert(_sample, _robot_state);
+  return true;
+}
+
+Server::ServerImpl::Keyframe* Server::ServerImpl::find_keyframe(
+    const char* _name)
+{
+  if (!_name)
+    return nullptr;
+
+  keyframe_name.assign(_name);
+  auto it = keyframes.find(keyframe_name);
+  if (it == keyframes.end())
+    return nullptr;
+  return &it->second;
+}
+
+bool Server::ServerImpl::read_robot_state_deltas(
+    std::vector<messages::RobotState>& _robot_states,
+    size_t _robot_state_count)
+{
+  std::lock_guard<std::mutex> lock(keyframes_mutex);
+  ++read_generation;
+  for (size_t i = 0; i < _robot_state_count; ++i)
+  {
+    Keyframe& keyframe = keyframes[_robot_states[i].name];
+    keyframe.read_generation = read_generation;
+    keyframe.read_index = i;
+    keyframe.pending = true;
+  }
+
+  std::vector<std::shared_ptr<const FreeFleetData_RobotStateDelta>> deltas;
+  fields.robot_state_delta_sub->take_all_loaned(deltas);
+
+  // A delta replaces the state of its robot that was already returned by
+  // this read, so there is still at most one state per robot.
+  size_t count = _robot_state_count;
+  for (const auto& delta : deltas)
+  {
+    Keyframe* keyframe = find_keyframe(delta->name);
+    if (!keyframe)
+      continue;
+
+    const bool in_output = keyframe->read_generation == read_generation;
+    const size_t index = in_output ? keyframe->read_index : count;
+    if (in_output && keyframe->pending)
+    {
+      // The full state of this read is the keyframe of the delta, and is
+      // moved out of the output for the delta to replace it. It is moved
+      // back if the delta is based on an older keyframe.
+      auto full_state =
+          std::make_shared<messages::RobotState>(
+              std::move(_robot_states[index]));
+      if (!messages::apply_robot_state_delta(
+          *delta, *full_state, _robot_states[index]))
+      {
+        _robot_states[index] = std::move(*full_state);
+        continue;
+      }
+      keyframe->robot_state = std::move(full_state);
+      keyframe->pending = false;
+      continue;
+    }
+
+    if (!keyframe->robot_state)
+      continue;
+    if (_robot_states.size() <= index)
+      _robot_states.resize(index + 1);
+    if (!messages::apply_robot_state_delta(
+        *delta, *keyframe->robot_state, _robot_states[index]))
+      continue;
+
+    if (!in_output)
+    {
+      keyframe->read_generation = read_generation;
+      keyframe->read_index = index;
+      ++count;
+    }
+  }
+
+  if (count == 0)
+    return false;
+  _robot_states.resize(count);
+  return true;
+}
+
+void Server::ServerImpl::store_pending_keyframes(
+    const std::vector<messages::RobotState>& _robot_states,
+    size_t _robot_state_count,
+    const std::vector<std::shared_ptr<const messages::RobotState>>& _stored)
+{
+  std::lock_guard<std::mutex> lock(keyframes_mutex);
+  for (size_t i = 0; i < _robot_state_count; ++i)
+  {
+    // Robots may have been forgotten since the read
+    auto it = keyframes.find(_robot_states[i].name);
+    if (it == keyframes.end() || !it->second.pending)
+      continue;
+    it->second.robot_state = _stored[i];
+    it->second.pending = false;
+  }
+}
+
+bool Server::ServerImpl::wait_for_robot_states(
+    std::chrono::nanoseconds _timeout)
+{
+  if (ingest_thread.joinable())
+  {
+    std::unique_lock<std::mutex> lock(ingest_mutex);
+    return ingest_cv.wait_for(
+        lock, _timeout, [this]() { return ingested_count > 0; });
+  }
+
+  if (robot_state_listening.load())
+    return false;
+
+  return common::dds_wait(
+      fields.robot_state_waitset,
+      static_cast<dds_duration_t>(_timeout.count()));
+}
+
+void Server::ServerImpl::on_robot_state(RobotStateCallback _callback)
+{
+  bool first_callback = false;
+  {
+    std::lock_guard<std::mutex> lock(robot_state_callbacks_mutex);
+    first_callback = !robot_state_callbacks;
+    std::shared_ptr<std::vector<RobotStateCallback>> callbacks(
+        first_callback ?
+            new std::vector<RobotStateCallback>() :
+            new std::vector<RobotStateCallback>(*robot_state_callbacks));
+    callbacks->push_back(std::move(_callback));
+    robot_state_callbacks = std::move(callbacks);
+  }
+
+  // The ingest thread calls the callbacks itself, as the listeners would
+  // take the robot states away from it.
+  if (!first_callback || ingest_thread.joinable())
+    return;
+
+  robot_state_listening.store(true);
+  fields.robot_state_sub->set_data_available_callback(
+      [this]() { dispatch_robot_states(); });
+
+  if (fields.registered_robot_state_sub)
+    fields.registered_robot_state_sub->set_data_available_callback(
+        [this]() { dispatch_registered_robot_states(); });
+
+  if (fields.robot_state_delta_sub)
+    fields.robot_state_delta_sub->set_data_available_callback(
+        [this]() { dispatch_robot_state_deltas(); });
+}
+
+std::shared_ptr<const std::vector<Server::RobotStateCallback>>
+Server::ServerImpl::get_robot_state_callbacks()
+{
+  std::lock_guard<std::mutex> lock(robot_state_callbacks_mutex);
+  return robot_state_callbacks;
+}
+
+void Server::ServerImpl::dispatch_robot_states()
+{
+  // Listeners of different readers may run on different DDS threads, so
+  // every thread converts into a buffer of its own, which keeps the capacity
+  // of the states between calls without any locking.
+  thread_local std::vector<messages::RobotState> callback_robot_states;
+  thread_local std::vector<dds_instance_handle_t> writers;
+  const size_t count = fields.robot_state_sub->take_all(
+      callback_robot_states, fields.registration_pub ? &writers : nullptr);
+  if (fields.registration_pub)
+    register_robots(callback_robot_states, count, writers);
+  dispatch_robot_states(
+      callback_robot_states, count, fields.robot_state_delta_sub != nullptr);
+}
+
+void Server::ServerImpl::dispatch_registered_robot_states()
+{
+  std::vector<std::shared_ptr<const FreeFleetData_RegisteredRobotState>>
+      robot_states;
+  fields.registered_robot_state_sub->take_all_loaned(robot_states);
+
+  // Converted into a buffer of the calling thread, see dispatch_robot_states
+  thread_local std::vector<messages::RobotState> callback_robot_states;
+  if (callback_robot_states.size() < robot_states.size())
+    callback_robot_states.resize(robot_states.size());
+
+  size_t count = 0;
+  for (const auto& robot_state : robot_states)
+  {
+    if (convert_robot_state(*robot_state, callback_robot_states[count]))
+      ++count;
+  }
+  dispatch_robot_states(
+      callback_robot_states, count, fields.robot_state_delta_sub != nullptr);
+}
+
+void Server::ServerImpl::dispatch_robot_state_deltas()
+{
+  std::vector<std::shared_ptr<const FreeFleetData_RobotStateDelta>> deltas;
+  fields.robot_state_delta_sub->take_all_loaned(deltas);
+
+  // Converted into a buffer of the calling thread, see dispatch_robot_states
+  thread_local std::vector<messages::RobotState> callback_robot_states;
+  if (callback_robot_states.size() < deltas.size())
+    callback_robot_states.resize(deltas.size());
+
+  size_t count = 0;
+  {
+    std::lock_guard<std::mutex> keyframes_lock(keyframes_mutex);
+    for (const auto& delta : deltas)
+    {
+      Keyframe* keyframe = find_keyframe(delta->name);
+      if (keyframe && keyframe->robot_state &&
+          messages::apply_robot_state_delta(
+              *delta, *keyframe->robot_state, callback_robot_states[count]))
+        ++count;
+    }
+  }
+  dispatch_robot_states(callback_robot_states, count, false);
+}
+
+void Server::ServerImpl::dispatch_robot_states(
+    std::vector<messages::RobotState>& _robot_states,
+    size_t _robot_state_count,
+    bool _new_keyframes)
+{
+  // Full states are stored and kept as keyframes before they are passed on,
+  // so that their deltas can be applied as soon as they arrive. The
+  // keyframes share the states stored in the fleet state cache.
+  thread_local std::vector<std::shared_ptr<const messages::RobotState>>
+      stored;
+  store_robot_states(
+      _robot_states, _robot_state_count, _new_keyframes ? &stored : nullptr);
+  if (_new_keyframes)
+  {
+    std::lock_guard<std::mutex> keyframes_lock(keyframes_mutex);
+    for (size_t i = 0; i < _robot_state_count; ++i)
+      keyframes[_robot_states[i].name].robot_state = stored[i];
+    stored.clear();
+  }
+
+  const auto callbacks = get_robot_state_callbacks();
+  for (size_t i = 0; i < _robot_state_count; ++i)
+  {
+    for (const auto& callback : *callbacks)
+      callback(_robot_states[i]);
   }
-  return false;
 }
 
 bool Server::ServerImpl::send_mode_request(
     const messages::ModeRequest& _mode_request)
 {
-  FreeFleetData_ModeRequest* new_mr = FreeFleetData_ModeRequest__alloc();
-  convert(_mode_request, *new_mr);
-  bool sent = fields.mode_request_pub->write(new_mr);
-  FreeFleetData_ModeRequest_free(new_mr, DDS_FREE_ALL);
-  return sent;
+  return send_request(
+      *fields.mode_request_pub, messages::RequestAck::REQUEST_MODE,
+      _mode_request);
+}
+
+bool Server::ServerImpl::send_mode_request(
+    messages::ModeRequest&& _mode_request)
+{
+  return send_moved_request(
+      *fields.mode_request_pub, messages::RequestAck::REQUEST_MODE,
+      std::move(_mode_request));
 }
 
 bool Server::ServerImpl::send_path_request(
     const messages::PathRequest& _path_request)
 {
-  FreeFleetData_PathRequest* new_pr = FreeFleetData_PathRequest__alloc();
-  convert(_path_request, *new_pr);
-  bool sent = fields.path_request_pub->write(new_pr);
-  FreeFleetData_PathRequest_free(new_pr, DDS_FREE_ALL);
-  return sent;
+  return send_request(
+      *fields.path_request_pub, messages::RequestAck::REQUEST_PATH,
+      _path_request);
+}
+
+bool Server::ServerImpl::send_path_request(
+    messages::PathRequest&& _path_request)
+{
+  return send_moved_request(
+      *fields.path_request_pub, messages::RequestAck::REQUEST_PATH,
+      std::move(_path_request));
 }
 
 bool Server::ServerImpl::send_destination_request(
     const messages::DestinationRequest& _destination_request)
 {
-  FreeFleetData_DestinationRequest* new_dr = 
-      FreeFleetData_DestinationRequest__alloc();
-  convert(_destination_request, *new_dr);
-  bool sent = fields.destination_request_pub->write(new_dr);
-  FreeFleetData_DestinationRequest_free(new_dr, DDS_FREE_ALL);
-  return sent;
+  return send_request(
+      *fields.destination_request_pub,
+      messages::RequestAck::REQUEST_DESTINATION, _destination_request);
+}
+
+bool Server::ServerImpl::send_destination_request(
+    messages::DestinationRequest&& _destination_request)
+{
+  return send_moved_request(
+      *fields.destination_request_pub,
+      messages::RequestAck::REQUEST_DESTINATION,
+      std::move(_destination_request));
+}
+
+// Batches that failed stay tracked, as some of their requests may still
+// have been sent, and the rest then shows up as unacknowledged.
+
+bool Server::ServerImpl::send_mode_requests(
+    const std::vector<messages::ModeRequest>& _mode_requests)
+{
+  track_requests(
+      messages::RequestAck::REQUEST_MODE,
+      _mode_requests.data(), _mode_requests.size());
+  return publish_requests(*fields.mode_request_pub, _mode_requests);
+}
+
+bool Server::ServerImpl::send_path_requests(
+    const std::vector<messages::PathRequest>& _path_requests)
+{
+  track_requests(
+      messages::RequestAck::REQUEST_PATH,
+      _path_requests.data(), _path_requests.size());
+  return publish_requests(*fields.path_request_pub, _path_requests);
+}
+
+bool Server::ServerImpl::send_destination_requests(
+    const std::vector<messages::DestinationRequest>& _destination_requests)
+{
+  track_requests(
+      messages::RequestAck::REQUEST_DESTINATION,
+      _destination_requests.data(), _destination_requests.size());
+  return publish_requests(*fields.destination_request_pub, _destination_requests);
+}
+
+template <typename Request>
+void Server::ServerImpl::track_requests(
+    uint32_t _request_type, const Request* _requests, size_t _request_count)
+{
+  if (!request_acks)
+    return;
+
+  const auto now = RequestAckTracker::Clock::now();
+  std::lock_guard<std::mutex> lock(request_acks_mutex);
+  for (size_t i = 0; i < _request_count; ++i)
+    request_acks->sent(
+        _request_type, _requests[i].fleet_name, _requests[i].robot_name,
+        _requests[i].task_id, now);
+}
+
+template <typename Request>
+bool Server::ServerImpl::publish_requests(
+    dds::ConvertingPublishHandler<Request>& _publisher,
+    const std::vector<Request>& _requests)
+{
+  if (server_config.dds_write_batching)
+    return _publisher.publish_batch(_requests);
+
+  bool all_published = true;
+  for (const Request& request : _requests)
+    all_published = _publisher.publish(request) && all_published;
+  return all_published;
+}
+
+bool Server::ServerImpl::track_request(
+    uint32_t _request_type,
+    const std::string& _fleet_name,
+    const std::string& _robot_name,
+    const std::string& _task_id)
+{
+  const auto now = RequestAckTracker::Clock::now();
+  std::lock_guard<std::mutex> lock(request_acks_mutex);
+  return request_acks->sent(
+      _request_type, _fleet_name, _robot_name, _task_id, now);
+}
+
+void Server::ServerImpl::untrack_request(
+    uint32_t _request_type,
+    const std::string& _fleet_name,
+    const std::string& _robot_name,
+    const std::string& _task_id)
+{
+  std::lock_guard<std::mutex> lock(request_acks_mutex);
+  request_acks->unsent(_request_type, _fleet_name, _robot_name, _task_id);
+}
+
+template <typename Request>
+bool Server::ServerImpl::send_request(
+    dds::ConvertingPublishHandler<Request>& _publisher,
+    uint32_t _request_type,
+    const Request& _request)
+{
+  if (!request_acks)
+    return _publisher.publish(_request);
+
+  const bool tracked = track_request(
+      _request_type, _request.fleet_name, _request.robot_name,
+      _request.task_id);
+  if (_publisher.publish(_request))
+    return true;
+
+  // Requests that were sent before are still waiting for their earlier
+  // acknowledgement
+  if (tracked)
+    untrack_request(
+        _request_type, _request.fleet_name, _request.robot_name,
+        _request.task_id);
+  return false;
+}
+
+template <typename Request>
+bool Server::ServerImpl::send_moved_request(
+    dds::ConvertingPublishHandler<Request>& _publisher,
+    uint32_t _request_type,
+    Request&& _request)
+{
+  if (!request_acks)
+    return _publisher.publish(std::move(_request));
+
+  const std::string fleet_name = _request.fleet_name;
+  const std::string robot_name = _request.robot_name;
+  const std::string task_id = _request.task_id;
+  const bool tracked =
+      track_request(_request_type, fleet_name, robot_name, task_id);
+  if (_publisher.publish(std::move(_request)))
+    return true;
+
+  if (tracked)
+    untrack_request(_request_type, fleet_name, robot_name, task_id);
+  return false;
+}
+
+void Server::ServerImpl::receive_request_acks()
+{
+  std::vector<std::shared_ptr<const FreeFleetData_RequestAck>> samples;
+  fields.request_ack_sub->take_all_loaned(samples);
+  if (samples.empty())
+    return;
+
+  std::vector<messages::RequestAck> acks(samples.size());
+  for (size_t i = 0; i < samples.size(); ++i)
+    convert(*(samples[i]), acks[i]);
+
+  // Only the first acknowledgement of every request is passed on to the
+  // callbacks, which are called after releasing the lock, so that they can
+  // look up the latencies and the unacknowledged requests themselves.
+  std::vector<std::chrono::nanoseconds> latencies;
+  latencies.reserve(acks.size());
+  std::shared_ptr<const std::vector<RequestAckCallback>> callbacks;
+  {
+    const auto now = RequestAckTracker::Clock::now();
+    std::lock_guard<std::mutex> lock(request_acks_mutex);
+    size_t count = 0;
+    for (auto& ack : acks)
+    {
+      RequestAckTracker::Clock::duration latency;
+      if (!request_acks->acknowledged(ack, now, latency))
+        continue;
+      if (&acks[count] != &ack)
+        acks[count] = std::move(ack);
+      latencies.push_back(
+          std::chrono::duration_cast<std::chrono::nanoseconds>(latency));
+      ++count;
+    }
+    acks.resize(count);
+    callbacks = request_ack_callbacks;
+  }
+
+  if (!callbacks)
+    return;
+  for (size_t i = 0; i < acks.size(); ++i)
+  {
+    for (const auto& callback : *callbacks)
+      callback(acks[i], latencies[i]);
+  }
+}
+
+void Server::ServerImpl::on_request_ack(RequestAckCallback _callback)
+{
+  std::lock_guard<std::mutex> lock(request_acks_mutex);
+  std::shared_ptr<std::vector<RequestAckCallback>> callbacks(
+      request_ack_callbacks ?
+          new std::vector<RequestAckCallback>(*request_ack_callbacks) :
+          new std::vector<RequestAckCallback>());
+  callbacks->push_back(std::move(_callback));
+  request_ack_callbacks = std::move(callbacks);
+}
+
+Server::RequestAckLatency Server::ServerImpl::get_request_ack_latency() const
+{
+  if (!request_acks)
+    return RequestAckLatency();
+
+  std::lock_guard<std::mutex> lock(request_acks_mutex);
+  return request_acks->latency();
+}
+
+std::vector<Server::UnacknowledgedRequest>
+Server::ServerImpl::get_unacknowledged_requests(
+    std::chrono::nanoseconds _min_age) const
+{
+  std::vector<UnacknowledgedRequest> requests;
+  if (!request_acks)
+    return requests;
+
+  const auto now = RequestAckTracker::Clock::now();
+  std::lock_guard<std::mutex> lock(request_acks_mutex);
+  request_acks->unacknowledged(
+      now, std::chrono::duration_cast<RequestAckTracker::Clock::duration>(
+          _min_age),
+      requests);
+  return requests;
+}
+
+uint64_t Server::ServerImpl::get_async_dropped_count() const
+{
+  return fields.mode_request_pub->get_dropped_count() +
+      fields.path_request_pub->get_dropped_count() +
+      fields.destination_request_pub->get_dropped_count();
 }
 
 } // namespace free_fleet
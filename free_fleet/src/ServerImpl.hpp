@@ -18,6 +18,16 @@
 #ifndef FREE_FLEET__SRC__SERVERIMPL_HPP
 #define FREE_FLEET__SRC__SERVERIMPL_HPP
 
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <unordered_map>
+#include <condition_variable>
+
 #include <free_fleet/messages/RobotState.hpp>
 #include <free_fleet/messages/ModeRequest.hpp>
 #include <free_fleet/messages/PathRequest.hpp>
@@ -27,9 +37,15 @@
 
 #include <dds/dds.h>
 
+#include "SpatialIndex.hpp"
+#include "FleetStateCache.hpp"
+#include "RequestAckTracker.hpp"
+#include "RobotPresenceTracker.hpp"
 #include "messages/FleetMessages.h"
 #include "dds_utils/DDSPublishHandler.hpp"
 #include "dds_utils/DDSSubscribeHandler.hpp"
+#include "dds_utils/ConvertingPublishHandler.hpp"
+#include "dds_utils/ConvertingSubscribeHandler.hpp"
 
 namespace free_fleet {
 
@@ -43,21 +59,49 @@ public:
     /// DDS participant that is tied to the configured dds_domain_id
     dds_entity_t participant;
 
-    /// DDS subscribers for new incoming robot states from clients
-    dds::DDSSubscribeHandler<FreeFleetData_RobotState, 10>::SharedPtr 
+    /// DDS subscriber for new incoming robot states from clients, in the
+    /// configured message format
+    dds::ConvertingSubscribeHandler<messages::RobotState>::SharedPtr
         robot_state_sub;
 
-    /// DDS publisher for mode requests to be sent to clients
-    dds::DDSPublishHandler<FreeFleetData_ModeRequest>::SharedPtr
+    /// DDS publisher for mode requests to be sent to clients, which
+    /// addresses them by robot ID when robot_ids is enabled
+    dds::ConvertingPublishHandler<messages::ModeRequest>::SharedPtr
         mode_request_pub;
 
-    /// DDS publisher for path requests to be sent to clients
-    dds::DDSPublishHandler<FreeFleetData_PathRequest>::SharedPtr
+    /// DDS publisher for path requests to be sent to clients, in the
+    /// configured message format, which addresses them by robot ID when
+    /// robot_ids is enabled
+    dds::ConvertingPublishHandler<messages::PathRequest>::SharedPtr
         path_request_pub;
 
-    /// DDS publisher for destination requests to be sent to clients
-    dds::DDSPublishHandler<FreeFleetData_DestinationRequest>::SharedPtr
+    /// DDS publisher for destination requests to be sent to clients, which
+    /// addresses them by robot ID when robot_ids is enabled
+    dds::ConvertingPublishHandler<messages::DestinationRequest>::SharedPtr
         destination_request_pub;
+
+    /// DDS waitset that triggers when new robot states are available
+    dds_entity_t robot_state_waitset;
+
+    /// DDS subscriber for robot state deltas from clients, only created when
+    /// robot_state_deltas is enabled
+    dds::DDSSubscribeHandler<FreeFleetData_RobotStateDelta>::SharedPtr
+        robot_state_delta_sub;
+
+    /// DDS publisher for the robot IDs assigned to the robots, only created
+    /// when robot_ids is enabled
+    dds::DDSPublishHandler<FreeFleetData_RobotRegistration>::SharedPtr
+        registration_pub;
+
+    /// DDS subscriber for robot states addressed by robot ID, only created
+    /// when robot_ids is enabled
+    dds::DDSSubscribeHandler<FreeFleetData_RegisteredRobotState>::SharedPtr
+        registered_robot_state_sub;
+
+    /// DDS subscriber for the acknowledgements of the requests, only
+    /// created when request_acks is enabled
+    dds::DDSSubscribeHandler<FreeFleetData_RequestAck>::SharedPtr
+        request_ack_sub;
   };
 
   ServerImpl(const ServerConfig& config);
@@ -68,19 +112,339 @@ public:
 
   bool read_robot_states(std::vector<messages::RobotState>& new_robot_states);
 
+  bool wait_for_robot_states(std::chrono::nanoseconds timeout);
+
+  std::shared_ptr<const FleetSnapshot> fleet_snapshot() const;
+
+  std::shared_ptr<const messages::RobotState> get_robot_state(
+      const std::string& robot_name) const;
+
+  bool get_robot_presence(
+      const std::string& robot_name, RobotPresence& presence) const;
+
+  void on_robot_presence(RobotPresenceCallback callback);
+
+  std::vector<std::string> find_nearest_robots(
+      const std::string& level_name, double x, double y, size_t k) const;
+
+  std::vector<std::string> find_robots_in_radius(
+      const std::string& level_name, double x, double y,
+      double radius) const;
+
+  std::vector<std::string> find_robots_in_rectangle(
+      const std::string& level_name,
+      double min_x, double min_y, double max_x, double max_y) const;
+
+  void on_robot_state(RobotStateCallback callback);
+
   bool send_mode_request(const messages::ModeRequest& mode_request);
 
+  bool send_mode_request(messages::ModeRequest&& mode_request);
+
   bool send_path_request(const messages::PathRequest& path_request);
 
+  bool send_path_request(messages::PathRequest&& path_request);
+
   bool send_destination_request(
       const messages::DestinationRequest& destination_request);
 
+  bool send_destination_request(
+      messages::DestinationRequest&& destination_request);
+
+  bool send_mode_requests(
+      const std::vector<messages::ModeRequest>& mode_requests);
+
+  bool send_path_requests(
+      const std::vector<messages::PathRequest>& path_requests);
+
+  bool send_destination_requests(
+      const std::vector<messages::DestinationRequest>& destination_requests);
+
+  void on_request_ack(RequestAckCallback callback);
+
+  RequestAckLatency get_request_ack_latency() const;
+
+  std::vector<UnacknowledgedRequest> get_unacknowledged_requests(
+      std::chrono::nanoseconds min_age) const;
+
+  uint64_t get_async_dropped_count() const;
+
+  /// Robot ID that requests to the robot are addressed by, 0 when requests
+  /// to the robot are addressed by name.
+  uint32_t find_robot_id(const std::string& robot_name);
+
 private:
 
   Fields fields;
 
   ServerConfig server_config;
 
+  /// Callbacks are replaced rather than modified when one is registered, so
+  /// that they are called from a snapshot without holding the mutex, and may
+  /// register further callbacks themselves.
+  std::mutex robot_state_callbacks_mutex;
+
+  std::shared_ptr<const std::vector<RobotStateCallback>>
+      robot_state_callbacks;
+
+  std::shared_ptr<const std::vector<RobotStateCallback>>
+      get_robot_state_callbacks();
+
+  /// Set once the listeners take the robot states for the callbacks, after
+  /// which read_robot_states no longer takes from the same readers.
+  std::atomic<bool> robot_state_listening{false};
+
+  /// Latest robot state of every robot, from every read and dispatch
+  FleetStateCache fleet_state_cache;
+
+  /// Positions of the latest robot states, only created with a
+  /// spatial_index_cell_size configured
+  std::unique_ptr<SpatialIndex> spatial_index;
+
+  mutable std::mutex spatial_index_mutex;
+
+  /// Keeps the first robot_state_count robot states in the fleet state cache
+  /// and the spatial index, see FleetStateCache::update for stored.
+  void store_robot_states(
+      const std::vector<messages::RobotState>& robot_states,
+      size_t robot_state_count,
+      std::vector<std::shared_ptr<const messages::RobotState>>* stored =
+          nullptr);
+
+  /// Configured robot_state_expiry, zero when robots never expire
+  std::chrono::steady_clock::duration robot_state_expiry;
+
+  std::mutex robot_expiry_mutex;
+
+  /// Time of the latest robot state of every robot, only kept when robots
+  /// expire
+  std::unordered_map<std::string, std::chrono::steady_clock::time_point>
+      robot_update_times;
+
+  /// Time after which the update times are next checked for expired robots
+  std::chrono::steady_clock::time_point next_robot_expiry_check;
+
+  /// Updates the times of the first robot_state_count robot states, and
+  /// forgets the robots that expired.
+  void expire_robots(
+      const std::vector<messages::RobotState>& robot_states,
+      size_t robot_state_count);
+
+  /// Removes a robot that expired or was lost from the spatial index and the
+  /// keyframes, until its next robot state.
+  void forget_robot(const std::string& robot_name);
+
+  /// Presence of every robot, only created with robot_presence configured
+  std::unique_ptr<RobotPresenceTracker> robot_presence;
+
+  mutable std::mutex robot_presence_mutex;
+
+  /// Replaced rather than modified when a callback is registered, see
+  /// robot_state_callbacks
+  std::shared_ptr<const std::vector<RobotPresenceCallback>>
+      robot_presence_callbacks;
+
+  /// Changes waiting to be passed to the callbacks, in the order they
+  /// happened
+  std::vector<RobotPresenceTracker::Change> robot_presence_changes;
+
+  /// Whether a thread is currently passing changes to the callbacks
+  bool robot_presence_notifying = false;
+
+  /// Robot names of the robot state writers that are alive, from their user
+  /// data
+  std::unordered_map<dds_instance_handle_t, std::string>
+      robot_state_writer_names;
+
+  void track_robot_presence();
+
+  void update_robot_liveliness(
+      dds_entity_t reader, dds_instance_handle_t writer, bool alive);
+
+  /// Passes the pending changes to the callbacks, and is called while
+  /// holding the presence mutex. The lock is released while the callbacks
+  /// are called, so that they can call back into the server. Only one
+  /// thread calls the callbacks at a time, and it also passes on the changes
+  /// that other threads added in the meantime, so that the callbacks see
+  /// the changes in the order they happened.
+  void notify_robot_presence(std::unique_lock<std::mutex>& lock);
+
+  /// Requests waiting for their acknowledgement, only created with
+  /// request_acks configured
+  std::unique_ptr<RequestAckTracker> request_acks;
+
+  mutable std::mutex request_acks_mutex;
+
+  /// Replaced rather than modified when a callback is registered, see
+  /// robot_state_callbacks
+  std::shared_ptr<const std::vector<RequestAckCallback>>
+      request_ack_callbacks;
+
+  /// Requests are tracked before they are published, as their
+  /// acknowledgements can arrive before publishing returns.
+  template <typename Request>
+  void track_requests(
+      uint32_t request_type, const Request* requests, size_t request_count);
+
+  /// Publishes the requests as a single batch with dds_write_batching
+  /// configured, or one by one otherwise.
+  template <typename Request>
+  bool publish_requests(
+      dds::ConvertingPublishHandler<Request>& publisher,
+      const std::vector<Request>& requests);
+
+  /// \return
+  ///   True if the request was not tracked yet.
+  bool track_request(
+      uint32_t request_type,
+      const std::string& fleet_name,
+      const std::string& robot_name,
+      const std::string& task_id);
+
+  void untrack_request(
+      uint32_t request_type,
+      const std::string& fleet_name,
+      const std::string& robot_name,
+      const std::string& task_id);
+
+  /// Publishes a tracked request, which stops being tracked if it was not
+  /// tracked before and fails to be published.
+  template <typename Request>
+  bool send_request(
+      dds::ConvertingPublishHandler<Request>& publisher,
+      uint32_t request_type,
+      const Request& request);
+
+  /// Publishes a request that is moved into the queue, tracked from copies
+  /// of the names and task ID it is tracked by.
+  template <typename Request>
+  bool send_moved_request(
+      dds::ConvertingPublishHandler<Request>& publisher,
+      uint32_t request_type,
+      Request&& request);
+
+  void receive_request_acks();
+
+  /// Takes and converts robot states on its own, only used with
+  /// ingest_thread configured
+  std::thread ingest_thread;
+
+  std::atomic<bool> ingest_stopping;
+
+  std::mutex ingest_mutex;
+
+  std::condition_variable ingest_cv;
+
+  /// Latest state of every robot taken by the ingest thread since the last
+  /// read, the first ingested_count states are valid, the rest are kept for
+  /// their capacity.
+  std::vector<messages::RobotState> ingested_robot_states;
+
+  size_t ingested_count = 0;
+
+  std::unordered_map<std::string, size_t> ingested_indices;
+
+  void ingest_robot_states();
+
+  bool take_new_robot_states(
+      std::vector<messages::RobotState>& new_robot_states);
+
+  /// Last full robot state received from a robot, which its deltas are
+  /// applied to
+  struct Keyframe
+  {
+    /// Shared with the fleet state cache, or moved out of the output of the
+    /// read that also returned a delta of this robot, so that keyframes are
+    /// never copied
+    std::shared_ptr<const messages::RobotState> robot_state;
+
+    /// Read that last returned a state of this robot, and the index of that
+    /// state in the output of the read
+    uint64_t read_generation = 0;
+    size_t read_index = 0;
+
+    /// Whether the state at read_index is the full state of this robot,
+    /// which only becomes robot_state once it is stored
+    bool pending = false;
+  };
+
+  std::mutex keyframes_mutex;
+
+  std::unordered_map<std::string, Keyframe> keyframes;
+
+  uint64_t read_generation = 0;
+
+  std::string keyframe_name;
+
+  /// Robot that was assigned a robot ID. Requests are only addressed by the
+  /// ID once the robot has sent a robot state addressed by it, as the client
+  /// is then known to have received its registration.
+  struct RegisteredRobot
+  {
+    std::string name;
+
+    /// Writer of the latest robot state addressed by name
+    dds_instance_handle_t writer;
+
+    bool published;
+    bool confirmed;
+  };
+
+  std::mutex robot_ids_mutex;
+
+  std::unordered_map<std::string, uint32_t> robot_ids;
+
+  std::unordered_map<uint32_t, RegisteredRobot> registered_robots;
+
+  uint32_t next_robot_id;
+
+  void register_robots(
+      const std::vector<messages::RobotState>& robot_states,
+      size_t robot_state_count,
+      const std::vector<dds_instance_handle_t>& writers);
+
+  void register_robot(
+      const std::string& robot_name, dds_instance_handle_t writer);
+
+  bool find_robot_name(uint32_t robot_id, std::string& robot_name);
+
+  size_t read_registered_robot_states(
+      std::vector<messages::RobotState>& robot_states,
+      size_t robot_state_count);
+
+  bool convert_robot_state(
+      const FreeFleetData_RegisteredRobotState& sample,
+      messages::RobotState& robot_state);
+
+  Keyframe* find_keyframe(const char* name);
+
+  /// Applies the pending deltas after the first robot_state_count robot
+  /// states, which are full states. A delta of a robot whose full state is
+  /// part of the same read replaces that state.
+  bool read_robot_state_deltas(
+      std::vector<messages::RobotState>& robot_states,
+      size_t robot_state_count);
+
+  /// Keeps the stored full states of a read as the keyframes of their
+  /// robots, except for those that were replaced by a delta.
+  void store_pending_keyframes(
+      const std::vector<messages::RobotState>& robot_states,
+      size_t robot_state_count,
+      const std::vector<std::shared_ptr<const messages::RobotState>>& stored);
+
+  void dispatch_robot_states();
+
+  void dispatch_registered_robot_states();
+
+  void dispatch_robot_state_deltas();
+
+  /// Passes the first robot_state_count robot states to the callbacks, and
+  /// keeps them like the robot states that are read.
+  void dispatch_robot_states(
+      std::vector<messages::RobotState>& robot_states,
+      size_t robot_state_count,
+      bool new_keyframes);
+
 };
 
 } // namespace free_fleet
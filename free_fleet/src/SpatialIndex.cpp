@@ -0,0 +1,331 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <cmath>
+#include <limits>
+#include <algorithm>
+
+#include "SpatialIndex.hpp"
+
+namespace free_fleet {
+
+SpatialIndex::SpatialIndex(double _cell_size) :
+  cell_size(static_cast<float>(_cell_size))
+{}
+
+void SpatialIndex::update(
+    const std::string& _robot_name, const messages::Location& _location)
+{
+  auto it = robot_indices.find(_robot_name);
+  if (it == robot_indices.end())
+  {
+    it = robot_indices.emplace(
+        _robot_name, static_cast<uint32_t>(robots.size())).first;
+    robots.push_back(Robot{_robot_name, nullptr, 0, 0, 0});
+  }
+
+  const uint32_t robot = it->second;
+  Robot& entry = robots[robot];
+  if (entry.level)
+  {
+    // Robots mostly stay within their cell between updates, in which case
+    // only their position needs to be updated.
+    const auto level_it = levels.find(_location.level_name);
+    if (level_it != levels.end() && &level_it->second == entry.level &&
+        to_cell(_location.x) == entry.cell_x &&
+        to_cell(_location.y) == entry.cell_y)
+    {
+      Member& member = entry.level->cells[
+          cell_key(entry.cell_x, entry.cell_y)][entry.index];
+      member.x = _location.x;
+      member.y = _location.y;
+      return;
+    }
+    erase(robot);
+  }
+  insert(robot, levels[_location.level_name], _location.x, _location.y);
+}
+
+void SpatialIndex::remove(const std::string& _robot_name)
+{
+  auto it = robot_indices.find(_robot_name);
+  if (it != robot_indices.end() && robots[it->second].level)
+    erase(it->second);
+}
+
+size_t SpatialIndex::size() const
+{
+  size_t count = 0;
+  for (const Robot& robot : robots)
+  {
+    if (robot.level)
+      ++count;
+  }
+  return count;
+}
+
+void SpatialIndex::find_nearest(
+    const std::string& _level_name, float _x, float _y, size_t _k,
+    std::vector<std::string>& _robot_names) const
+{
+  _robot_names.clear();
+  const Level* level = find_level(_level_name);
+  if (!level || _k == 0)
+    return;
+
+  // Max heap of the closest robots found so far, by squared distance
+  std::vector<std::pair<float, uint32_t>> closest;
+  closest.reserve(_k + 1);
+  auto consider = [&](const Member& _member)
+  {
+    const float dx = _member.x - _x;
+    const float dy = _member.y - _y;
+    const float distance = dx * dx + dy * dy;
+    if (closest.size() == _k)
+    {
+      if (distance >= closest.front().first)
+        return;
+      std::pop_heap(closest.begin(), closest.end());
+      closest.pop_back();
+    }
+    closest.emplace_back(distance, _member.robot);
+    std::push_heap(closest.begin(), closest.end());
+  };
+
+  const int64_t center_x = to_cell(_x);
+  const int64_t center_y = to_cell(_y);
+  const int64_t max_ring = std::max(
+      std::max(center_x - level->min_cell_x, level->max_cell_x - center_x),
+      std::max(center_y - level->min_cell_y, level->max_cell_y - center_y));
+
+  auto visit_cell = [&](int64_t _cell_x, int64_t _cell_y)
+  {
+    const auto it = level->cells.find(cell_key(
+        static_cast<int32_t>(_cell_x), static_cast<int32_t>(_cell_y)));
+    if (it == level->cells.end())
+      return;
+    for (const Member& member : it->second)
+      consider(member);
+  };
+
+  // Searches rings of cells around the position, for as long as the rings
+  // searched so far cover fewer cells than are occupied.
+  const double occupied_cells = static_cast<double>(level->cells.size());
+  bool found = false;
+  for (int64_t ring = 0; ring <= max_ring; ++ring)
+  {
+    const double searched_cells =
+        static_cast<double>(2 * ring + 1) * static_cast<double>(2 * ring + 1);
+    if (ring > 0 && searched_cells > 4.0 * occupied_cells)
+      break;
+
+    if (ring == 0)
+      visit_cell(center_x, center_y);
+    for (int64_t d = -ring; ring > 0 && d <= ring; ++d)
+    {
+      visit_cell(center_x + d, center_y - ring);
+      visit_cell(center_x + d, center_y + ring);
+    }
+    for (int64_t d = -ring + 1; ring > 0 && d < ring; ++d)
+    {
+      visit_cell(center_x - ring, center_y + d);
+      visit_cell(center_x + ring, center_y + d);
+    }
+
+    // Robots in the rings further out are at least this far away
+    const float reach = static_cast<float>(ring) * cell_size;
+    if (ring == max_ring ||
+        (closest.size() == _k && closest.front().first <= reach * reach))
+    {
+      found = true;
+      break;
+    }
+  }
+
+  if (!found)
+  {
+    closest.clear();
+    for (const auto& cell : level->cells)
+    {
+      for (const Member& member : cell.second)
+        consider(member);
+    }
+  }
+
+  std::sort_heap(closest.begin(), closest.end());
+  _robot_names.reserve(closest.size());
+  for (const auto& robot : closest)
+    _robot_names.push_back(robots[robot.second].name);
+}
+
+void SpatialIndex::find_in_radius(
+    const std::string& _level_name, float _x, float _y, float _radius,
+    std::vector<std::string>& _robot_names) const
+{
+  _robot_names.clear();
+  const Level* level = find_level(_level_name);
+  if (!level || !(_radius >= 0.0f))
+    return;
+
+  const float radius_squared = _radius * _radius;
+  visit_cells(*level, _x - _radius, _y - _radius, _x + _radius, _y + _radius,
+    [&](const Member& _member)
+    {
+      const float dx = _member.x - _x;
+      const float dy = _member.y - _y;
+      if (dx * dx + dy * dy <= radius_squared)
+        _robot_names.push_back(robots[_member.robot].name);
+    });
+}
+
+void SpatialIndex::find_in_rectangle(
+    const std::string& _level_name,
+    float _min_x, float _min_y, float _max_x, float _max_y,
+    std::vector<std::string>& _robot_names) const
+{
+  _robot_names.clear();
+  const Level* level = find_level(_level_name);
+  if (!level)
+    return;
+
+  visit_cells(*level, _min_x, _min_y, _max_x, _max_y,
+    [&](const Member& _member)
+    {
+      if (_member.x >= _min_x && _member.x <= _max_x &&
+          _member.y >= _min_y && _member.y <= _max_y)
+        _robot_names.push_back(robots[_member.robot].name);
+    });
+}
+
+int32_t SpatialIndex::to_cell(float _coordinate) const
+{
+  const double cell = std::floor(
+      static_cast<double>(_coordinate) / static_cast<double>(cell_size));
+  if (!(cell > std::numeric_limits<int32_t>::min()))
+    return std::numeric_limits<int32_t>::min();
+  if (!(cell < std::numeric_limits<int32_t>::max()))
+    return std::numeric_limits<int32_t>::max();
+  return static_cast<int32_t>(cell);
+}
+
+uint64_t SpatialIndex::cell_key(int32_t _cell_x, int32_t _cell_y)
+{
+  return (static_cast<uint64_t>(static_cast<uint32_t>(_cell_x)) << 32) |
+      static_cast<uint64_t>(static_cast<uint32_t>(_cell_y));
+}
+
+const SpatialIndex::Level* SpatialIndex::find_level(
+    const std::string& _level_name) const
+{
+  const auto it = levels.find(_level_name);
+  if (it == levels.end())
+    return nullptr;
+  return &it->second;
+}
+
+void SpatialIndex::insert(uint32_t _robot, Level& _level, float _x, float _y)
+{
+  Robot& entry = robots[_robot];
+  entry.level = &_level;
+  entry.cell_x = to_cell(_x);
+  entry.cell_y = to_cell(_y);
+
+  std::vector<Member>& cell =
+      _level.cells[cell_key(entry.cell_x, entry.cell_y)];
+  entry.index = cell.size();
+  cell.push_back(Member{_robot, _x, _y});
+
+  if (_level.cells.size() == 1 && cell.size() == 1)
+  {
+    _level.min_cell_x = _level.max_cell_x = entry.cell_x;
+    _level.min_cell_y = _level.max_cell_y = entry.cell_y;
+    return;
+  }
+  _level.min_cell_x = std::min(_level.min_cell_x, entry.cell_x);
+  _level.max_cell_x = std::max(_level.max_cell_x, entry.cell_x);
+  _level.min_cell_y = std::min(_level.min_cell_y, entry.cell_y);
+  _level.max_cell_y = std::max(_level.max_cell_y, entry.cell_y);
+}
+
+void SpatialIndex::erase(uint32_t _robot)
+{
+  Robot& entry = robots[_robot];
+  auto cell_it = entry.level->cells.find(
+      cell_key(entry.cell_x, entry.cell_y));
+  std::vector<Member>& cell = cell_it->second;
+
+  // The last member of the cell takes the place of the erased one
+  if (entry.index + 1 != cell.size())
+  {
+    cell[entry.index] = cell.back();
+    robots[cell[entry.index].robot].index = entry.index;
+  }
+  cell.pop_back();
+  if (cell.empty())
+    entry.level->cells.erase(cell_it);
+  entry.level = nullptr;
+}
+
+template <typename Visitor>
+void SpatialIndex::visit_cells(
+    const Level& _level,
+    float _min_x, float _min_y, float _max_x, float _max_y,
+    Visitor&& _visitor) const
+{
+  if (!(_min_x <= _max_x && _min_y <= _max_y))
+    return;
+
+  const int64_t min_cell_x =
+      std::max<int64_t>(to_cell(_min_x), _level.min_cell_x);
+  const int64_t max_cell_x =
+      std::min<int64_t>(to_cell(_max_x), _level.max_cell_x);
+  const int64_t min_cell_y =
+      std::max<int64_t>(to_cell(_min_y), _level.min_cell_y);
+  const int64_t max_cell_y =
+      std::min<int64_t>(to_cell(_max_y), _level.max_cell_y);
+  if (min_cell_x > max_cell_x || min_cell_y > max_cell_y)
+    return;
+
+  // Large areas are cheaper to search through the occupied cells instead.
+  const double area_cells =
+      static_cast<double>(max_cell_x - min_cell_x + 1) *
+      static_cast<double>(max_cell_y - min_cell_y + 1);
+  if (area_cells > static_cast<double>(_level.cells.size()))
+  {
+    for (const auto& cell : _level.cells)
+    {
+      for (const Member& member : cell.second)
+        _visitor(member);
+    }
+    return;
+  }
+
+  for (int64_t x = min_cell_x; x <= max_cell_x; ++x)
+  {
+    for (int64_t y = min_cell_y; y <= max_cell_y; ++y)
+    {
+      const auto it = _level.cells.find(cell_key(
+          static_cast<int32_t>(x), static_cast<int32_t>(y)));
+      if (it == _level.cells.end())
+        continue;
+      for (const Member& member : it->second)
+        _visitor(member);
+    }
+  }
+}
+
+} // namespace free_fleet
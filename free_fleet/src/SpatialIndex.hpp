@@ -0,0 +1,142 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef FREE_FLEET__SRC__SPATIALINDEX_HPP
+#define FREE_FLEET__SRC__SPATIALINDEX_HPP
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <utility>
+#include <unordered_map>
+
+#include <free_fleet/messages/Location.hpp>
+
+namespace free_fleet {
+
+/// Index of robot positions, with a uniform grid over x and y for every
+/// level. Robots are moved between cells as their locations are updated, and
+/// queries only visit the cells that overlap the queried area. Empty cells
+/// are not stored, so the grid can cover any area.
+class SpatialIndex
+{
+public:
+
+  /// \param[in] cell_size
+  ///   Size of the grid cells in meters, ideally around the radius of the
+  ///   typical queries.
+  explicit SpatialIndex(double cell_size);
+
+  /// Stores the location of the robot, moving it to another cell or level
+  /// if required.
+  void update(
+      const std::string& robot_name, const messages::Location& location);
+
+  /// Removes the robot from the index.
+  void remove(const std::string& robot_name);
+
+  size_t size() const;
+
+  /// Finds up to k robots on the level that are closest to the position.
+  ///
+  /// \param[out] robot_names
+  ///   Names of the robots, ordered by increasing distance.
+  void find_nearest(
+      const std::string& level_name, float x, float y, size_t k,
+      std::vector<std::string>& robot_names) const;
+
+  /// Finds the robots on the level within the radius of the position, in no
+  /// particular order.
+  void find_in_radius(
+      const std::string& level_name, float x, float y, float radius,
+      std::vector<std::string>& robot_names) const;
+
+  /// Finds the robots on the level within the rectangle, bounds included, in
+  /// no particular order.
+  void find_in_rectangle(
+      const std::string& level_name,
+      float min_x, float min_y, float max_x, float max_y,
+      std::vector<std::string>& robot_names) const;
+
+private:
+
+  /// Position of a robot, stored in its cell
+  struct Member
+  {
+    uint32_t robot;
+    float x;
+    float y;
+  };
+
+  struct Level
+  {
+    std::unordered_map<uint64_t, std::vector<Member>> cells;
+
+    /// Bounds of the cells that were ever occupied, these are not shrunk
+    /// when robots leave.
+    int32_t min_cell_x = 0;
+    int32_t max_cell_x = 0;
+    int32_t min_cell_y = 0;
+    int32_t max_cell_y = 0;
+  };
+
+  struct Robot
+  {
+    std::string name;
+
+    /// Level and cell that the robot is stored in, the level is null once
+    /// the robot has been removed
+    Level* level;
+    int32_t cell_x;
+    int32_t cell_y;
+
+    /// Index of the robot within its cell
+    size_t index;
+  };
+
+  const float cell_size;
+
+  /// Levels are never erased, so that robots can keep pointers to them.
+  std::unordered_map<std::string, Level> levels;
+
+  std::unordered_map<std::string, uint32_t> robot_indices;
+
+  std::vector<Robot> robots;
+
+  int32_t to_cell(float coordinate) const;
+
+  static uint64_t cell_key(int32_t cell_x, int32_t cell_y);
+
+  const Level* find_level(const std::string& level_name) const;
+
+  void insert(uint32_t robot, Level& level, float x, float y);
+
+  void erase(uint32_t robot);
+
+  /// Calls the visitor with every member of the level in cells that overlap
+  /// the rectangle, which still needs to check the position of the member.
+  template <typename Visitor>
+  void visit_cells(
+      const Level& level,
+      float min_x, float min_y, float max_x, float max_y,
+      Visitor&& visitor) const;
+
+};
+
+} // namespace free_fleet
+
+#endif // FREE_FLEET__SRC__SPATIALINDEX_HPP
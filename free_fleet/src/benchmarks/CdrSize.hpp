@@ -0,0 +1,71 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef FREE_FLEET__SRC__BENCHMARKS__CDRSIZE_HPP
+#define FREE_FLEET__SRC__BENCHMARKS__CDRSIZE_HPP
+
+#include <cstddef>
+#include <cstring>
+
+namespace free_fleet {
+namespace benchmarks {
+
+/// Computes the size of a sample serialized as CDR, which is what DDS sends
+/// over the wire apart from the headers.
+class CdrSize
+{
+public:
+
+  void add(size_t _size, size_t _count = 1)
+  {
+    align(_size);
+    size += _size * _count;
+  }
+
+  void add_string(const char* _str)
+  {
+    add(4);
+    size += std::strlen(_str) + 1;
+  }
+
+  template <typename Sequence>
+  void add_sequence(const Sequence& _seq)
+  {
+    add(4);
+    if (_seq._length > 0)
+      add(sizeof(_seq._buffer[0]), _seq._length);
+  }
+
+  size_t get() const
+  {
+    return size;
+  }
+
+private:
+
+  void align(size_t _alignment)
+  {
+    size = (size + _alignment - 1) / _alignment * _alignment;
+  }
+
+  size_t size = 0;
+};
+
+} // namespace benchmarks
+} // namespace free_fleet
+
+#endif // FREE_FLEET__SRC__BENCHMARKS__CDRSIZE_HPP
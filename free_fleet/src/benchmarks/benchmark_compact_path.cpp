@@ -0,0 +1,152 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <cmath>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include <dds/dds.h>
+
+#include <free_fleet/messages/Location.hpp>
+
+#include "../messages/FleetMessages.h"
+#include "../messages/message_utils.hpp"
+
+#include "CdrSize.hpp"
+
+namespace {
+
+using free_fleet::benchmarks::CdrSize;
+
+constexpr double pi = 3.14159265358979323846;
+
+size_t serialized_size(const FreeFleetData_RobotState_path_seq& _path)
+{
+  CdrSize size;
+  size.add(4);
+  for (uint32_t i = 0; i < _path._length; ++i)
+  {
+    size.add(4, 5);
+    size.add_string(_path._buffer[i].level_name);
+  }
+  return size.get();
+}
+
+size_t serialized_size(const FreeFleetData_CompactPath& _path)
+{
+  CdrSize size;
+  size.add(4, 8);
+  size.add_sequence(_path.dt);
+  size.add_sequence(_path.dx);
+  size.add_sequence(_path.dy);
+  size.add_sequence(_path.dyaw);
+  size.add(4);
+  for (uint32_t i = 0; i < _path.level_names._length; ++i)
+    size.add_string(_path.level_names._buffer[i]);
+  size.add_sequence(_path.level_run_start);
+  size.add_sequence(_path.level_run_index);
+  return size.get();
+}
+
+/// Path along a corridor with a waypoint every 0.5 m, turning corners every
+/// 20 waypoints and crossing to another level halfway.
+std::vector<free_fleet::messages::Location> make_corridor_path(
+    size_t _length)
+{
+  std::vector<free_fleet::messages::Location> path;
+  float x = 12.5;
+  float y = -4.0;
+  float yaw = 0.0;
+  for (size_t i = 0; i < _length; ++i)
+  {
+    if (i > 0 && i % 20 == 0)
+      yaw = static_cast<float>(std::remainder(yaw + pi / 2.0, 2.0 * pi));
+    x += 0.5f * std::cos(yaw);
+    y += 0.5f * std::sin(yaw);
+    path.push_back({
+        static_cast<int32_t>(1591866000 + i / 2),
+        static_cast<uint32_t>((i % 2) * 500000000 + 1234),
+        x, y, yaw,
+        i < _length / 2 ? "building_1_level_1" : "building_1_level_2"});
+  }
+  return path;
+}
+
+} // anonymous namespace
+
+int main(int argc, char** argv)
+{
+  (void)argc;
+  (void)argv;
+
+  const int iterations = 10000;
+
+  FreeFleetData_RobotState* standard =
+      static_cast<FreeFleetData_RobotState*>(
+          dds_alloc(sizeof(FreeFleetData_RobotState)));
+  FreeFleetData_CompactRobotState* compact =
+      static_cast<FreeFleetData_CompactRobotState*>(
+          dds_alloc(sizeof(FreeFleetData_CompactRobotState)));
+
+  printf("waypoints  standard (B)  compact (B)  ratio  "
+      "encode (us)  decode (us)  max error (m)\n");
+  for (size_t path_length : {10, 50, 100, 200, 500})
+  {
+    const auto path = make_corridor_path(path_length);
+    free_fleet::messages::RobotState state;
+    state.path = path;
+
+    free_fleet::messages::convert(state, *standard);
+    free_fleet::messages::convert(state, *compact);
+    const size_t standard_size = serialized_size(standard->path);
+    const size_t compact_size = serialized_size(compact->path);
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i)
+      free_fleet::messages::convert(state, *compact);
+    auto end = std::chrono::steady_clock::now();
+    const double encode_us =
+        std::chrono::duration<double, std::micro>(end - start).count() /
+        iterations;
+
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i)
+      free_fleet::messages::convert(*compact, state);
+    end = std::chrono::steady_clock::now();
+    const double decode_us =
+        std::chrono::duration<double, std::micro>(end - start).count() /
+        iterations;
+
+    double max_error = 0.0;
+    for (size_t i = 0; i < path_length; ++i)
+      max_error = std::max(max_error, std::hypot(
+          static_cast<double>(state.path[i].x) - path[i].x,
+          static_cast<double>(state.path[i].y) - path[i].y));
+
+    printf("%9zu  %12zu  %11zu  %5.1f  %11.3f  %11.3f  %13.5f\n",
+        path_length, standard_size, compact_size,
+        static_cast<double>(standard_size) / compact_size,
+        encode_us, decode_us, max_error);
+  }
+
+  dds_sample_free(standard, &FreeFleetData_RobotState_desc, DDS_FREE_ALL);
+  dds_sample_free(
+      compact, &FreeFleetData_CompactRobotState_desc, DDS_FREE_ALL);
+  return 0;
+}
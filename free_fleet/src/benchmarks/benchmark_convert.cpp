@@ -0,0 +1,115 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <new>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+
+#include <dds/dds.h>
+
+#include <free_fleet/messages/RobotState.hpp>
+
+#include "../messages/FleetMessages.h"
+#include "../messages/message_utils.hpp"
+
+namespace {
+
+uint64_t new_count = 0;
+
+} // namespace
+
+void* operator new(std::size_t _size)
+{
+  ++new_count;
+  if (void* ptr = std::malloc(_size ? _size : 1))
+    return ptr;
+  throw std::bad_alloc();
+}
+
+void operator delete(void* _ptr) noexcept
+{
+  std::free(_ptr);
+}
+
+void operator delete(void* _ptr, std::size_t) noexcept
+{
+  std::free(_ptr);
+}
+
+int main(int argc, char** argv)
+{
+  (void)argc;
+  (void)argv;
+
+  const size_t path_length = 50;
+  const int iterations = 100000;
+
+  free_fleet::messages::RobotState state;
+  state.name = "magni_with_a_long_robot_name";
+  state.model = "magni_model_with_a_long_name";
+  state.task_id = "task_id_with_a_long_description";
+  state.mode.mode = free_fleet::messages::RobotMode::MODE_MOVING;
+  state.battery_percent = 100.0;
+  state.location = {0, 0, 1.0, 2.0, 0.5, "level_with_a_long_name"};
+  for (size_t i = 0; i < path_length; ++i)
+    state.path.push_back(
+        {0, 0, static_cast<float>(i), 2.0, 0.5, "level_with_a_long_name"});
+
+  FreeFleetData_RobotState* dds_state =
+      static_cast<FreeFleetData_RobotState*>(
+          dds_alloc(sizeof(FreeFleetData_RobotState)));
+  free_fleet::messages::RobotState converted_state;
+
+  // Warm up, this is where the output buffers get allocated
+  free_fleet::messages::convert(state, *dds_state);
+  free_fleet::messages::convert(*dds_state, converted_state);
+
+  const void* dds_path_buffer = dds_state->path._buffer;
+  const void* dds_name_buffer = dds_state->name;
+
+  const uint64_t new_count_before = new_count;
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < iterations; ++i)
+  {
+    state.location.x = static_cast<float>(i);
+    free_fleet::messages::convert(state, *dds_state);
+    free_fleet::messages::convert(*dds_state, converted_state);
+  }
+  auto end = std::chrono::steady_clock::now();
+  const uint64_t steady_state_new_count = new_count - new_count_before;
+
+  const bool dds_buffers_reused =
+      dds_state->path._buffer == dds_path_buffer &&
+      dds_state->name == dds_name_buffer;
+
+  const double total_us =
+      std::chrono::duration<double, std::micro>(end - start).count();
+  printf("round trip conversions: %d, path length: %zu\n",
+      iterations, path_length);
+  printf("average round trip: %.3f us\n", total_us / iterations);
+  printf("steady state operator new calls: %llu\n",
+      static_cast<unsigned long long>(steady_state_new_count));
+  printf("DDS buffers reused: %s\n", dds_buffers_reused ? "yes" : "no");
+
+  dds_sample_free(dds_state, &FreeFleetData_RobotState_desc, DDS_FREE_ALL);
+
+  if (steady_state_new_count != 0 || !dds_buffers_reused)
+    return 1;
+  return 0;
+}
@@ -0,0 +1,119 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <vector>
+#include <cstring>
+#include <cstddef>
+
+#include <dds/dds.h>
+
+#include <free_fleet/messages/RobotState.hpp>
+
+#include "../messages/FleetMessages.h"
+#include "../messages/message_utils.hpp"
+
+namespace {
+
+const int iterations = 100000;
+
+template <typename Function>
+double average_us(Function _function)
+{
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < iterations; ++i)
+    _function(i);
+  auto end = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::micro>(end - start).count() /
+      iterations;
+}
+
+} // anonymous namespace
+
+int main(int argc, char** argv)
+{
+  (void)argc;
+  (void)argv;
+
+  const size_t path_length = 20;
+  const size_t fleet_size = 500;
+
+  free_fleet::messages::RobotState state;
+  state.name = "magni_12";
+  state.model = "magni";
+  state.task_id = "delivery_1234";
+  state.mode.mode = free_fleet::messages::RobotMode::MODE_MOVING;
+  state.battery_percent = 100.0;
+  state.location = {0, 0, 1.0, 2.0, 0.5, "L1"};
+  for (size_t i = 0; i < path_length; ++i)
+    state.path.push_back({0, 0, static_cast<float>(i), 2.0, 0.5, "L1"});
+
+  FreeFleetData_RobotState* standard_sample =
+      static_cast<FreeFleetData_RobotState*>(
+          dds_alloc(sizeof(FreeFleetData_RobotState)));
+  FreeFleetData_FlatRobotState* flat_sample =
+      static_cast<FreeFleetData_FlatRobotState*>(
+          dds_alloc(sizeof(FreeFleetData_FlatRobotState)));
+
+  // Writing side, converting into a reused sample before every write
+  const double standard_write_us = average_us([&](int i)
+  {
+    state.location.x = static_cast<float>(i);
+    free_fleet::messages::convert(state, *standard_sample);
+  });
+  const double flat_write_us = average_us([&](int i)
+  {
+    state.location.x = static_cast<float>(i);
+    free_fleet::messages::convert(state, *flat_sample);
+  });
+
+  // Reading side, keeping the newest state of every robot of the fleet.
+  // Standard samples point into DDS owned buffers, so they have to be
+  // converted to be kept, while flat samples can be copied as they are.
+  std::vector<free_fleet::messages::RobotState> standard_states(fleet_size);
+  std::vector<FreeFleetData_FlatRobotState> flat_states(fleet_size);
+  const double standard_keep_us = average_us([&](int i)
+  {
+    free_fleet::messages::convert(
+        *standard_sample, standard_states[i % fleet_size]);
+  });
+  const size_t flat_used_size =
+      offsetof(FreeFleetData_FlatRobotState, path) +
+      flat_sample->path_length * sizeof(FreeFleetData_FlatLocation);
+  const double flat_keep_us = average_us([&](int i)
+  {
+    std::memcpy(&flat_states[i % fleet_size], flat_sample, flat_used_size);
+  });
+
+  printf("robot state with a path of %zu waypoints, %d iterations\n",
+      path_length, iterations);
+  printf("                          standard      flat\n");
+  printf("sample size (bytes)     %10zu %10zu\n",
+      sizeof(FreeFleetData_RobotState), sizeof(FreeFleetData_FlatRobotState));
+  printf("heap buffers per sample %10zu %10d\n", 5 + path_length, 0);
+  printf("convert for writing (us) %9.3f %10.3f\n",
+      standard_write_us, flat_write_us);
+  printf("keep received (us)      %10.3f %10.3f\n",
+      standard_keep_us, flat_keep_us);
+
+  dds_sample_free(
+      standard_sample, &FreeFleetData_RobotState_desc, DDS_FREE_ALL);
+  dds_sample_free(
+      flat_sample, &FreeFleetData_FlatRobotState_desc, DDS_FREE_ALL);
+  return 0;
+}
@@ -0,0 +1,159 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+#include <unordered_map>
+
+#include <free_fleet/messages/RobotState.hpp>
+
+#include "../FleetStateCache.hpp"
+
+namespace {
+
+using free_fleet::FleetStateCache;
+using free_fleet::messages::RobotState;
+
+std::vector<RobotState> make_fleet(size_t _robot_count, size_t _path_length)
+{
+  std::vector<RobotState> fleet(_robot_count);
+  for (size_t r = 0; r < _robot_count; ++r)
+  {
+    RobotState& state = fleet[r];
+    state.name = "magni_with_a_long_robot_name_" + std::to_string(r);
+    state.model = "magni_model_with_a_long_name";
+    state.task_id = "task_id_with_a_long_description";
+    state.mode.mode = free_fleet::messages::RobotMode::MODE_MOVING;
+    state.location = {0, 0, 1.0, 2.0, 0.5, "level_with_a_long_name"};
+    for (size_t i = 0; i < _path_length; ++i)
+      state.path.push_back(
+          {0, 0, static_cast<float>(i), 2.0, 0.5, "level_with_a_long_name"});
+  }
+  return fleet;
+}
+
+/// Keeps updating the whole fleet while the readers run, and returns the
+/// millions of reads per second over all the reader threads.
+template <typename Update, typename Read>
+double run_readers(
+    int _readers, int _iterations, std::vector<RobotState>& _fleet,
+    Update _update, Read _read)
+{
+  std::atomic<bool> stop(false);
+  std::thread writer([&]()
+  {
+    float generation = 0.0;
+    while (!stop.load())
+    {
+      generation += 1.0;
+      for (auto& state : _fleet)
+        state.battery_percent = generation;
+      _update(_fleet);
+    }
+  });
+
+  std::vector<std::thread> threads;
+  auto start = std::chrono::steady_clock::now();
+  for (int t = 0; t < _readers; ++t)
+    threads.emplace_back([&, t]()
+    {
+      for (int i = 0; i < _iterations; ++i)
+        _read(_fleet[(i + t) % _fleet.size()].name, i);
+    });
+  for (auto& thread : threads)
+    thread.join();
+  auto end = std::chrono::steady_clock::now();
+
+  stop.store(true);
+  writer.join();
+  return _readers * _iterations /
+      std::chrono::duration<double, std::micro>(end - start).count();
+}
+
+} // anonymous namespace
+
+int main(int argc, char** argv)
+{
+  (void)argc;
+  (void)argv;
+
+  const int iterations = 200000;
+  std::vector<RobotState> fleet = make_fleet(100, 20);
+
+  // What every consumer builds today from the output of read_robot_states,
+  // a map of the robot states behind a mutex, copying states out of it
+  std::unordered_map<std::string, RobotState> locked_fleet;
+  std::mutex locked_fleet_mutex;
+
+  FleetStateCache cache;
+  std::atomic<bool> consistent(true);
+
+  printf("readers  locked map (M/s)  cache (M/s)\n");
+  for (int readers : {1, 2, 4, 8})
+  {
+    const double locked_rate = run_readers(readers, iterations, fleet,
+      [&](const std::vector<RobotState>& _states)
+      {
+        std::lock_guard<std::mutex> lock(locked_fleet_mutex);
+        for (const auto& state : _states)
+          locked_fleet[state.name] = state;
+      },
+      [&](const std::string& _name, int)
+      {
+        RobotState state;
+        {
+          std::lock_guard<std::mutex> lock(locked_fleet_mutex);
+          auto it = locked_fleet.find(_name);
+          if (it != locked_fleet.end())
+            state = it->second;
+        }
+      });
+
+    const double cache_rate = run_readers(readers, iterations, fleet,
+      [&](const std::vector<RobotState>& _states)
+      {
+        cache.update(_states, _states.size());
+      },
+      [&](const std::string& _name, int _iteration)
+      {
+        auto snapshot = cache.snapshot();
+        auto it = snapshot->find(_name);
+        (void)it;
+
+        // Every update stores the whole fleet at once, so all the states
+        // within a snapshot come from the same update
+        if (_iteration % 64 != 0 || snapshot->empty())
+          return;
+        const float battery =
+            snapshot->begin()->second->battery_percent;
+        for (const auto& robot : *snapshot)
+        {
+          if (robot.second->battery_percent != battery)
+            consistent.store(false);
+        }
+      });
+
+    printf("%7d  %16.2f  %11.2f\n", readers, locked_rate, cache_rate);
+  }
+
+  printf("snapshots consistent: %s\n", consistent.load() ? "yes" : "no");
+  return consistent.load() ? 0 : 1;
+}
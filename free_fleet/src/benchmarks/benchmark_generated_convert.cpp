@@ -0,0 +1,258 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+
+#include <dds/dds.h>
+
+#include <free_fleet/messages/RobotState.hpp>
+#include <free_fleet/messages/ModeRequest.hpp>
+#include <free_fleet/messages/PathRequest.hpp>
+
+#include "../dds_utils/common.hpp"
+#include "../messages/FleetMessages.h"
+#include "../messages/message_utils.hpp"
+
+namespace {
+
+using namespace free_fleet::messages;
+using free_fleet::common::dds_string_assign;
+using free_fleet::common::dds_sequence_resize;
+
+// Hand-written conversions, as they were before being generated from the
+// field tables, used as the reference for the generated conversions.
+namespace handwritten {
+
+void convert(const Location& _input, FreeFleetData_Location& _output)
+{
+  _output.sec = _input.sec;
+  _output.nanosec = _input.nanosec;
+  _output.x = _input.x;
+  _output.y = _input.y;
+  _output.yaw = _input.yaw;
+  dds_string_assign(_output.level_name, _input.level_name);
+}
+
+void convert(const FreeFleetData_Location& _input, Location& _output)
+{
+  _output.sec = _input.sec;
+  _output.nanosec = _input.nanosec;
+  _output.x = _input.x;
+  _output.y = _input.y;
+  _output.yaw = _input.yaw;
+  _output.level_name.assign(_input.level_name);
+}
+
+void convert(const RobotState& _input, FreeFleetData_RobotState& _output)
+{
+  dds_string_assign(_output.name, _input.name);
+  dds_string_assign(_output.model, _input.model);
+  dds_string_assign(_output.task_id, _input.task_id);
+  _output.mode.mode = _input.mode.mode;
+  _output.battery_percent = _input.battery_percent;
+  handwritten::convert(_input.location, _output.location);
+
+  size_t path_length = _input.path.size();
+  dds_sequence_resize(_output.path, path_length);
+  for (size_t i = 0; i < path_length; ++i)
+    handwritten::convert(_input.path[i], _output.path._buffer[i]);
+}
+
+void convert(const FreeFleetData_RobotState& _input, RobotState& _output)
+{
+  _output.name.assign(_input.name);
+  _output.model.assign(_input.model);
+  _output.task_id.assign(_input.task_id);
+  _output.mode.mode = _input.mode.mode;
+  _output.battery_percent = _input.battery_percent;
+  handwritten::convert(_input.location, _output.location);
+
+  _output.path.resize(_input.path._length);
+  for (uint32_t i = 0; i < _input.path._length; ++i)
+    handwritten::convert(_input.path._buffer[i], _output.path[i]);
+}
+
+void convert(const ModeRequest& _input, FreeFleetData_ModeRequest& _output)
+{
+  dds_string_assign(_output.fleet_name, _input.fleet_name);
+  dds_string_assign(_output.robot_name, _input.robot_name);
+  _output.mode.mode = _input.mode.mode;
+  dds_string_assign(_output.task_id, _input.task_id);
+
+  size_t mode_parameter_num = _input.parameters.size();
+  dds_sequence_resize(_output.parameters, mode_parameter_num);
+  for (size_t i = 0; i < mode_parameter_num; ++i)
+  {
+    dds_string_assign(
+        _output.parameters._buffer[i].name, _input.parameters[i].name);
+    dds_string_assign(
+        _output.parameters._buffer[i].value, _input.parameters[i].value);
+  }
+}
+
+void convert(const FreeFleetData_ModeRequest& _input, ModeRequest& _output)
+{
+  _output.fleet_name.assign(_input.fleet_name);
+  _output.robot_name.assign(_input.robot_name);
+  _output.mode.mode = _input.mode.mode;
+  _output.task_id.assign(_input.task_id);
+
+  _output.parameters.resize(_input.parameters._length);
+  for (uint32_t i = 0; i < _input.parameters._length; ++i)
+  {
+    _output.parameters[i].name.assign(_input.parameters._buffer[i].name);
+    _output.parameters[i].value.assign(_input.parameters._buffer[i].value);
+  }
+}
+
+} // namespace handwritten
+
+template <typename Message>
+bool same_message(const Message& _a, const Message& _b);
+
+template <>
+bool same_message(const RobotState& _a, const RobotState& _b)
+{
+  return _a.name == _b.name && _a.model == _b.model &&
+      _a.task_id == _b.task_id && _a.mode.mode == _b.mode.mode &&
+      _a.battery_percent == _b.battery_percent &&
+      same_location(_a.location, _b.location) && same_path(_a.path, _b.path);
+}
+
+template <>
+bool same_message(const ModeRequest& _a, const ModeRequest& _b)
+{
+  if (_a.fleet_name != _b.fleet_name || _a.robot_name != _b.robot_name ||
+      _a.mode.mode != _b.mode.mode || _a.task_id != _b.task_id ||
+      _a.parameters.size() != _b.parameters.size())
+    return false;
+  for (size_t i = 0; i < _a.parameters.size(); ++i)
+  {
+    if (_a.parameters[i].name != _b.parameters[i].name ||
+        _a.parameters[i].value != _b.parameters[i].value)
+      return false;
+  }
+  return true;
+}
+
+/// Average duration of a round trip conversion in microseconds.
+template <typename Message, typename DdsMessage, typename Function>
+double time_round_trips(
+    const Message& _input, DdsMessage& _dds_output, Message& _output,
+    int _iterations, Function _round_trip)
+{
+  // Warm up, this is where the output buffers get allocated
+  _round_trip(_input, _dds_output, _output);
+
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < _iterations; ++i)
+    _round_trip(_input, _dds_output, _output);
+  auto end = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::micro>(end - start).count() /
+      _iterations;
+}
+
+/// Runs both the hand-written and the generated conversions on the message,
+/// returns false if they do not convert the message back to itself.
+template <typename Message, typename DdsMessage>
+bool compare(
+    const char* _name, const Message& _input,
+    const dds_topic_descriptor_t& _descriptor, int _iterations)
+{
+  DdsMessage* dds_message =
+      static_cast<DdsMessage*>(dds_alloc(sizeof(DdsMessage)));
+  Message handwritten_output;
+  Message generated_output;
+
+  const double handwritten_us = time_round_trips(
+      _input, *dds_message, handwritten_output, _iterations,
+      [](const Message& _in, DdsMessage& _dds, Message& _out)
+      {
+        handwritten::convert(_in, _dds);
+        handwritten::convert(_dds, _out);
+      });
+  const double generated_us = time_round_trips(
+      _input, *dds_message, generated_output, _iterations,
+      [](const Message& _in, DdsMessage& _dds, Message& _out)
+      {
+        convert(_in, _dds);
+        convert(_dds, _out);
+      });
+
+  const bool correct =
+      same_message(_input, handwritten_output) &&
+      same_message(_input, generated_output);
+  printf("%-22s  %16.3f  %14.3f  %7.2f  %s\n",
+      _name, handwritten_us, generated_us, handwritten_us / generated_us,
+      correct ? "yes" : "no");
+
+  dds_sample_free(dds_message, &_descriptor, DDS_FREE_ALL);
+  return correct;
+}
+
+RobotState make_robot_state(size_t _path_length)
+{
+  RobotState state;
+  state.name = "magni_with_a_long_robot_name";
+  state.model = "magni_model_with_a_long_name";
+  state.task_id = "task_id_with_a_long_description";
+  state.mode.mode = RobotMode::MODE_MOVING;
+  state.battery_percent = 87.5;
+  state.location = {1591866000, 1234, 1.0, 2.0, 0.5, "level_with_a_long_name"};
+  for (size_t i = 0; i < _path_length; ++i)
+    state.path.push_back({
+        static_cast<int32_t>(1591866000 + i), 1234,
+        static_cast<float>(i), 2.0, 0.5, "level_with_a_long_name"});
+  return state;
+}
+
+} // anonymous namespace
+
+int main(int argc, char** argv)
+{
+  (void)argc;
+  (void)argv;
+
+  const int iterations = 100000;
+
+  ModeRequest mode_request;
+  mode_request.fleet_name = "fleet_with_a_long_name";
+  mode_request.robot_name = "magni_with_a_long_robot_name";
+  mode_request.mode.mode = RobotMode::MODE_DOCKING;
+  mode_request.task_id = "task_id_with_a_long_description";
+  for (int i = 0; i < 4; ++i)
+    mode_request.parameters.push_back(
+        {"parameter_" + std::to_string(i), "value_" + std::to_string(i)});
+
+  printf("round trip             handwritten (us)  generated (us)  speedup"
+      "  correct\n");
+  bool correct = compare<ModeRequest, FreeFleetData_ModeRequest>(
+      "mode request", mode_request, FreeFleetData_ModeRequest_desc,
+      iterations);
+  for (size_t path_length : {0, 10, 50, 200})
+  {
+    const std::string name =
+        "robot state, " + std::to_string(path_length) + " wp";
+    correct = compare<RobotState, FreeFleetData_RobotState>(
+        name.c_str(), make_robot_state(path_length),
+        FreeFleetData_RobotState_desc, iterations) && correct;
+  }
+
+  return correct ? 0 : 1;
+}
@@ -0,0 +1,378 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <cmath>
+#include <deque>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+
+#include <dds/dds.h>
+
+#include <free_fleet/messages/Location.hpp>
+#include <free_fleet/messages/PathRequest.hpp>
+
+#include "../messages/FleetMessages.h"
+#include "../messages/message_utils.hpp"
+#include "../messages/PathCompressor.hpp"
+
+#include "CdrSize.hpp"
+
+namespace {
+
+using free_fleet::benchmarks::CdrSize;
+using free_fleet::messages::Location;
+
+/// Occupancy grid of a level, loaded from a map_server map.
+struct Level
+{
+  std::string name;
+  double resolution = 0.05;
+  double origin_x = 0.0;
+  double origin_y = 0.0;
+  int width = 0;
+  int height = 0;
+  std::vector<bool> free;
+  std::vector<int> free_cells;
+};
+
+/// Reads the next token of a PGM header, skipping comments.
+std::string read_pgm_token(std::istream& _stream)
+{
+  std::string token;
+  while (_stream >> token)
+  {
+    if (token[0] != '#')
+      return token;
+    std::getline(_stream, token);
+  }
+  return "";
+}
+
+bool load_level(const std::string& _yaml_path, Level& _level)
+{
+  std::ifstream yaml(_yaml_path);
+  if (!yaml)
+    return false;
+
+  std::string image;
+  bool negate = false;
+  double free_thresh = 0.196;
+  std::string line;
+  while (std::getline(yaml, line))
+  {
+    const size_t colon = line.find(':');
+    if (colon == std::string::npos)
+      continue;
+    const std::string key = line.substr(0, colon);
+    std::string value = line.substr(colon + 1);
+    value.erase(0, value.find_first_not_of(" \t"));
+
+    if (key == "image")
+      image = value;
+    else if (key == "resolution")
+      _level.resolution = std::stod(value);
+    else if (key == "negate")
+      negate = std::stoi(value) != 0;
+    else if (key == "free_thresh")
+      free_thresh = std::stod(value);
+    else if (key == "origin")
+    {
+      std::replace(value.begin(), value.end(), '[', ' ');
+      std::replace(value.begin(), value.end(), ',', ' ');
+      std::istringstream origin(value);
+      origin >> _level.origin_x >> _level.origin_y;
+    }
+  }
+
+  const size_t slash = _yaml_path.find_last_of('/');
+  const std::string directory =
+      slash == std::string::npos ? "" : _yaml_path.substr(0, slash + 1);
+  const std::string stem = _yaml_path.substr(
+      directory.size(), _yaml_path.find_last_of('.') - directory.size());
+  _level.name = stem;
+
+  std::ifstream pgm(directory + image, std::ios::binary);
+  if (!pgm || read_pgm_token(pgm) != "P5")
+    return false;
+  _level.width = std::stoi(read_pgm_token(pgm));
+  _level.height = std::stoi(read_pgm_token(pgm));
+  const double max_value = std::stod(read_pgm_token(pgm));
+  pgm.get();
+
+  std::vector<unsigned char> pixels(
+      static_cast<size_t>(_level.width * _level.height));
+  pgm.read(reinterpret_cast<char*>(pixels.data()),
+      static_cast<std::streamsize>(pixels.size()));
+  if (!pgm)
+    return false;
+
+  // Same thresholds as map_server, with unknown cells being occupied
+  _level.free.resize(pixels.size());
+  for (size_t i = 0; i < pixels.size(); ++i)
+  {
+    const double p = pixels[i] / max_value;
+    const double occupancy = negate ? p : 1.0 - p;
+    _level.free[i] = occupancy < free_thresh;
+    if (_level.free[i])
+      _level.free_cells.push_back(static_cast<int>(i));
+  }
+  return !_level.free_cells.empty();
+}
+
+/// Shortest 8-connected path between two free cells of the level.
+std::vector<int> find_cell_path(const Level& _level, int _start, int _goal)
+{
+  std::vector<int> parent(_level.free.size(), -1);
+  std::deque<int> queue = {_start};
+  parent[_start] = _start;
+  while (!queue.empty() && parent[_goal] < 0)
+  {
+    const int cell = queue.front();
+    queue.pop_front();
+    const int cx = cell % _level.width;
+    const int cy = cell / _level.width;
+    for (int dy = -1; dy <= 1; ++dy)
+    {
+      for (int dx = -1; dx <= 1; ++dx)
+      {
+        const int nx = cx + dx;
+        const int ny = cy + dy;
+        if (nx < 0 || ny < 0 || nx >= _level.width || ny >= _level.height)
+          continue;
+        const int next = ny * _level.width + nx;
+        if (!_level.free[next] || parent[next] >= 0)
+          continue;
+        parent[next] = cell;
+        queue.push_back(next);
+      }
+    }
+  }
+
+  std::vector<int> cells;
+  if (parent[_goal] < 0)
+    return cells;
+  for (int cell = _goal; cell != _start; cell = parent[cell])
+    cells.push_back(cell);
+  cells.push_back(_start);
+  std::reverse(cells.begin(), cells.end());
+  return cells;
+}
+
+/// Route across the levels, with one leg between random free cells on each
+/// level in turn, and a waypoint every 0.25 m driven at 0.5 m/s.
+std::vector<Location> make_route(
+    const std::vector<Level>& _levels, size_t _legs, std::mt19937& _rng)
+{
+  const double spacing = 0.25;
+  const double speed = 0.5;
+
+  std::vector<Location> route;
+  double time = 1591866000.0;
+  for (size_t leg = 0; leg < _legs; ++leg)
+  {
+    const Level& level = _levels[leg % _levels.size()];
+    std::uniform_int_distribution<size_t> pick(
+        0, level.free_cells.size() - 1);
+
+    std::vector<int> cells;
+    while (cells.size() < 2)
+      cells = find_cell_path(
+          level,
+          level.free_cells[pick(_rng)],
+          level.free_cells[pick(_rng)]);
+
+    const size_t step = std::max<size_t>(
+        1, static_cast<size_t>(std::lround(spacing / level.resolution)));
+    for (size_t i = 0; i < cells.size(); i += step)
+    {
+      const size_t next = std::min(i + step, cells.size() - 1);
+      const int cx = cells[i] % level.width;
+      const int cy = cells[i] / level.width;
+      const int nx = cells[next] % level.width;
+      const int ny = cells[next] / level.width;
+
+      Location location;
+      location.sec = static_cast<int32_t>(time);
+      location.nanosec =
+          static_cast<uint32_t>((time - std::floor(time)) * 1e9);
+      location.x = static_cast<float>(
+          level.origin_x + (cx + 0.5) * level.resolution);
+      location.y = static_cast<float>(
+          level.origin_y + (level.height - cy - 0.5) * level.resolution);
+      location.yaw = static_cast<float>(std::atan2(cy - ny, nx - cx));
+      location.level_name = level.name;
+      route.push_back(location);
+      time += spacing / speed;
+    }
+  }
+  return route;
+}
+
+size_t serialized_size(const FreeFleetData_PathRequest& _request)
+{
+  CdrSize size;
+  size.add(4);
+  for (uint32_t i = 0; i < _request.path._length; ++i)
+  {
+    size.add(4, 5);
+    size.add_string(_request.path._buffer[i].level_name);
+  }
+  return size.get();
+}
+
+size_t serialized_size(const FreeFleetData_CompressedPathRequest& _request)
+{
+  CdrSize size;
+  size.add(4);
+  for (uint32_t i = 0; i < _request.path._length; ++i)
+  {
+    size.add(4, 5);
+    size.add_string(_request.path._buffer[i].level_name);
+  }
+  size.add(4, 2);
+  size.add_sequence(_request.compressed_path.data);
+  return size.get();
+}
+
+template <typename Function>
+double time_us(int _iterations, Function&& _function)
+{
+  const auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < _iterations; ++i)
+    _function();
+  const auto end = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::micro>(end - start).count() /
+      _iterations;
+}
+
+} // anonymous namespace
+
+int main(int argc, char** argv)
+{
+  if (argc < 2)
+  {
+    printf("usage: %s <map.yaml> [<map.yaml> ...]\n", argv[0]);
+    printf("  each map_server map is used as one level, for example the "
+        "maps of ff_examples_ros1/maps\n");
+    return 1;
+  }
+
+  if (!free_fleet::messages::path_compression_available())
+  {
+    printf("free fleet was built without LZ4\n");
+    return 1;
+  }
+
+  std::vector<Level> levels;
+  for (int i = 1; i < argc; ++i)
+  {
+    Level level;
+    if (!load_level(argv[i], level))
+    {
+      printf("failed to load map %s\n", argv[i]);
+      return 1;
+    }
+    levels.push_back(std::move(level));
+  }
+
+  const size_t routes_per_length = 50;
+  const int iterations = 200;
+
+  // Typical payload of a single UDP datagram before IP fragmentation
+  const size_t fragment_size = 1400;
+
+  std::mt19937 rng(42);
+  free_fleet::messages::PathCompressor compressor(0);
+  FreeFleetData_PathRequest* standard =
+      static_cast<FreeFleetData_PathRequest*>(
+          dds_alloc(sizeof(FreeFleetData_PathRequest)));
+  FreeFleetData_CompressedPathRequest* compressed =
+      static_cast<FreeFleetData_CompressedPathRequest*>(
+          dds_alloc(sizeof(FreeFleetData_CompressedPathRequest)));
+  free_fleet::messages::PathRequest decoded;
+
+  printf("legs  waypoints  standard (B)  compressed (B)  ratio  "
+      "compress (us)  decompress (us)  standard > %zu B  compressed > %zu B\n",
+      fragment_size, fragment_size);
+  for (size_t legs : {1, 2, 4, 8})
+  {
+    double waypoints = 0.0;
+    double standard_size = 0.0;
+    double compressed_size = 0.0;
+    double compress_us = 0.0;
+    double decompress_us = 0.0;
+    size_t standard_fragmented = 0;
+    size_t compressed_fragmented = 0;
+
+    for (size_t r = 0; r < routes_per_length; ++r)
+    {
+      free_fleet::messages::PathRequest request;
+      request.fleet_name = "fleet";
+      request.robot_name = "robot";
+      request.task_id = "task";
+      request.path = make_route(levels, legs, rng);
+
+      free_fleet::messages::convert(request, *standard);
+      compressor.convert(request, *compressed);
+      if (!free_fleet::messages::convert(*compressed, decoded) ||
+          !free_fleet::messages::same_path(decoded.path, request.path))
+      {
+        printf("decompressed path does not match\n");
+        return 1;
+      }
+
+      const size_t route_standard_size = serialized_size(*standard);
+      const size_t route_compressed_size = serialized_size(*compressed);
+      waypoints += request.path.size();
+      standard_size += route_standard_size;
+      compressed_size += route_compressed_size;
+      standard_fragmented += route_standard_size > fragment_size;
+      compressed_fragmented += route_compressed_size > fragment_size;
+
+      // Only the time on top of the standard conversion is the cost of
+      // compressing and decompressing
+      const double standard_encode_us = time_us(iterations,
+          [&]() { free_fleet::messages::convert(request, *standard); });
+      const double standard_decode_us = time_us(iterations,
+          [&]() { free_fleet::messages::convert(*standard, decoded); });
+      compress_us += time_us(iterations,
+          [&]() { compressor.convert(request, *compressed); }) -
+          standard_encode_us;
+      decompress_us += time_us(iterations,
+          [&]() { free_fleet::messages::convert(*compressed, decoded); }) -
+          standard_decode_us;
+    }
+
+    const double n = static_cast<double>(routes_per_length);
+    printf("%4zu  %9.0f  %12.0f  %14.0f  %5.2f  %13.2f  %15.2f  "
+        "%15.0f%%  %17.0f%%\n",
+        legs, waypoints / n, standard_size / n, compressed_size / n,
+        standard_size / compressed_size, compress_us / n, decompress_us / n,
+        100.0 * standard_fragmented / n, 100.0 * compressed_fragmented / n);
+  }
+
+  dds_sample_free(standard, &FreeFleetData_PathRequest_desc, DDS_FREE_ALL);
+  dds_sample_free(
+      compressed, &FreeFleetData_CompressedPathRequest_desc, DDS_FREE_ALL);
+  return 0;
+}
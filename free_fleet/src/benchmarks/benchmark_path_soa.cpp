@@ -0,0 +1,121 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <cmath>
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+#include <free_fleet/messages/Location.hpp>
+#include <free_fleet/messages/PathSoA.hpp>
+
+namespace {
+
+using free_fleet::messages::Location;
+using free_fleet::messages::PathSoA;
+
+double aos_path_length(const std::vector<Location>& _path)
+{
+  double total = 0.0;
+  for (size_t i = 1; i < _path.size(); ++i)
+  {
+    const float dx = _path[i].x - _path[i - 1].x;
+    const float dy = _path[i].y - _path[i - 1].y;
+    total += std::sqrt(dx * dx + dy * dy);
+  }
+  return total;
+}
+
+size_t nearest_waypoint(
+    const std::vector<Location>& _path, float _x, float _y)
+{
+  size_t nearest = _path.size();
+  float min_squared = INFINITY;
+  for (size_t i = 0; i < _path.size(); ++i)
+  {
+    const float dx = _path[i].x - _x;
+    const float dy = _path[i].y - _y;
+    const float squared = dx * dx + dy * dy;
+    if (squared < min_squared)
+    {
+      min_squared = squared;
+      nearest = i;
+    }
+  }
+  return nearest;
+}
+
+template <typename Function>
+double time_ns(int _iterations, Function _function)
+{
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < _iterations; ++i)
+    _function(i);
+  auto end = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::nano>(end - start).count() /
+      _iterations;
+}
+
+} // anonymous namespace
+
+int main(int argc, char** argv)
+{
+  (void)argc;
+  (void)argv;
+
+  const int iterations = 20000;
+
+  printf("waypoints  length AoS (ns)  length SoA (ns)  "
+      "nearest AoS (ns)  nearest SoA (ns)  same results\n");
+  bool same = true;
+  for (size_t path_length : {10, 100, 1000, 10000})
+  {
+    std::vector<Location> path;
+    for (size_t i = 0; i < path_length; ++i)
+    {
+      const float t = 0.01f * static_cast<float>(i);
+      path.push_back({
+          static_cast<int32_t>(1591866000 + i), 0,
+          10.0f * std::cos(t) + 0.5f * t, 10.0f * std::sin(t), t,
+          i < path_length / 2 ? "building_1_level_1" : "building_1_level_2"});
+    }
+    const PathSoA soa(path);
+
+    double aos_length = 0.0;
+    double soa_length = 0.0;
+    size_t aos_nearest = 0;
+    size_t soa_nearest = 0;
+    const double length_aos_ns = time_ns(iterations,
+        [&](int) { aos_length = aos_path_length(path); });
+    const double length_soa_ns = time_ns(iterations,
+        [&](int) { soa_length = soa.length(); });
+    const double nearest_aos_ns = time_ns(iterations,
+        [&](int i) { aos_nearest = nearest_waypoint(path, i % 7, 1.0f); });
+    const double nearest_soa_ns = time_ns(iterations,
+        [&](int i) { soa_nearest = soa.nearest_waypoint(i % 7, 1.0); });
+
+    const bool same_results =
+        std::abs(aos_length - soa_length) < 1e-6 * aos_length + 1e-9 &&
+        aos_nearest == soa_nearest;
+    same = same && same_results;
+    printf("%9zu  %15.1f  %15.1f  %16.1f  %16.1f  %s\n",
+        path_length, length_aos_ns, length_soa_ns,
+        nearest_aos_ns, nearest_soa_ns, same_results ? "yes" : "no");
+  }
+
+  return same ? 0 : 1;
+}
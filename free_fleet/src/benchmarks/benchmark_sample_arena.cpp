@@ -0,0 +1,130 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <mutex>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+#include <dds/dds.h>
+
+#include <free_fleet/messages/RobotState.hpp>
+
+#include "../dds_utils/SampleArena.hpp"
+#include "../messages/FleetMessages.h"
+#include "../messages/message_utils.hpp"
+
+namespace {
+
+using free_fleet::dds::SampleArena;
+using free_fleet::messages::RobotState;
+
+RobotState make_robot_state(size_t _path_length)
+{
+  RobotState state;
+  state.name = "magni_with_a_long_robot_name";
+  state.model = "magni_model_with_a_long_name";
+  state.task_id = "task_id_with_a_long_description";
+  state.mode.mode = free_fleet::messages::RobotMode::MODE_MOVING;
+  state.battery_percent = 100.0;
+  state.location = {0, 0, 1.0, 2.0, 0.5, "level_with_a_long_name"};
+  for (size_t i = 0; i < _path_length; ++i)
+    state.path.push_back(
+        {0, 0, static_cast<float>(i), 2.0, 0.5, "level_with_a_long_name"});
+  return state;
+}
+
+/// Millions of conversions per second over all the threads.
+template <typename Function>
+double run_threads(int _threads, int _iterations, Function _function)
+{
+  std::vector<std::thread> threads;
+  auto start = std::chrono::steady_clock::now();
+  for (int t = 0; t < _threads; ++t)
+    threads.emplace_back([&]()
+    {
+      for (int i = 0; i < _iterations; ++i)
+        _function();
+    });
+  for (auto& thread : threads)
+    thread.join();
+  auto end = std::chrono::steady_clock::now();
+  return _threads * _iterations /
+      std::chrono::duration<double, std::micro>(end - start).count();
+}
+
+} // anonymous namespace
+
+int main(int argc, char** argv)
+{
+  (void)argc;
+  (void)argv;
+
+  const int iterations = 100000;
+  const RobotState state = make_robot_state(50);
+
+  // Reusable sample shared by all the threads, as when converting into the
+  // sample of a DDSPublishHandler
+  FreeFleetData_RobotState* shared_sample =
+      static_cast<FreeFleetData_RobotState*>(
+          dds_alloc(sizeof(FreeFleetData_RobotState)));
+  std::mutex shared_sample_mutex;
+
+  printf("threads  shared sample (M/s)  arena (M/s)\n");
+  for (int threads : {1, 2, 4, 8})
+  {
+    const double shared_rate = run_threads(threads, iterations, [&]()
+    {
+      std::lock_guard<std::mutex> lock(shared_sample_mutex);
+      free_fleet::messages::convert(state, *shared_sample);
+    });
+
+    const double arena_rate = run_threads(threads, iterations, [&]()
+    {
+      thread_local SampleArena arena;
+      FreeFleetData_RobotState sample = FreeFleetData_RobotState();
+      free_fleet::messages::convert(state, sample, arena);
+      arena.reset();
+    });
+
+    printf("%7d  %19.2f  %11.2f\n", threads, shared_rate, arena_rate);
+  }
+
+  // The arena only grows while converting the first sample, after which it
+  // holds every sample of the same size in a single block
+  SampleArena arena(256);
+  FreeFleetData_RobotState sample = FreeFleetData_RobotState();
+  free_fleet::messages::convert(state, sample, arena);
+  arena.reset();
+  const size_t capacity = arena.capacity();
+  size_t used = 0;
+  for (int i = 0; i < iterations; ++i)
+  {
+    sample = FreeFleetData_RobotState();
+    free_fleet::messages::convert(state, sample, arena);
+    used = arena.used();
+    arena.reset();
+  }
+  const bool stable = arena.capacity() == capacity;
+  printf("arena bytes per sample: %zu, capacity: %zu, stable: %s\n",
+      used, capacity, stable ? "yes" : "no");
+
+  dds_sample_free(
+      shared_sample, &FreeFleetData_RobotState_desc, DDS_FREE_ALL);
+  return stable ? 0 : 1;
+}
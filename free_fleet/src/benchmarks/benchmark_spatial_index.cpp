@@ -0,0 +1,208 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#include <cmath>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+#include <utility>
+#include <algorithm>
+
+#include <free_fleet/messages/RobotState.hpp>
+
+#include "../SpatialIndex.hpp"
+
+namespace {
+
+using free_fleet::SpatialIndex;
+using free_fleet::messages::RobotState;
+
+/// Robots spread over 4 levels, at a density of about one robot per 100
+/// square meters on each level.
+std::vector<RobotState> make_fleet(size_t _robot_count, std::mt19937& _rng)
+{
+  const float extent =
+      std::sqrt(static_cast<float>(_robot_count) / 4.0f * 100.0f);
+  std::uniform_real_distribution<float> position(0.0f, extent);
+  std::vector<RobotState> fleet(_robot_count);
+  for (size_t i = 0; i < _robot_count; ++i)
+  {
+    fleet[i].name = "magni_with_a_long_robot_name_" + std::to_string(i);
+    fleet[i].location = {0, 0, position(_rng), position(_rng), 0.0f,
+        "level_" + std::to_string(i % 4)};
+  }
+  return fleet;
+}
+
+/// What the task allocator does today for every dispatch decision, a scan
+/// through the whole fleet.
+void scan_nearest(
+    const std::vector<RobotState>& _fleet,
+    const std::string& _level_name, float _x, float _y, size_t _k,
+    std::vector<std::pair<float, const RobotState*>>& _candidates,
+    std::vector<std::string>& _robot_names)
+{
+  _candidates.clear();
+  for (const auto& robot : _fleet)
+  {
+    if (robot.location.level_name != _level_name)
+      continue;
+    const float dx = robot.location.x - _x;
+    const float dy = robot.location.y - _y;
+    _candidates.emplace_back(dx * dx + dy * dy, &robot);
+  }
+  const size_t k = std::min(_k, _candidates.size());
+  std::partial_sort(
+      _candidates.begin(), _candidates.begin() + k, _candidates.end(),
+      [](const std::pair<float, const RobotState*>& _a,
+          const std::pair<float, const RobotState*>& _b)
+      {
+        return _a.first < _b.first;
+      });
+  _robot_names.clear();
+  for (size_t i = 0; i < k; ++i)
+    _robot_names.push_back(_candidates[i].second->name);
+}
+
+void scan_radius(
+    const std::vector<RobotState>& _fleet,
+    const std::string& _level_name, float _x, float _y, float _radius,
+    std::vector<std::string>& _robot_names)
+{
+  _robot_names.clear();
+  for (const auto& robot : _fleet)
+  {
+    if (robot.location.level_name != _level_name)
+      continue;
+    const float dx = robot.location.x - _x;
+    const float dy = robot.location.y - _y;
+    if (dx * dx + dy * dy <= _radius * _radius)
+      _robot_names.push_back(robot.name);
+  }
+}
+
+template <typename Function>
+double microseconds_per_call(int _iterations, Function _function)
+{
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < _iterations; ++i)
+    _function(i);
+  auto end = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::micro>(end - start).count() /
+      _iterations;
+}
+
+} // anonymous namespace
+
+int main(int argc, char** argv)
+{
+  (void)argc;
+  (void)argv;
+
+  const int iterations = 2000;
+  const size_t k = 5;
+  const float radius = 15.0f;
+  bool matching = true;
+
+  printf("robots  query      scan (us)  index (us)\n");
+  for (size_t robot_count : {1000, 10000})
+  {
+    std::mt19937 rng(42);
+    std::vector<RobotState> fleet = make_fleet(robot_count, rng);
+    const float extent =
+        std::sqrt(static_cast<float>(robot_count) / 4.0f * 100.0f);
+    std::uniform_real_distribution<float> position(0.0f, extent);
+    std::vector<std::pair<float, float>> queries(iterations);
+    for (auto& query : queries)
+      query = {position(rng), position(rng)};
+
+    SpatialIndex index(10.0);
+    for (const auto& robot : fleet)
+      index.update(robot.name, robot.location);
+
+    std::vector<std::pair<float, const RobotState*>> candidates;
+    std::vector<std::string> scan_names;
+    std::vector<std::string> index_names;
+
+    const double scan_nearest_time = microseconds_per_call(iterations,
+      [&](int _i)
+      {
+        scan_nearest(fleet, "level_1", queries[_i].first, queries[_i].second,
+            k, candidates, scan_names);
+      });
+    const double index_nearest_time = microseconds_per_call(iterations,
+      [&](int _i)
+      {
+        index.find_nearest("level_1", queries[_i].first, queries[_i].second,
+            k, index_names);
+      });
+    printf("%6zu  nearest %zu  %9.2f  %10.2f\n",
+        robot_count, k, scan_nearest_time, index_nearest_time);
+
+    const double scan_radius_time = microseconds_per_call(iterations,
+      [&](int _i)
+      {
+        scan_radius(fleet, "level_1", queries[_i].first, queries[_i].second,
+            radius, scan_names);
+      });
+    const double index_radius_time = microseconds_per_call(iterations,
+      [&](int _i)
+      {
+        index.find_in_radius("level_1", queries[_i].first,
+            queries[_i].second, radius, index_names);
+      });
+    printf("%6zu  radius     %9.2f  %10.2f\n",
+        robot_count, scan_radius_time, index_radius_time);
+
+    // Moving every robot a little, as happens with every round of robot
+    // states, mostly keeps them within their cells
+    std::uniform_real_distribution<float> step(-0.5f, 0.5f);
+    for (auto& robot : fleet)
+    {
+      robot.location.x += step(rng);
+      robot.location.y += step(rng);
+    }
+    const double update_time = microseconds_per_call(
+      static_cast<int>(fleet.size()),
+      [&](int _i)
+      {
+        index.update(fleet[_i].name, fleet[_i].location);
+      });
+    printf("%6zu  update     %9s  %10.3f\n", robot_count, "-", update_time);
+
+    for (int i = 0; i < 100; ++i)
+    {
+      scan_nearest(fleet, "level_2", queries[i].first, queries[i].second, k,
+          candidates, scan_names);
+      index.find_nearest("level_2", queries[i].first, queries[i].second, k,
+          index_names);
+      matching = matching && scan_names == index_names;
+
+      scan_radius(fleet, "level_2", queries[i].first, queries[i].second,
+          radius, scan_names);
+      index.find_in_radius("level_2", queries[i].first, queries[i].second,
+          radius, index_names);
+      std::sort(scan_names.begin(), scan_names.end());
+      std::sort(index_names.begin(), index_names.end());
+      matching = matching && scan_names == index_names;
+    }
+  }
+
+  printf("index matches scan: %s\n", matching ? "yes" : "no");
+  return matching ? 0 : 1;
+}
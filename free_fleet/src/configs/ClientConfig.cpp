@@ -25,12 +25,39 @@ void ClientConfig::print_config() const
 {
   printf("CLIENT-SERVER DDS CONFIGURATION\n");
   printf("  dds domain: %d\n", dds_domain);
+  printf("  fleet name: %s\n", fleet_name.c_str());
+  printf("  robot name: %s\n", robot_name.c_str());
   printf("  TOPICS\n");
   printf("    robot state: %s\n", dds_state_topic.c_str());
   printf("    mode request: %s\n", dds_mode_request_topic.c_str());
   printf("    path request: %s\n", dds_path_request_topic.c_str());
   printf("    destination request: %s\n", 
       dds_destination_request_topic.c_str());
+  printf("    robot state delta: %s\n", dds_state_delta_topic.c_str());
+  printf("    robot registration: %s\n", dds_registration_topic.c_str());
+  printf("    registered robot state: %s\n",
+      dds_registered_state_topic.c_str());
+  printf("    registered mode request: %s\n",
+      dds_registered_mode_request_topic.c_str());
+  printf("    registered path request: %s\n",
+      dds_registered_path_request_topic.c_str());
+  printf("    registered destination request: %s\n",
+      dds_registered_destination_request_topic.c_str());
+  printf("    request ack: %s\n", dds_request_ack_topic.c_str());
+  printf("  message format: %s\n", message_format_name(message_format));
+  printf("  path compression threshold: %zu\n", path_compression_threshold);
+  printf("  async publish: %s, queue size: %zu\n",
+      async_publish ? "on" : "off", async_publish_queue_size);
+  printf("  state keyframe interval: %zu\n", state_keyframe_interval);
+  printf("  robot ids: %s, announce interval: %zu\n",
+      robot_ids ? "on" : "off", robot_id_announce_interval);
+  printf("  QOS PROFILES\n");
+  dds_state_qos.print_profile("robot state");
+  dds_mode_request_qos.print_profile("mode request");
+  dds_path_request_qos.print_profile("path request");
+  dds_destination_request_qos.print_profile("destination request");
+  dds_registration_qos.print_profile("robot registration");
+  dds_request_ack_qos.print_profile("request ack");
 }
 
 } // namespace free_fleet
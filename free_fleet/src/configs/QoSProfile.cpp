@@ -0,0 +1,69 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <free_fleet/QoSProfile.hpp>
+
+#include <cstdio>
+
+namespace free_fleet {
+
+void QoSProfile::print_profile(const char* _topic_label) const
+{
+  printf("    %s: %s, ", _topic_label,
+      reliability == Reliability::RELIABLE ? "reliable" : "best effort");
+  if (history == History::KEEP_ALL)
+    printf("keep all, ");
+  else
+    printf("keep last %d, ", history_depth);
+  printf("%s, deadline: %.3f, liveliness lease duration: %.3f, "
+      "latency budget: %.3f, priority: %d\n",
+      durability == Durability::TRANSIENT_LOCAL ?
+          "transient local" : "volatile",
+      deadline, liveliness_lease_duration, latency_budget,
+      transport_priority);
+}
+
+QoSProfile QoSProfile::make_state_profile()
+{
+  QoSProfile profile;
+  profile.reliability = Reliability::BEST_EFFORT;
+  profile.history = History::KEEP_LAST;
+  profile.history_depth = 1;
+  return profile;
+}
+
+QoSProfile QoSProfile::make_request_profile()
+{
+  QoSProfile profile;
+  profile.reliability = Reliability::RELIABLE;
+  profile.history = History::KEEP_LAST;
+  profile.history_depth = 10;
+  profile.latency_budget = 0.01;
+  return profile;
+}
+
+QoSProfile QoSProfile::make_registration_profile()
+{
+  QoSProfile profile;
+  profile.reliability = Reliability::RELIABLE;
+  profile.history = History::KEEP_LAST;
+  profile.history_depth = 1;
+  profile.durability = Durability::TRANSIENT_LOCAL;
+  return profile;
+}
+
+} // namespace free_fleet
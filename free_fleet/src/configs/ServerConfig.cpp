@@ -31,6 +31,40 @@ void ServerConfig::print_config() const
   printf("    path request: %s\n", dds_path_request_topic.c_str());
   printf("    destination request: %s\n", 
       dds_destination_request_topic.c_str());
+  printf("    robot state delta: %s\n", dds_robot_state_delta_topic.c_str());
+  printf("    robot registration: %s\n",
+      dds_robot_registration_topic.c_str());
+  printf("    registered robot state: %s\n",
+      dds_registered_robot_state_topic.c_str());
+  printf("    registered mode request: %s\n",
+      dds_registered_mode_request_topic.c_str());
+  printf("    registered path request: %s\n",
+      dds_registered_path_request_topic.c_str());
+  printf("    registered destination request: %s\n",
+      dds_registered_destination_request_topic.c_str());
+  printf("    request ack: %s\n", dds_request_ack_topic.c_str());
+  printf("  robot state batch size: %zu\n", robot_state_batch_size);
+  printf("  robot state deltas: %s\n", robot_state_deltas ? "on" : "off");
+  printf("  write batching: %s\n", dds_write_batching ? "on" : "off");
+  printf("  robot ids: %s\n", robot_ids ? "on" : "off");
+  printf("  spatial index cell size: %.2f\n", spatial_index_cell_size);
+  printf("  robot state expiry: %.2f\n", robot_state_expiry);
+  printf("  ingest thread: %s\n", ingest_thread ? "on" : "off");
+  printf("  robot presence: %s\n", robot_presence ? "on" : "off");
+  printf("  request acks: %s, max pending: %zu, latency window: %zu\n",
+      request_acks ? "on" : "off", request_ack_max_pending,
+      request_ack_latency_window);
+  printf("  message format: %s\n", message_format_name(message_format));
+  printf("  path compression threshold: %zu\n", path_compression_threshold);
+  printf("  async publish: %s, queue size: %zu\n",
+      async_publish ? "on" : "off", async_publish_queue_size);
+  printf("  QOS PROFILES\n");
+  dds_robot_state_qos.print_profile("robot state");
+  dds_mode_request_qos.print_profile("mode request");
+  dds_path_request_qos.print_profile("path request");
+  dds_destination_request_qos.print_profile("destination request");
+  dds_registration_qos.print_profile("robot registration");
+  dds_request_ack_qos.print_profile("request ack");
 }
 
 } // namespace free_fleet
@@ -0,0 +1,182 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef FREE_FLEET__SRC__DDS_UTILS__ASYNCPUBLISHHANDLER_HPP
+#define FREE_FLEET__SRC__DDS_UTILS__ASYNCPUBLISHHANDLER_HPP
+
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <cstdint>
+#include <utility>
+#include <functional>
+#include <condition_variable>
+
+#include "BoundedQueue.hpp"
+
+namespace free_fleet {
+namespace dds {
+
+/// Publishes messages from a dedicated writer thread. Callers only copy the
+/// message into a bounded lock-free queue, while conversion and writing
+/// happen on the writer thread. Messages are dropped when the queue is full.
+/// The writer thread drains the queue and writes everything it drained as
+/// a single batch, so that messages published in a burst are still flushed
+/// out together.
+template <typename Input>
+class AsyncPublishHandler
+{
+public:
+
+  using SharedPtr = std::shared_ptr<AsyncPublishHandler>;
+
+  /// Function that converts and writes a batch of messages on the writer
+  /// thread, and flushes them out together.
+  using WriteBatchFunction = std::function<bool(const std::vector<Input>&)>;
+
+  AsyncPublishHandler(
+      WriteBatchFunction _write_batch_function, size_t _queue_size) :
+    write_batch_function(std::move(_write_batch_function)),
+    queue(_queue_size),
+    dropped_count(0),
+    idle(false),
+    stopping(false)
+  {
+    writer_thread = std::thread(&AsyncPublishHandler::writer_thread_fn, this);
+  }
+
+  /// Stops the writer thread after the queued messages have been written.
+  ~AsyncPublishHandler()
+  {
+    {
+      std::lock_guard<std::mutex> lock(wakeup_mutex);
+      stopping = true;
+    }
+    wakeup_cv.notify_one();
+    if (writer_thread.joinable())
+      writer_thread.join();
+  }
+
+  /// Queues the message to be written by the writer thread.
+  ///
+  /// \param[in] input
+  ///   Message to be converted using the matching convert function.
+  /// \return
+  ///   True if the message was queued, false if it was dropped because the
+  ///   queue is full.
+  bool publish(const Input& _input)
+  {
+    return queued(queue.try_push(_input));
+  }
+
+  /// Moves the message into the queue instead of copying it, the message is
+  /// left untouched when it is dropped.
+  bool publish(Input&& _input)
+  {
+    return queued(queue.try_push(std::move(_input)));
+  }
+
+  /// Number of messages that were either dropped because the queue was full,
+  /// or failed to be written by the writer thread. The write of a batch only
+  /// reports whether all of it was written, so all the messages of a batch
+  /// that failed are counted.
+  uint64_t get_dropped_count() const
+  {
+    return dropped_count.load();
+  }
+
+private:
+
+  WriteBatchFunction write_batch_function;
+
+  BoundedQueue<Input> queue;
+
+  std::atomic<uint64_t> dropped_count;
+
+  std::atomic<bool> idle;
+
+  bool stopping;
+
+  std::mutex wakeup_mutex;
+
+  std::condition_variable wakeup_cv;
+
+  std::thread writer_thread;
+
+  bool queued(bool _pushed)
+  {
+    if (!_pushed)
+    {
+      ++dropped_count;
+      return false;
+    }
+
+    // The push claims its position and idle is read in a single total
+    // order with the writer setting idle and checking the positions, so
+    // that either the writer sees the message before going to sleep, or
+    // this sees idle set and wakes it up.
+    if (idle.load())
+    {
+      std::lock_guard<std::mutex> lock(wakeup_mutex);
+      wakeup_cv.notify_one();
+    }
+    return true;
+  }
+
+  void writer_thread_fn()
+  {
+    // Batches are capped at the queue capacity, so that a drain ends even
+    // while publishers keep pushing.
+    const size_t max_batch_size = queue.capacity();
+    std::vector<Input> inputs;
+    inputs.reserve(max_batch_size);
+    Input input;
+    while (true)
+    {
+      while (queue.try_pop(input))
+      {
+        inputs.push_back(std::move(input));
+        while (inputs.size() < max_batch_size && queue.try_pop(input))
+          inputs.push_back(std::move(input));
+
+        if (!write_batch_function(inputs))
+          dropped_count += inputs.size();
+        inputs.clear();
+      }
+
+      std::unique_lock<std::mutex> lock(wakeup_mutex);
+      if (stopping && queue.empty())
+        return;
+
+      // Publishers only notify while idle is set, so the queue has to be
+      // checked again after setting it, before going to sleep.
+      idle.store(true);
+      if (queue.empty() && !stopping)
+        wakeup_cv.wait_for(lock, std::chrono::milliseconds(100));
+      idle.store(false);
+    }
+  }
+
+};
+
+} // namespace dds
+} // namespace free_fleet
+
+#endif // FREE_FLEET__SRC__DDS_UTILS__ASYNCPUBLISHHANDLER_HPP
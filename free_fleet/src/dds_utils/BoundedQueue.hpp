@@ -0,0 +1,171 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef FREE_FLEET__SRC__DDS_UTILS__BOUNDEDQUEUE_HPP
+#define FREE_FLEET__SRC__DDS_UTILS__BOUNDEDQUEUE_HPP
+
+#include <atomic>
+#include <memory>
+#include <cstddef>
+#include <utility>
+
+namespace free_fleet {
+namespace dds {
+
+/// Bounded lock-free queue that supports multiple concurrent producers and
+/// consumers, based on a ring of cells that each carry a sequence number.
+/// The capacity is rounded up to the next power of two.
+template <typename T>
+class BoundedQueue
+{
+public:
+
+  BoundedQueue(size_t _capacity) :
+    mask(round_up_to_power_of_two(_capacity) - 1),
+    cells(new Cell[mask + 1]),
+    enqueue_position(0),
+    dequeue_position(0)
+  {
+    for (size_t i = 0; i <= mask; ++i)
+      cells[i].sequence.store(i, std::memory_order_relaxed);
+  }
+
+  size_t capacity() const
+  {
+    return mask + 1;
+  }
+
+  /// Attempts to push a new element into the queue.
+  ///
+  /// \return
+  ///   True if the element was pushed, false if the queue is full.
+  bool try_push(const T& _element)
+  {
+    return push(_element);
+  }
+
+  /// Attempts to move a new element into the queue, the element is left
+  /// untouched if the queue is full.
+  bool try_push(T&& _element)
+  {
+    return push(std::move(_element));
+  }
+
+  /// Attempts to pop the oldest element from the queue.
+  ///
+  /// \return
+  ///   True if an element was popped, false if the queue is empty.
+  bool try_pop(T& _element)
+  {
+    size_t position = dequeue_position.load(std::memory_order_relaxed);
+    Cell* cell;
+    while (true)
+    {
+      cell = &cells[position & mask];
+      const size_t sequence = cell->sequence.load(std::memory_order_acquire);
+      const std::ptrdiff_t difference =
+          static_cast<std::ptrdiff_t>(sequence) -
+          static_cast<std::ptrdiff_t>(position + 1);
+      if (difference == 0)
+      {
+        if (dequeue_position.compare_exchange_weak(
+            position, position + 1, std::memory_order_relaxed))
+          break;
+      }
+      else if (difference < 0)
+        return false;
+      else
+        position = dequeue_position.load(std::memory_order_relaxed);
+    }
+
+    _element = std::move(cell->element);
+    cell->sequence.store(position + mask + 1, std::memory_order_release);
+    return true;
+  }
+
+  /// Pushes claim their positions in a single total order with this read,
+  /// so that a thread that stores a flag and then finds the queue empty
+  /// knows that any push it missed is followed by a read that sees the flag.
+  bool empty() const
+  {
+    return enqueue_position.load() == dequeue_position.load();
+  }
+
+private:
+
+  struct Cell
+  {
+    std::atomic<size_t> sequence;
+    T element;
+  };
+
+  template <typename Element>
+  bool push(Element&& _element)
+  {
+    size_t position = enqueue_position.load(std::memory_order_relaxed);
+    Cell* cell;
+    while (true)
+    {
+      cell = &cells[position & mask];
+      const size_t sequence = cell->sequence.load(std::memory_order_acquire);
+      const std::ptrdiff_t difference =
+          static_cast<std::ptrdiff_t>(sequence) -
+          static_cast<std::ptrdiff_t>(position);
+      if (difference == 0)
+      {
+        // Sequentially consistent, see empty.
+        if (enqueue_position.compare_exchange_weak(
+            position, position + 1,
+            std::memory_order_seq_cst, std::memory_order_relaxed))
+          break;
+      }
+      else if (difference < 0)
+        return false;
+      else
+        position = enqueue_position.load(std::memory_order_relaxed);
+    }
+
+    cell->element = std::forward<Element>(_element);
+    cell->sequence.store(position + 1, std::memory_order_release);
+    return true;
+  }
+
+  static size_t round_up_to_power_of_two(size_t _value)
+  {
+    size_t result = 2;
+    while (result < _value)
+      result <<= 1;
+    return result;
+  }
+
+  const size_t mask;
+
+  std::unique_ptr<Cell[]> cells;
+
+  std::atomic<size_t> enqueue_position;
+
+  /// Keeps the producer and consumer positions on separate cache lines.
+  char padding[64];
+
+  std::atomic<size_t> dequeue_position;
+
+};
+
+} // namespace dds
+} // namespace free_fleet
+
+#endif // FREE_FLEET__SRC__DDS_UTILS__BOUNDEDQUEUE_HPP
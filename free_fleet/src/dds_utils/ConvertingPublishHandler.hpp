@@ -0,0 +1,210 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef FREE_FLEET__SRC__DDS_UTILS__CONVERTINGPUBLISHHANDLER_HPP
+#define FREE_FLEET__SRC__DDS_UTILS__CONVERTINGPUBLISHHANDLER_HPP
+
+#include <memory>
+#include <vector>
+#include <cstdint>
+#include <utility>
+#include <functional>
+
+#include "DDSPublishHandler.hpp"
+#include "AsyncPublishHandler.hpp"
+
+namespace free_fleet {
+namespace dds {
+
+/// Publishes inputs in the message type that was chosen when the handler was
+/// made, so that callers do not depend on the configured message format. The
+/// handler also checks that the inputs fit the message type, and can hand
+/// them to a writer thread, see start_async.
+template <typename Input>
+class ConvertingPublishHandler
+{
+public:
+
+  using SharedPtr = std::shared_ptr<ConvertingPublishHandler>;
+
+  /// Converts and writes an input.
+  using WriteFunction = std::function<bool(const Input&)>;
+
+  /// Converts and writes the inputs, and flushes them out together.
+  using WriteBatchFunction = std::function<bool(const std::vector<Input>&)>;
+
+  /// Checks whether an input can be converted into the message type.
+  using FitsFunction = std::function<bool(const Input&)>;
+
+  /// \param[in] write
+  ///   Writes a single input.
+  /// \param[in] write_batch
+  ///   Writes a batch of inputs, when empty the inputs are written one by one.
+  /// \param[in] fits
+  ///   Rejects the inputs that do not fit, when empty all inputs fit.
+  ConvertingPublishHandler(
+      WriteFunction _write,
+      WriteBatchFunction _write_batch = WriteBatchFunction(),
+      FitsFunction _fits = FitsFunction()) :
+    write(std::move(_write)),
+    write_batch(std::move(_write_batch)),
+    fits(std::move(_fits))
+  {}
+
+  /// Makes a handler that converts the inputs using the matching convert
+  /// function of the message type.
+  template <typename Message>
+  static SharedPtr make(
+      typename DDSPublishHandler<Message>::SharedPtr _publisher,
+      FitsFunction _fits = FitsFunction())
+  {
+    return SharedPtr(new ConvertingPublishHandler(
+        [_publisher](const Input& _input)
+        {
+          return _publisher->write_converted(_input);
+        },
+        [_publisher](const std::vector<Input>& _inputs)
+        {
+          return _publisher->write_converted_batch(_inputs);
+        },
+        std::move(_fits)));
+  }
+
+  /// Makes a handler that converts the inputs using the convert function of
+  /// the converter, see DDSPublishHandler::write_converted.
+  template <typename Message, typename Converter>
+  static SharedPtr make_with_converter(
+      typename DDSPublishHandler<Message>::SharedPtr _publisher,
+      std::shared_ptr<Converter> _converter)
+  {
+    return SharedPtr(new ConvertingPublishHandler(
+        [_publisher, _converter](const Input& _input)
+        {
+          return _publisher->write_converted(_input, *_converter);
+        },
+        [_publisher, _converter](const std::vector<Input>& _inputs)
+        {
+          return _publisher->write_converted_batch(_inputs, *_converter);
+        }));
+  }
+
+  /// Writes the inputs from a dedicated writer thread from now on, publish
+  /// then only queues them. The writer thread writes the inputs it drains
+  /// from the queue as a single batch. Needs to be called before publishing.
+  void start_async(size_t _queue_size)
+  {
+    async.reset(new AsyncPublishHandler<Input>(
+        [this](const std::vector<Input>& _inputs)
+        {
+          return write_all(_inputs);
+        },
+        _queue_size));
+  }
+
+  /// Stops the writer thread after the queued inputs have been written,
+  /// which needs to happen before the writer of the handler is deleted.
+  void stop_async()
+  {
+    async.reset();
+  }
+
+  /// Writes the input, or queues it when writing asynchronously.
+  ///
+  /// \return
+  ///   True if the input was written or queued, false if it does not fit the
+  ///   message type, or failed to be written or queued.
+  bool publish(const Input& _input)
+  {
+    if (fits && !fits(_input))
+      return false;
+    if (async)
+      return async->publish(_input);
+    return write(_input);
+  }
+
+  /// Moves the input into the queue when writing asynchronously, otherwise
+  /// the same as publishing a copy.
+  bool publish(Input&& _input)
+  {
+    if (fits && !fits(_input))
+      return false;
+    if (async)
+      return async->publish(std::move(_input));
+    return write(_input);
+  }
+
+  /// Writes the inputs as a single batch, or queues them when writing
+  /// asynchronously, in which case the writer thread writes them out
+  /// together with the other inputs it drains. Nothing is published if any
+  /// of the inputs does not fit the message type.
+  ///
+  /// \return
+  ///   True if all the inputs were written or queued.
+  bool publish_batch(const std::vector<Input>& _inputs)
+  {
+    if (fits)
+    {
+      for (const Input& input : _inputs)
+      {
+        if (!fits(input))
+          return false;
+      }
+    }
+
+    if (async)
+    {
+      bool all_queued = true;
+      for (const Input& input : _inputs)
+        all_queued = async->publish(input) && all_queued;
+      return all_queued;
+    }
+    return write_all(_inputs);
+  }
+
+  /// Number of inputs dropped by the writer thread, see
+  /// AsyncPublishHandler::get_dropped_count.
+  uint64_t get_dropped_count() const
+  {
+    return async ? async->get_dropped_count() : 0;
+  }
+
+private:
+
+  WriteFunction write;
+
+  WriteBatchFunction write_batch;
+
+  FitsFunction fits;
+
+  std::unique_ptr<AsyncPublishHandler<Input>> async;
+
+  bool write_all(const std::vector<Input>& _inputs)
+  {
+    if (write_batch)
+      return write_batch(_inputs);
+    bool all_written = true;
+    for (const Input& input : _inputs)
+      all_written = write(input) && all_written;
+    return all_written;
+  }
+
+};
+
+} // namespace dds
+} // namespace free_fleet
+
+#endif // FREE_FLEET__SRC__DDS_UTILS__CONVERTINGPUBLISHHANDLER_HPP
@@ -0,0 +1,192 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef FREE_FLEET__SRC__DDS_UTILS__CONVERTINGSUBSCRIBEHANDLER_HPP
+#define FREE_FLEET__SRC__DDS_UTILS__CONVERTINGSUBSCRIBEHANDLER_HPP
+
+#include <memory>
+#include <vector>
+#include <utility>
+#include <functional>
+
+#include <dds/dds.h>
+
+#include "DDSSubscribeHandler.hpp"
+
+namespace free_fleet {
+namespace dds {
+
+/// Takes samples in the message type that was chosen when the handler was
+/// made, and converts them into outputs, so that callers do not depend on the
+/// configured message format.
+template <typename Output>
+class ConvertingSubscribeHandler
+{
+public:
+
+  using SharedPtr = std::shared_ptr<ConvertingSubscribeHandler>;
+
+  virtual ~ConvertingSubscribeHandler() = default;
+
+  /// Makes a handler that converts the samples of the subscriber using the
+  /// matching convert function of the message type. Conversions that return
+  /// false drop their sample.
+  template <typename Message>
+  static SharedPtr make(
+      typename DDSSubscribeHandler<Message>::SharedPtr _subscriber);
+
+  /// Takes all pending samples and converts them in place into the outputs,
+  /// which keep the capacity of their strings and paths from previous calls.
+  /// The outputs are only grown, the ones past the returned count are left
+  /// as they are.
+  ///
+  /// \param[out] writers
+  ///   If not null, set to the instance handles of the writers of the
+  ///   converted outputs, in the same order.
+  /// \return
+  ///   Number of samples that were taken and converted.
+  virtual size_t take_all(
+      std::vector<Output>& outputs,
+      std::vector<dds_instance_handle_t>* writers = nullptr) = 0;
+
+  /// Takes a single pending sample.
+  ///
+  /// \return
+  ///   True if a sample was taken and converted.
+  virtual bool take(Output& output) = 0;
+
+  virtual dds_entity_t get_reader() const = 0;
+
+  /// See DDSSubscribeHandler::set_data_available_callback.
+  virtual void set_data_available_callback(std::function<void()> callback) = 0;
+
+  /// See DDSSubscribeHandler::set_deadline_missed_callback.
+  virtual void set_deadline_missed_callback(
+      std::function<void(dds_instance_handle_t)> callback) = 0;
+
+  /// See DDSSubscribeHandler::set_liveliness_changed_callback.
+  virtual void set_liveliness_changed_callback(
+      std::function<void(dds_instance_handle_t, bool)> callback) = 0;
+
+private:
+
+  template <typename Message>
+  class Implementation;
+
+};
+
+template <typename Output>
+template <typename Message>
+class ConvertingSubscribeHandler<Output>::Implementation :
+  public ConvertingSubscribeHandler<Output>
+{
+public:
+
+  Implementation(
+      typename DDSSubscribeHandler<Message>::SharedPtr _subscriber) :
+    subscriber(std::move(_subscriber))
+  {}
+
+  size_t take_all(
+      std::vector<Output>& _outputs,
+      std::vector<dds_instance_handle_t>* _writers = nullptr) final
+  {
+    std::vector<std::shared_ptr<const Message>> samples;
+    if (_writers)
+      _writers->clear();
+    subscriber->take_all_loaned(samples, _writers);
+    if (_outputs.size() < samples.size())
+      _outputs.resize(samples.size());
+
+    // Writers of the samples that failed to convert are dropped along with
+    // them, so that the writers stay aligned with the outputs.
+    size_t count = 0;
+    for (size_t i = 0; i < samples.size(); ++i)
+    {
+      if (!convert_sample(*samples[i], _outputs[count], 0))
+        continue;
+      if (_writers)
+        (*_writers)[count] = (*_writers)[i];
+      ++count;
+    }
+    if (_writers)
+      _writers->resize(count);
+    return count;
+  }
+
+  bool take(Output& _output) final
+  {
+    auto taken_samples = subscriber->take_loaned();
+    return !taken_samples.empty() &&
+        convert_sample(*(taken_samples[0]), _output, 0);
+  }
+
+  dds_entity_t get_reader() const final
+  {
+    return subscriber->get_reader();
+  }
+
+  void set_data_available_callback(std::function<void()> _callback) final
+  {
+    subscriber->set_data_available_callback(std::move(_callback));
+  }
+
+  void set_deadline_missed_callback(
+      std::function<void(dds_instance_handle_t)> _callback) final
+  {
+    subscriber->set_deadline_missed_callback(std::move(_callback));
+  }
+
+  void set_liveliness_changed_callback(
+      std::function<void(dds_instance_handle_t, bool)> _callback) final
+  {
+    subscriber->set_liveliness_changed_callback(std::move(_callback));
+  }
+
+private:
+
+  typename DDSSubscribeHandler<Message>::SharedPtr subscriber;
+
+  /// Conversions that can fail return whether they succeeded.
+  template <typename Sample>
+  static auto convert_sample(const Sample& _sample, Output& _output, int)
+    -> decltype(static_cast<bool>(convert(_sample, _output)))
+  {
+    return convert(_sample, _output);
+  }
+
+  template <typename Sample>
+  static bool convert_sample(const Sample& _sample, Output& _output, long)
+  {
+    convert(_sample, _output);
+    return true;
+  }
+
+};
+
+template <typename Output>
+template <typename Message>
+auto ConvertingSubscribeHandler<Output>::make(
+    typename DDSSubscribeHandler<Message>::SharedPtr _subscriber) -> SharedPtr
+{
+  return SharedPtr(new Implementation<Message>(std::move(_subscriber)));
+}
+
+} // namespace dds
+} // namespace free_fleet
+
+#endif // FREE_FLEET__SRC__DDS_UTILS__CONVERTINGSUBSCRIBEHANDLER_HPP
@@ -18,10 +18,19 @@
 #ifndef FREE_FLEET__SRC__DDS_UTILS__DDSPUBLISHHANDLER_HPP
 #define FREE_FLEET__SRC__DDS_UTILS__DDSPUBLISHHANDLER_HPP
 
+#include <mutex>
 #include <memory>
+#include <utility>
+#include <string>
+#include <vector>
 
 #include <dds/dds.h>
 
+#include <free_fleet/QoSProfile.hpp>
+
+#include "common.hpp"
+#include "SampleArena.hpp"
+
 namespace free_fleet {
 namespace dds {
 
@@ -34,8 +43,6 @@ public:
 
 private:
 
-  dds_return_t return_code;
-
   const dds_topic_descriptor_t* topic_desc;
 
   dds_entity_t topic;
@@ -44,13 +51,30 @@ private:
 
   bool ready;
 
+  /// Sample that is reused by the write_converted calls of inputs without
+  /// a conversion backed by a SampleArena, its strings and sequence buffers
+  /// grow as required but are never freed until this handler is destroyed.
+  Message* sample;
+
+  /// Capacities of the strings of the sample, which are passed to the
+  /// conversions into the sample, so that a string that got shorter keeps its
+  /// buffer for longer contents later on.
+  common::DdsStringCapacities sample_capacities;
+
+  std::mutex sample_mutex;
+
 public:
 
+  /// The user data is attached to the writer, where the readers that are
+  /// matched with it can look it up, see common::dds_get_matched_user_data.
   DDSPublishHandler(
       const dds_entity_t& _participant,
       const dds_topic_descriptor_t* _topic_desc,
-      const std::string& _topic_name) :
-    topic_desc(_topic_desc)
+      const std::string& _topic_name,
+      const QoSProfile& _qos_profile = QoSProfile(),
+      const std::string& _user_data = std::string()) :
+    topic_desc(_topic_desc),
+    sample(static_cast<Message*>(dds_alloc(sizeof(Message))))
   {
     ready = false;
 
@@ -62,8 +86,9 @@ public:
       return;
     }
 
-    dds_qos_t* qos = dds_create_qos();
-    dds_qset_reliability(qos, DDS_RELIABILITY_BEST_EFFORT, 0);
+    dds_qos_t* qos = common::dds_create_qos_from_profile(_qos_profile);
+    if (!_user_data.empty())
+      dds_qset_userdata(qos, _user_data.data(), _user_data.size());
     writer = dds_create_writer(_participant, topic, qos, NULL);
     if (writer < 0)
     {
@@ -76,16 +101,32 @@ public:
   }
 
   ~DDSPublishHandler()
-  {}
+  {
+    dds_sample_free(sample, topic_desc, DDS_FREE_ALL);
+  }
+
+  DDSPublishHandler(const DDSPublishHandler&) = delete;
+
+  DDSPublishHandler& operator=(const DDSPublishHandler&) = delete;
 
   bool is_ready()
   {
     return ready;
   }
 
+  /// Writes the message, and flushes it out immediately in case DDS write
+  /// batching has been enabled.
   bool write(Message* msg)
   {
-    return_code = dds_write(writer, msg);
+    return write_unflushed(msg) && flush();
+  }
+
+  /// Writes the message without flushing, if write batching is enabled in
+  /// the DDS configuration the message is only sent out once flush() is
+  /// called, or once enough messages are queued to fill up a packet.
+  bool write_unflushed(Message* msg)
+  {
+    const dds_return_t return_code = dds_write(writer, msg);
     if (return_code != DDS_RETCODE_OK)
     {
       DDS_FATAL("dds_write failed: %s", dds_strretcode(-return_code));
@@ -94,6 +135,127 @@ public:
     return true;
   }
 
+  /// Sends out all the messages that were queued by the writer.
+  bool flush()
+  {
+    const dds_return_t return_code = dds_write_flush(writer);
+    if (return_code != DDS_RETCODE_OK)
+    {
+      DDS_FATAL("dds_write_flush failed: %s", dds_strretcode(-return_code));
+      return false;
+    }
+    return true;
+  }
+
+  /// Converts the input and writes it. Inputs that have a conversion backed
+  /// by a SampleArena are converted into a sample on the stack, whose strings
+  /// and sequences come from an arena owned by the calling thread, so that
+  /// threads writing at the same time do not contend with each other. Other
+  /// inputs are converted into the reusable sample of this handler. Either
+  /// way, no sample is allocated and freed for every write.
+  ///
+  /// \param[in] input
+  ///   Message to be converted using the matching convert function.
+  /// \return
+  ///   True if the sample was successfully written, false otherwise.
+  template <typename Input>
+  bool write_converted(const Input& _input)
+  {
+    return convert_and_write(_input, true, 0);
+  }
+
+  /// Converts and writes each of the inputs, and flushes them all out
+  /// together after the last write.
+  ///
+  /// \param[in] inputs
+  ///   Messages to be converted using the matching convert function.
+  /// \return
+  ///   True if all the samples were successfully written, false otherwise.
+  template <typename Input>
+  bool write_converted_batch(const std::vector<Input>& _inputs)
+  {
+    bool all_written = true;
+    for (const Input& input : _inputs)
+      all_written = convert_and_write(input, false, 0) && all_written;
+    return flush() && all_written;
+  }
+
+  /// Same as write_converted, but converts the input using the convert
+  /// function of the converter, for conversions that need settings or
+  /// buffers of their own. The converter is only used while holding the
+  /// lock of the reusable sample, and is passed the capacities of the strings
+  /// of the sample.
+  template <typename Input, typename Converter>
+  bool write_converted(const Input& _input, Converter& _converter)
+  {
+    std::lock_guard<std::mutex> lock(sample_mutex);
+    _converter.convert(_input, *sample, &sample_capacities);
+    return write(sample);
+  }
+
+  /// Same as write_converted_batch, but converts the inputs using the
+  /// convert function of the converter.
+  template <typename Input, typename Converter>
+  bool write_converted_batch(
+      const std::vector<Input>& _inputs, Converter& _converter)
+  {
+    std::lock_guard<std::mutex> lock(sample_mutex);
+    bool all_written = true;
+    for (const Input& input : _inputs)
+    {
+      _converter.convert(input, *sample, &sample_capacities);
+      all_written = write_unflushed(sample) && all_written;
+    }
+    return flush() && all_written;
+  }
+
+private:
+
+  /// Converts the input into a sample backed by the arena of the calling
+  /// thread, which is reset as soon as the sample is written, as DDS
+  /// serializes the sample during the write.
+  template <typename Input>
+  auto convert_and_write(const Input& _input, bool _flush, int)
+    -> decltype(
+        convert(_input, std::declval<Message&>(),
+            std::declval<SampleArena&>()),
+        bool())
+  {
+    thread_local SampleArena arena;
+    Message arena_sample = Message();
+    convert(_input, arena_sample, arena);
+    const bool written =
+        _flush ? write(&arena_sample) : write_unflushed(&arena_sample);
+    arena.reset();
+    return written;
+  }
+
+  template <typename Input>
+  bool convert_and_write(const Input& _input, bool _flush, long)
+  {
+    std::lock_guard<std::mutex> lock(sample_mutex);
+    convert_into_sample(_input, 0);
+    return _flush ? write(sample) : write_unflushed(sample);
+  }
+
+  /// Conversions that assign DDS strings take the capacities of the strings
+  /// of the sample, only called while holding the lock of the sample.
+  template <typename Input>
+  auto convert_into_sample(const Input& _input, int)
+    -> decltype(
+        convert(_input, std::declval<Message&>(),
+            std::declval<common::DdsStringCapacities*>()),
+        void())
+  {
+    convert(_input, *sample, &sample_capacities);
+  }
+
+  template <typename Input>
+  void convert_into_sample(const Input& _input, long)
+  {
+    convert(_input, *sample);
+  }
+
 };
 
 } // namespace dds
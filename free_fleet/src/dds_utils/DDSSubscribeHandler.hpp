@@ -18,15 +18,22 @@
 #ifndef FREE_FLEET__SRC__DDS_UTILS__DDSSUBSCRIBEHANDLER_HPP
 #define FREE_FLEET__SRC__DDS_UTILS__DDSSUBSCRIBEHANDLER_HPP
 
+#include <mutex>
 #include <memory>
+#include <string>
+#include <functional>
 #include <vector>
 
 #include <dds/dds.h>
 
+#include <free_fleet/QoSProfile.hpp>
+
+#include "common.hpp"
+
 namespace free_fleet {
 namespace dds {
 
-template <typename Message, size_t MaxSamplesNum = 1>
+template <typename Message>
 class DDSSubscribeHandler
 {
 public:
@@ -35,29 +42,167 @@ public:
 
 private:
 
-  dds_return_t return_code;
-
   const dds_topic_descriptor_t* topic_desc;
 
   dds_entity_t topic;
   
   dds_entity_t reader;
+
+  size_t max_samples_num;
   
-  std::array<std::shared_ptr<Message>, MaxSamplesNum> shared_msgs;
+  /// Preallocated samples that read() copies into, which are shared by all
+  /// the calls to read(), and only used while holding read_mutex. The other
+  /// takes keep everything they use on their own, so that the listener
+  /// callbacks can take samples while another thread is taking as well.
+  std::vector<std::shared_ptr<Message>> shared_msgs;
+
+  std::vector<void*> samples;
 
-  void* samples[MaxSamplesNum];
+  std::vector<dds_sample_info_t> infos;
 
-  dds_sample_info_t infos[MaxSamplesNum];
+  std::mutex read_mutex;
 
   bool ready;
 
+  std::function<bool(const Message&)> filter;
+
+  static bool filter_fn(const void* _sample, void* _arg)
+  {
+    const DDSSubscribeHandler* handler =
+        static_cast<const DDSSubscribeHandler*>(_arg);
+    return handler->filter(*static_cast<const Message*>(_sample));
+  }
+
+  std::function<void()> data_available_callback;
+
+  static void data_available_fn(dds_entity_t, void* _arg)
+  {
+    DDSSubscribeHandler* handler = static_cast<DDSSubscribeHandler*>(_arg);
+    handler->data_available_callback();
+  }
+
+  std::function<void(dds_instance_handle_t)> deadline_missed_callback;
+
+  static void deadline_missed_fn(
+      dds_entity_t,
+      const dds_requested_deadline_missed_status_t _status,
+      void* _arg)
+  {
+    DDSSubscribeHandler* handler = static_cast<DDSSubscribeHandler*>(_arg);
+    handler->deadline_missed_callback(_status.last_instance_handle);
+  }
+
+  std::function<void(dds_instance_handle_t, bool)>
+      liveliness_changed_callback;
+
+  static void liveliness_changed_fn(
+      dds_entity_t,
+      const dds_liveliness_changed_status_t _status,
+      void* _arg)
+  {
+    DDSSubscribeHandler* handler = static_cast<DDSSubscribeHandler*>(_arg);
+    handler->liveliness_changed_callback(
+        _status.last_publication_handle, _status.alive_count_change > 0);
+  }
+
+  /// Installs a single DDS listener on the reader, for all the callbacks
+  /// that have been set, as setting a listener replaces the previous one.
+  void set_listener()
+  {
+    dds_listener_t* listener = dds_create_listener(this);
+    if (data_available_callback)
+      dds_lset_data_available(
+          listener, &DDSSubscribeHandler::data_available_fn);
+    if (deadline_missed_callback)
+      dds_lset_requested_deadline_missed(
+          listener, &DDSSubscribeHandler::deadline_missed_fn);
+    if (liveliness_changed_callback)
+      dds_lset_liveliness_changed(
+          listener, &DDSSubscribeHandler::liveliness_changed_fn);
+    const dds_return_t return_code = dds_set_listener(reader, listener);
+    if (return_code != DDS_RETCODE_OK)
+      DDS_FATAL("dds_set_listener: %s\n", dds_strretcode(-return_code));
+    dds_delete_listener(listener);
+  }
+
+  /// Keeps track of a batch of samples loaned from the DDS reader, the loan
+  /// is returned to the reader once this batch gets destroyed.
+  struct Loan
+  {
+    dds_entity_t reader;
+
+    std::vector<void*> samples;
+
+    std::vector<dds_sample_info_t> infos;
+
+    int32_t samples_num = 0;
+
+    Loan(dds_entity_t _reader, size_t _max_samples_num) :
+      reader(_reader),
+      samples(_max_samples_num, nullptr),
+      infos(_max_samples_num)
+    {}
+
+    ~Loan()
+    {
+      if (samples_num <= 0)
+        return;
+
+      dds_return_t loan_return_code =
+          dds_return_loan(reader, samples.data(), samples_num);
+      if (loan_return_code != DDS_RETCODE_OK)
+        DDS_FATAL("dds_return_loan: %s\n", dds_strretcode(-loan_return_code));
+    }
+  };
+
+  /// Takes a single batch of at most max_samples_num loaned samples, and
+  /// appends the valid ones to msgs, and their writers to writers if it is
+  /// not null.
+  ///
+  /// \return
+  ///   Number of samples taken from the reader, including invalid ones, or a
+  ///   negative return code if the take failed.
+  dds_return_t take_loaned_batch(
+      std::vector<std::shared_ptr<const Message>>& _msgs,
+      std::vector<dds_instance_handle_t>* _writers)
+  {
+    std::shared_ptr<Loan> loan(new Loan(reader, max_samples_num));
+    dds_return_t taken = dds_take(
+        reader, loan->samples.data(), loan->infos.data(), max_samples_num,
+        static_cast<uint32_t>(max_samples_num));
+    if (taken < 0)
+    {
+      DDS_FATAL("dds_take: %s\n", dds_strretcode(-taken));
+      return taken;
+    }
+    loan->samples_num = taken;
+
+    for (int32_t i = 0; i < taken; ++i)
+    {
+      if (!loan->infos[i].valid_data)
+        continue;
+      _msgs.push_back(
+          std::shared_ptr<const Message>(
+              loan, static_cast<const Message*>(loan->samples[i])));
+      if (_writers)
+        _writers->push_back(loan->infos[i].publication_handle);
+    }
+    return taken;
+  }
+
 public:
 
   DDSSubscribeHandler(
       const dds_entity_t& _participant, 
       const dds_topic_descriptor_t* _topic_desc, 
-      const std::string& _topic_name) :
-    topic_desc(_topic_desc)
+      const std::string& _topic_name,
+      size_t _max_samples_num = 1,
+      const QoSProfile& _qos_profile = QoSProfile()) :
+    topic_desc(_topic_desc),
+    max_samples_num(_max_samples_num > 0 ? _max_samples_num : 1),
+    shared_msgs(max_samples_num),
+    samples(max_samples_num, nullptr),
+    infos(max_samples_num)
   {
     ready = false;
 
@@ -70,8 +215,7 @@ public:
       return;
     }
 
-    dds_qos_t* qos = dds_create_qos();
-    dds_qset_reliability(qos, DDS_RELIABILITY_BEST_EFFORT, 0);
+    dds_qos_t* qos = common::dds_create_qos_from_profile(_qos_profile);
     reader = dds_create_reader(_participant, topic, qos, NULL);
     if (reader < 0)
     {
@@ -81,10 +225,13 @@ public:
     }
     dds_delete_qos(qos);
 
+    const dds_topic_descriptor_t* desc = topic_desc;
     for (size_t i = 0; i < shared_msgs.size(); ++i)
     {
-      shared_msgs[i] = std::shared_ptr<Message>((Message*)dds_alloc(sizeof(Message)));
-      samples[i] = (void*)shared_msgs[i].get();
+      shared_msgs[i] = std::shared_ptr<Message>(
+          static_cast<Message*>(dds_alloc(sizeof(Message))),
+          [desc](Message* msg) { dds_sample_free(msg, desc, DDS_FREE_ALL); });
+      samples[i] = static_cast<void*>(shared_msgs[i].get());
     }
 
     ready = true;
@@ -98,13 +245,43 @@ public:
     return ready;
   }
 
+  dds_entity_t get_reader() const
+  {
+    return reader;
+  }
+
+  size_t get_max_samples_num() const
+  {
+    return max_samples_num;
+  }
+
+  /// Installs a content filter on the topic of this handler, samples that
+  /// are rejected by the filter are dropped by DDS before they are stored in
+  /// the reader, and will never be returned by any of the read functions.
+  ///
+  /// \param[in] filter
+  ///   Returns true if the sample should be delivered, an empty function
+  ///   removes the filter.
+  void set_filter(std::function<bool(const Message&)> _filter)
+  {
+    if (!is_ready())
+      return;
+
+    filter = std::move(_filter);
+    dds_set_topic_filter_and_arg(
+        topic, filter ? &DDSSubscribeHandler::filter_fn : NULL, this);
+  }
+
   std::vector<std::shared_ptr<const Message>> read()
   {
     std::vector<std::shared_ptr<const Message>> msgs;
     if (!is_ready())
       return msgs;
 
-    return_code = dds_take(reader, samples, infos, MaxSamplesNum, MaxSamplesNum);
+    std::lock_guard<std::mutex> lock(read_mutex);
+    const dds_return_t return_code = dds_take(
+        reader, samples.data(), infos.data(), max_samples_num,
+        static_cast<uint32_t>(max_samples_num));
     if (return_code < 0)
     {
       DDS_FATAL("dds_take: %s\n", dds_strretcode(-return_code));
@@ -112,19 +289,108 @@ public:
       return msgs;
     }
     
-    if (return_code > 0)
+    for (int32_t i = 0; i < return_code; ++i)
     {
-      for (size_t i = 0; i < MaxSamplesNum; ++i)
-      {
-        if (infos[i].valid_data == true)
-          msgs.push_back(std::shared_ptr<const Message>(shared_msgs[i]));
-      }
-      return msgs;
+      if (infos[i].valid_data == true)
+        msgs.push_back(std::shared_ptr<const Message>(shared_msgs[i]));
     }
-    msgs.clear();
     return msgs;
   }
 
+  /// Installs a DDS listener on the reader, which calls the callback on a DDS
+  /// thread whenever new samples are available. The callback is expected to
+  /// take the samples and return quickly, as it blocks further deliveries.
+  ///
+  /// \param[in] callback
+  ///   Function to be called when new samples are available.
+  void set_data_available_callback(std::function<void()> _callback)
+  {
+    if (!is_ready())
+      return;
+
+    data_available_callback = std::move(_callback);
+    set_listener();
+  }
+
+  /// Calls the callback on a DDS thread whenever an instance of the reader
+  /// did not receive a new sample within the deadline of its QoS profile.
+  ///
+  /// \param[in] callback
+  ///   Function to be called with the handle of the instance that missed its
+  ///   deadline.
+  void set_deadline_missed_callback(
+      std::function<void(dds_instance_handle_t)> _callback)
+  {
+    if (!is_ready())
+      return;
+
+    deadline_missed_callback = std::move(_callback);
+    set_listener();
+  }
+
+  /// Calls the callback on a DDS thread whenever a writer matched with the
+  /// reader becomes alive, or stops being alive, either because its
+  /// liveliness lease expired or because it was deleted.
+  ///
+  /// \param[in] callback
+  ///   Function to be called with the handle of the writer, and whether it
+  ///   became alive.
+  void set_liveliness_changed_callback(
+      std::function<void(dds_instance_handle_t, bool)> _callback)
+  {
+    if (!is_ready())
+      return;
+
+    liveliness_changed_callback = std::move(_callback);
+    set_listener();
+  }
+
+  /// Takes new incoming samples using memory loaned from the DDS reader,
+  /// instead of copying them into the preallocated samples used by read().
+  /// Each returned message is a read-only view into the loan, and the loan is
+  /// only returned to the reader when the last view of the batch is
+  /// destroyed, which has to happen before this handler gets destroyed.
+  ///
+  /// \return
+  ///   Read-only views of the valid samples that were taken.
+  std::vector<std::shared_ptr<const Message>> take_loaned()
+  {
+    std::vector<std::shared_ptr<const Message>> msgs;
+    if (!is_ready())
+      return msgs;
+
+    msgs.reserve(max_samples_num);
+    take_loaned_batch(msgs, nullptr);
+    return msgs;
+  }
+
+  /// Keeps taking loaned batches of samples until the reader is empty,
+  /// appending the read-only views to the provided vector. See take_loaned()
+  /// regarding the lifetime of the views.
+  ///
+  /// \param[out] msgs
+  ///   Vector that the valid samples will be appended to.
+  /// \param[out] writers
+  ///   Vector that the instance handles of the writers of the valid samples
+  ///   will be appended to, in the same order, if it is not null.
+  /// \return
+  ///   Number of views appended to msgs.
+  size_t take_all_loaned(
+      std::vector<std::shared_ptr<const Message>>& _msgs,
+      std::vector<dds_instance_handle_t>* _writers = nullptr)
+  {
+    if (!is_ready())
+      return 0;
+
+    const size_t initial_size = _msgs.size();
+    dds_return_t taken;
+    do
+    {
+      taken = take_loaned_batch(_msgs, _writers);
+    } while (taken == static_cast<dds_return_t>(max_samples_num));
+    return _msgs.size() - initial_size;
+  }
+
 };
 
 } // namespace dds
@@ -0,0 +1,179 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef FREE_FLEET__SRC__DDS_UTILS__SAMPLEARENA_HPP
+#define FREE_FLEET__SRC__DDS_UTILS__SAMPLEARENA_HPP
+
+#include <new>
+#include <algorithm>
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <type_traits>
+
+namespace free_fleet {
+namespace dds {
+
+/// Bump allocator that backs the strings and sequences of outgoing DDS
+/// samples, which only need to live until dds_write returns, as the sample
+/// is serialized during the write. All the memory handed out is released at
+/// once by reset, which keeps the memory around for the next sample.
+///
+/// Samples built in an arena must never be freed with dds_sample_free, or
+/// any of the other DDS free functions. Their sequences are marked as not
+/// owning their buffers, but their strings are not, and would be passed on
+/// to dds_free.
+class SampleArena
+{
+public:
+
+  SampleArena(size_t _initial_capacity = 4096) :
+    block(nullptr),
+    block_size(0),
+    offset(0),
+    overflow_size(0)
+  {
+    grow(_initial_capacity);
+  }
+
+  ~SampleArena()
+  {
+    release_overflow();
+    std::free(block);
+  }
+
+  SampleArena(const SampleArena&) = delete;
+
+  SampleArena& operator=(const SampleArena&) = delete;
+
+  /// Allocates memory that stays valid until the next reset.
+  void* allocate(
+      size_t _size, size_t _alignment = alignof(std::max_align_t))
+  {
+    size_t aligned_offset = (offset + _alignment - 1) & ~(_alignment - 1);
+    if (aligned_offset + _size > block_size)
+    {
+      // The current block is kept until the next reset, as earlier
+      // allocations still point into it
+      overflow.push_back(block);
+      overflow_size += block_size;
+      grow(std::max(block_size * 2, _size + _alignment));
+      aligned_offset = 0;
+    }
+    offset = aligned_offset + _size;
+    return block + aligned_offset;
+  }
+
+  /// Copies the string into a null terminated string in the arena.
+  char* copy_string(const std::string& _str)
+  {
+    char* ptr = static_cast<char*>(allocate(_str.length() + 1, 1));
+    std::memcpy(ptr, _str.c_str(), _str.length() + 1);
+    return ptr;
+  }
+
+  /// Same interface as common::dds_string_assign, the previous string of
+  /// the destination is not freed, as it belongs to the arena or is null.
+  void assign_string(char*& _dst, const std::string& _src)
+  {
+    _dst = copy_string(_src);
+  }
+
+  /// Same interface as common::dds_sequence_resize, allocates a zero
+  /// initialized buffer for the sequence in the arena. The sequence is
+  /// marked as not owning its buffer, so that DDS never frees it.
+  template <typename Sequence>
+  void resize_sequence(Sequence& _seq, size_t _length)
+  {
+    using Element =
+        typename std::remove_pointer<decltype(_seq._buffer)>::type;
+
+    const size_t size = _length * sizeof(Element);
+    void* buffer = allocate(size > 0 ? size : 1, alignof(Element));
+    std::memset(buffer, 0, size);
+    _seq._buffer = static_cast<Element*>(buffer);
+    _seq._maximum = static_cast<uint32_t>(_length);
+    _seq._length = static_cast<uint32_t>(_length);
+    _seq._release = false;
+  }
+
+  /// Releases everything allocated from the arena. If the arena had to grow
+  /// since the last reset, its blocks are replaced by a single block large
+  /// enough to hold all of them, so that it does not need to grow again for
+  /// samples of the same size.
+  void reset()
+  {
+    if (!overflow.empty())
+    {
+      const size_t total_size = overflow_size + block_size;
+      release_overflow();
+      std::free(block);
+      block = nullptr;
+      grow(total_size);
+    }
+    offset = 0;
+  }
+
+  /// Size of the current block of the arena.
+  size_t capacity() const
+  {
+    return block_size;
+  }
+
+  /// Number of bytes handed out from the current block.
+  size_t used() const
+  {
+    return offset;
+  }
+
+private:
+
+  void grow(size_t _size)
+  {
+    block = static_cast<char*>(std::malloc(_size));
+    if (!block)
+      throw std::bad_alloc();
+    block_size = _size;
+    offset = 0;
+  }
+
+  void release_overflow()
+  {
+    for (char* old_block : overflow)
+      std::free(old_block);
+    overflow.clear();
+    overflow_size = 0;
+  }
+
+  char* block;
+
+  size_t block_size;
+
+  size_t offset;
+
+  std::vector<char*> overflow;
+
+  size_t overflow_size;
+};
+
+} // namespace dds
+} // namespace free_fleet
+
+#endif // FREE_FLEET__SRC__DDS_UTILS__SAMPLEARENA_HPP
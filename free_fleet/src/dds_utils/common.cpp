@@ -17,19 +17,168 @@
 
 #include "common.hpp"
 
-#include <dds/dds.h>
-
 namespace free_fleet {
 namespace common {
 
 char* dds_string_alloc_and_copy(const std::string& _str)
 {
   char* ptr = dds_string_alloc(_str.length());
-  for (size_t i = 0; i < _str.length(); ++i)
+  std::memcpy(ptr, _str.c_str(), _str.length() + 1);
+  return ptr;
+}
+
+size_t DdsStringCapacities::capacity(const char* _str) const
+{
+  for (const auto& entry : capacities)
   {
-    ptr[i] = _str[i];
+    if (entry.first == _str)
+      return entry.second;
   }
-  return ptr;
+  return std::strlen(_str);
+}
+
+void DdsStringCapacities::set(const char* _str, size_t _capacity)
+{
+  for (auto& entry : capacities)
+  {
+    if (entry.first == _str)
+    {
+      entry.second = _capacity;
+      return;
+    }
+  }
+  capacities.emplace_back(_str, _capacity);
+}
+
+void DdsStringCapacities::erase(const char* _str)
+{
+  for (auto& entry : capacities)
+  {
+    if (entry.first == _str)
+    {
+      entry = capacities.back();
+      capacities.pop_back();
+      return;
+    }
+  }
+}
+
+void dds_string_assign(
+    char*& _dst, const std::string& _src, DdsStringCapacities* _capacities)
+{
+  const size_t length = _src.length();
+  if (!_dst ||
+      (_capacities ? _capacities->capacity(_dst) : std::strlen(_dst)) < length)
+  {
+    if (_capacities && _dst)
+      _capacities->erase(_dst);
+    dds_free(_dst);
+    _dst = dds_string_alloc(length);
+    if (_capacities)
+      _capacities->set(_dst, length);
+  }
+  std::memcpy(_dst, _src.c_str(), length + 1);
+}
+
+dds_qos_t* dds_create_qos_from_profile(const QoSProfile& _profile)
+{
+  dds_qos_t* qos = dds_create_qos();
+
+  if (_profile.reliability == QoSProfile::Reliability::RELIABLE)
+    dds_qset_reliability(qos, DDS_RELIABILITY_RELIABLE, DDS_MSECS(100));
+  else
+    dds_qset_reliability(qos, DDS_RELIABILITY_BEST_EFFORT, 0);
+
+  if (_profile.history == QoSProfile::History::KEEP_ALL)
+    dds_qset_history(qos, DDS_HISTORY_KEEP_ALL, 0);
+  else
+    dds_qset_history(
+        qos, DDS_HISTORY_KEEP_LAST,
+        _profile.history_depth > 0 ? _profile.history_depth : 1);
+
+  if (_profile.durability == QoSProfile::Durability::TRANSIENT_LOCAL)
+    dds_qset_durability(qos, DDS_DURABILITY_TRANSIENT_LOCAL);
+  else
+    dds_qset_durability(qos, DDS_DURABILITY_VOLATILE);
+
+  if (_profile.deadline > 0.0)
+    dds_qset_deadline(
+        qos, static_cast<dds_duration_t>(_profile.deadline * 1e9));
+
+  if (_profile.liveliness_lease_duration > 0.0)
+    dds_qset_liveliness(
+        qos, DDS_LIVELINESS_AUTOMATIC,
+        static_cast<dds_duration_t>(_profile.liveliness_lease_duration * 1e9));
+
+  if (_profile.latency_budget > 0.0)
+    dds_qset_latency_budget(
+        qos, static_cast<dds_duration_t>(_profile.latency_budget * 1e9));
+
+  dds_qset_transport_priority(qos, _profile.transport_priority);
+  return qos;
+}
+
+dds_entity_t dds_create_read_waitset(
+    dds_entity_t _participant, const std::vector<dds_entity_t>& _readers)
+{
+  dds_entity_t waitset = dds_create_waitset(_participant);
+  if (waitset < 0)
+  {
+    DDS_FATAL("dds_create_waitset: %s\n", dds_strretcode(-waitset));
+    return waitset;
+  }
+
+  for (const dds_entity_t reader : _readers)
+  {
+    dds_entity_t read_condition =
+        dds_create_readcondition(reader, DDS_ANY_STATE);
+    if (read_condition < 0)
+    {
+      DDS_FATAL(
+          "dds_create_readcondition: %s\n", dds_strretcode(-read_condition));
+      return read_condition;
+    }
+
+    dds_return_t return_code =
+        dds_waitset_attach(waitset, read_condition, read_condition);
+    if (return_code != DDS_RETCODE_OK)
+    {
+      DDS_FATAL("dds_waitset_attach: %s\n", dds_strretcode(-return_code));
+      return return_code;
+    }
+  }
+  return waitset;
+}
+
+bool dds_get_matched_user_data(
+    dds_entity_t _reader, dds_instance_handle_t _publication,
+    std::string& _user_data)
+{
+  dds_builtintopic_endpoint_t* endpoint =
+      dds_get_matched_publication_data(_reader, _publication);
+  if (!endpoint)
+    return false;
+
+  void* value = nullptr;
+  size_t size = 0;
+  const bool found =
+      dds_qget_userdata(endpoint->qos, &value, &size) && value && size > 0;
+  if (found)
+    _user_data.assign(static_cast<const char*>(value), size);
+  dds_free(value);
+  dds_builtintopic_free_endpoint(endpoint);
+  return found;
+}
+
+bool dds_wait(dds_entity_t _waitset, dds_duration_t _timeout)
+{
+  dds_return_t return_code = dds_waitset_wait(_waitset, NULL, 0, _timeout);
+  if (return_code < 0)
+  {
+    DDS_FATAL("dds_waitset_wait: %s\n", dds_strretcode(-return_code));
+    return false;
+  }
+  return return_code > 0;
 }
 
 } // namespace common
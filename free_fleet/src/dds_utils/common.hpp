@@ -19,12 +19,140 @@
 #define FREEFLEET__SRC__DDS_UTILS__COMMON_HPP
 
 #include <string>
+#include <vector>
+#include <cstring>
+#include <utility>
+#include <type_traits>
+
+#include <dds/dds.h>
+
+#include <free_fleet/QoSProfile.hpp>
 
 namespace free_fleet {
 namespace common {
 
 char* dds_string_alloc_and_copy(const std::string& str);
 
+/// Capacities of the strings of a DDS sample that is converted into over and
+/// over, as DDS strings do not record the size of their buffer. These are
+/// kept next to the sample by its owner, and passed to the conversions into
+/// the sample. Entries are only removed when dds_string_assign replaces a
+/// buffer, so the capacities need to be destroyed together with the sample.
+class DdsStringCapacities
+{
+public:
+
+  /// Capacity of the string buffer, which is taken to be its length if the
+  /// buffer was not allocated with these capacities.
+  size_t capacity(const char* str) const;
+
+  void set(const char* str, size_t capacity);
+
+  void erase(const char* str);
+
+private:
+
+  /// A sample only has a handful of strings, which are searched faster in
+  /// order than through a hash map.
+  std::vector<std::pair<const char*, size_t>> capacities;
+};
+
+/// Copies the string into a DDS string, reusing the existing buffer of the
+/// DDS string when it is large enough to hold the new contents.
+///
+/// \param[in,out] dst
+///   DDS string to be assigned, which is either null or allocated by DDS.
+/// \param[in] src
+///   String to be copied.
+/// \param[in,out] capacities
+///   Capacities of the strings of the sample that dst belongs to, with which
+///   the buffer grows but never shrinks. Without them, the capacity of the
+///   buffer is only known to be the length of its current contents.
+void dds_string_assign(
+    char*& dst, const std::string& src,
+    DdsStringCapacities* capacities = nullptr);
+
+/// Sets the length of a DDS sequence, growing its buffer if required. The
+/// buffer never shrinks, and elements beyond the new length are kept intact
+/// so that their nested allocations can be reused when the sequence grows
+/// again. Newly allocated elements are zero initialized.
+///
+/// \param[in,out] seq
+///   DDS sequence to be resized, which is either zero initialized or
+///   allocated by DDS.
+/// \param[in] length
+///   New length of the sequence.
+template <typename Sequence>
+void dds_sequence_resize(Sequence& seq, size_t length)
+{
+  using Element = typename std::remove_pointer<decltype(seq._buffer)>::type;
+
+  if (seq._maximum < length)
+  {
+    Element* buffer = static_cast<Element*>(
+        dds_realloc(seq._buffer, length * sizeof(Element)));
+    std::memset(
+        static_cast<void*>(buffer + seq._maximum), 0,
+        (length - seq._maximum) * sizeof(Element));
+    seq._buffer = buffer;
+    seq._maximum = static_cast<uint32_t>(length);
+  }
+  seq._length = static_cast<uint32_t>(length);
+  seq._release = true;
+}
+
+/// Copies a string into the fixed size buffer of a DDS bounded string,
+/// truncating it if it does not fit. The buffer is always null terminated.
+///
+/// \param[out] dst
+///   Character array of the bounded string, including the null terminator.
+/// \param[in] src
+///   String to be copied.
+template <size_t N>
+void dds_bounded_string_copy(char (&dst)[N], const std::string& src)
+{
+  const size_t length = src.length() < N - 1 ? src.length() : N - 1;
+  std::memcpy(dst, src.data(), length);
+  dst[length] = '\0';
+}
+
+/// Creates a new DDS QoS with the settings of the profile, which needs to be
+/// deleted by the caller using dds_delete_qos.
+dds_qos_t* dds_create_qos_from_profile(const QoSProfile& profile);
+
+/// Creates a waitset on the participant, with a read condition attached for
+/// each of the readers, which triggers whenever any of the readers has
+/// samples available.
+///
+/// \param[in] participant
+///   DDS participant that will own the waitset.
+/// \param[in] readers
+///   DDS readers to be waited on.
+/// \return
+///   The waitset entity, or a negative return code on failure.
+dds_entity_t dds_create_read_waitset(
+    dds_entity_t participant, const std::vector<dds_entity_t>& readers);
+
+/// Looks up the user data of a writer that is matched with the reader.
+///
+/// \param[in] reader
+///   DDS reader that the writer is matched with.
+/// \param[in] publication
+///   Instance handle of the matched writer.
+/// \param[out] user_data
+///   User data of the writer.
+/// \return
+///   True if the writer is matched with the reader and has user data.
+bool dds_get_matched_user_data(
+    dds_entity_t reader, dds_instance_handle_t publication,
+    std::string& user_data);
+
+/// Blocks until the waitset is triggered or the timeout passes.
+///
+/// \return
+///   True if the waitset was triggered, false otherwise.
+bool dds_wait(dds_entity_t waitset, dds_duration_t timeout);
+
 } // namespace common
 } // namespace free_fleet
 
@@ -54,9 +54,14 @@ const dds_topic_descriptor_t FreeFleetData_Location_desc =
 };
 
 
+static const dds_key_descriptor_t FreeFleetData_RobotState_keys[1] =
+{
+  { "name", 0 }
+};
+
 static const uint32_t FreeFleetData_RobotState_ops [] =
 {
-  DDS_OP_ADR | DDS_OP_TYPE_STR, offsetof (FreeFleetData_RobotState, name),
+  DDS_OP_ADR | DDS_OP_TYPE_STR | DDS_OP_FLAG_KEY, offsetof (FreeFleetData_RobotState, name),
   DDS_OP_ADR | DDS_OP_TYPE_STR, offsetof (FreeFleetData_RobotState, model),
   DDS_OP_ADR | DDS_OP_TYPE_STR, offsetof (FreeFleetData_RobotState, task_id),
   DDS_OP_ADR | DDS_OP_TYPE_4BY, offsetof (FreeFleetData_RobotState, mode.mode),
@@ -84,9 +89,9 @@ const dds_topic_descriptor_t FreeFleetData_RobotState_desc =
   sizeof (FreeFleetData_RobotState),
   sizeof (char *),
   DDS_TOPIC_NO_OPTIMIZE,
-  0u,
+  1u,
   "FreeFleetData::RobotState",
-  NULL,
+  FreeFleetData_RobotState_keys,
   21,
   FreeFleetData_RobotState_ops,
   "<MetaData version=\"1.0.0\"><Module name=\"FreeFleetData\"><Struct name=\"RobotMode\"><Member name=\"mode\"><ULong/></Member></Struct><Struct name=\"Location\"><Member name=\"sec\"><Long/></Member><Member name=\"nanosec\"><ULong/></Member><Member name=\"x\"><Float/></Member><Member name=\"y\"><Float/></Member><Member name=\"yaw\"><Float/></Member><Member name=\"level_name\"><String/></Member></Struct><Struct name=\"RobotState\"><Member name=\"name\"><String/></Member><Member name=\"model\"><String/></Member><Member name=\"task_id\"><String/></Member><Member name=\"mode\"><Type name=\"RobotMode\"/></Member><Member name=\"battery_percent\"><Float/></Member><Member name=\"location\"><Type name=\"Location\"/></Member><Member name=\"path\"><Sequence><Type name=\"Location\"/></Sequence></Member></Struct></Module></MetaData>"
@@ -199,3 +204,545 @@ const dds_topic_descriptor_t FreeFleetData_DestinationRequest_desc =
   FreeFleetData_DestinationRequest_ops,
   "<MetaData version=\"1.0.0\"><Module name=\"FreeFleetData\"><Struct name=\"Location\"><Member name=\"sec\"><Long/></Member><Member name=\"nanosec\"><ULong/></Member><Member name=\"x\"><Float/></Member><Member name=\"y\"><Float/></Member><Member name=\"yaw\"><Float/></Member><Member name=\"level_name\"><String/></Member></Struct><Struct name=\"DestinationRequest\"><Member name=\"fleet_name\"><String/></Member><Member name=\"robot_name\"><String/></Member><Member name=\"destination\"><Type name=\"Location\"/></Member><Member name=\"task_id\"><String/></Member></Struct></Module></MetaData>"
 };
+
+
+static const uint32_t FreeFleetData_FlatLocation_ops [] =
+{
+  DDS_OP_ADR | DDS_OP_TYPE_4BY, offsetof (FreeFleetData_FlatLocation, sec),
+  DDS_OP_ADR | DDS_OP_TYPE_4BY, offsetof (FreeFleetData_FlatLocation, nanosec),
+  DDS_OP_ADR | DDS_OP_TYPE_4BY, offsetof (FreeFleetData_FlatLocation, x),
+  DDS_OP_ADR | DDS_OP_TYPE_4BY, offsetof (FreeFleetData_FlatLocation, y),
+  DDS_OP_ADR | DDS_OP_TYPE_4BY, offsetof (FreeFleetData_FlatLocation, yaw),
+  DDS_OP_ADR | DDS_OP_TYPE_BST, offsetof (FreeFleetData_FlatLocation, level_name), 64,
+  DDS_OP_RTS
+};
+
+const dds_topic_descriptor_t FreeFleetData_FlatLocation_desc =
+{
+  sizeof (FreeFleetData_FlatLocation),
+  4u,
+  0u,
+  0u,
+  "FreeFleetData::FlatLocation",
+  NULL,
+  7,
+  FreeFleetData_FlatLocation_ops,
+  "<MetaData version=\"1.0.0\"><Module name=\"FreeFleetData\"><Struct name=\"FlatLocation\"><Member name=\"sec\"><Long/></Member><Member name=\"nanosec\"><ULong/></Member><Member name=\"x\"><Float/></Member><Member name=\"y\"><Float/></Member><Member name=\"yaw\"><Float/></Member><Member name=\"level_name\"><String length=\"63\"/></Member></Struct></Module></MetaData>"
+};
+
+
+static const dds_key_descriptor_t FreeFleetData_FlatRobotState_keys[1] =
+{
+  { "name", 0 }
+};
+
+static const uint32_t FreeFleetData_FlatRobotState_ops [] =
+{
+  DDS_OP_ADR | DDS_OP_TYPE_BST | DDS_OP_FLAG_KEY, offsetof (FreeFleetData_FlatRobotState, name), 64,
+  DDS_OP_ADR | DDS_OP_TYPE_BST, offsetof (FreeFleetData_FlatRobotState, model), 64,
+  DDS_OP_ADR | DDS_OP_TYPE_BST, offsetof (FreeFleetData_FlatRobotState, task_id), 64,
+  DDS_OP_ADR | DDS_OP_TYPE_4BY, offsetof (FreeFleetData_FlatRobotState, mode.mode),
+  DDS_OP_ADR | DDS_OP_TYPE_4BY, offsetof (FreeFleetData_FlatRobotState, battery_percent),
+  DDS_OP_ADR | DDS_OP_TYPE_4BY, offsetof (FreeFleetData_FlatRobotState, location.sec),
+  DDS_OP_ADR | DDS_OP_TYPE_4BY, offsetof (FreeFleetData_FlatRobotState, location.nanosec),
+  DDS_OP_ADR | DDS_OP_TYPE_4BY, offsetof (FreeFleetData_FlatRobotState, location.x),
+  DDS_OP_ADR | DDS_OP_TYPE_4BY, offsetof (FreeFleetData_FlatRobotState, location.y),
+  DDS_OP_ADR | DDS_OP_TYPE_4BY, offsetof (FreeFleetData_FlatRobotState, location.yaw),
+  DDS_OP_ADR | DDS_OP_TYPE_BST, offsetof (FreeFleetData_FlatRobotState, location.level_name), 64,
+  DDS_OP_ADR | DDS_OP_TYPE_4BY, offsetof (FreeFleetData_FlatRobotState, path_length),
+  DDS_OP_ADR | DDS_OP_TYPE_ARR | DDS_OP_SUBTYPE_STU, offsetof (FreeFleetData_FlatRobotState, path),
+  64, (19u << 16u) + 5u, sizeof (FreeFleetData_FlatLocation),
+  DDS_OP_ADR | DDS_OP_TYPE_4BY, offsetof (FreeFleetData_FlatLocation, sec),
+  DDS_OP_ADR | DDS_OP_TYPE_4BY, offsetof (FreeFleetData_FlatLocation, nanosec),
+  DDS_OP_ADR | DDS_OP_TYPE_4BY, offsetof (FreeFleetData_FlatLocation, x),
+  DDS_OP_ADR | DDS_OP_TYPE_4BY, offsetof (FreeFleetData_FlatLocation, y),
+  DDS_OP_ADR | DDS_OP_TYPE_4BY, offsetof (FreeFleetData_FlatLocation, yaw),
+  DDS_OP_ADR | DDS_OP_TYPE_BST, offsetof (FreeFleetData_FlatLocation, level_name), 64,
+  DDS_OP_RTS,
+  DDS_OP_RTS
+};
+
+const dds_topic_descriptor_t FreeFleetData_FlatRobotState_desc =
+{
+  sizeof (FreeFleetData_FlatRobotState),
+  4u,
+  0u,
+  1u,
+  "FreeFleetData::FlatRobotState",
+  FreeFleetData_FlatRobotState_keys,
+  22,
+  FreeFleetData_FlatRobotState_ops,
+  "<MetaData version=\"1.0.0\"><Module name=\"FreeFleetData\"><Struct name=\"RobotMode\"><Member name=\"mode\"><ULong/></Member></Struct><Struct name=\"FlatLocation\"><Member name=\"sec\"><Long/></Member><Member name=\"nanosec\"><ULong/></Member><Member name=\"x\"><Float/></Member><Member name=\"y\"><Float/></Member><Member name=\"yaw\"><Float/></Member><Member name=\"level_name\"><String length=\"63\"/></Member></Struct><Struct name=\"FlatRobotState\"><Member name=\"name\"><String length=\"63\"/></Member><Member name=\"model\"><String length=\"63\"/></Member><Member name=\"task_id\"><String length=\"63\"/></Member><Member name=\"mode\"><Type name=\"RobotMode\"/></Member><Member name=\"battery_percent\"><Float/></Member><Member name=\"location\"><Type name=\"FlatLocation\"/></Member><Member name=\"path_length\"><ULong/></Member><Member name=\"path\"><Array size=\"64\"><Type name=\"FlatLocation\"/></Array></Member></Struct></Module></MetaData>"
+};
+
+
+static const uint32_t FreeFleetData_FlatPathRequest_ops [] =
+{
+  DDS_OP_ADR | DDS_OP_TYPE_BST, offsetof (FreeFleetData_FlatPathRequest, fleet_name), 64,
+  DDS_OP_ADR | DDS_OP_TYPE_BST, offsetof (FreeFleetData_FlatPathRequest, robot_name), 64,
+  DDS_OP_ADR | DDS_OP_TYPE_4BY, offsetof (FreeFleetData_FlatPathRequest, path_length),
+  DDS_OP_ADR | DDS_OP_TYPE_ARR | DDS_OP_SUBTYPE_STU, offsetof (FreeFleetData_FlatPathRequest, path),
+  64, (19u << 16u) + 5u, sizeof (FreeFleetData_FlatLocation),
+  DDS_OP_ADR | DDS_OP_TYPE_4BY, offsetof (FreeFleetData_FlatLocation, sec),
+  DDS_OP_ADR | DDS_OP_TYPE_4BY, offsetof (FreeFleetData_FlatLocation, nanosec),
+  DDS_OP_ADR | DDS_OP_TYPE_4BY, offsetof (FreeFleetData_FlatLocation, x),
+  DDS_OP_ADR | DDS_OP_TYPE_4BY, offsetof (FreeFleetData_FlatLocation, y),
+  DDS_OP_ADR | DDS_OP_TYPE_4BY, offsetof (FreeFleetData_FlatLocation, yaw),
+  DDS_OP_ADR | DDS_OP_TYPE_BST, offsetof (FreeFleetData_FlatLocation, level_name), 64,
+  DDS_OP_RTS,
+  DDS_OP_ADR | DDS_OP_TYPE_BST, offsetof (FreeFleetData_FlatPathRequest, task_id), 64,
+  DDS_OP_RTS
+};
+
+const dds_topic_descriptor_t FreeFleetData_FlatPathRequest_desc =
+{
+  sizeof (FreeFleetData_FlatPathRequest),
+  4u,
+  0u,
+  0u,
+  "FreeFleetData::FlatPathRequest",
+  NULL,
+  14,
+  FreeFleetData_FlatPathRequest_ops,
+  "<MetaData version=\"1.0.0\"><Module name=\"FreeFleetData\"><Struct name=\"FlatLocation\"><Member name=\"sec\"><Long/></Member><Member name=\"nanosec\"><ULong/></Member><Member name=\"x\"><Float/></Member><Member name=\"y\"><Float/></Member><Member name=\"yaw\"><Float/></Member><Member name=\"level_name\"><String length=\"63\"/></Member></Struct><Struct name=\"FlatPathRequest\"><Member name=\"fleet_name\"><String length=\"63\"/></Member><Member name=\"robot_name\"><String length=\"63\"/></Member><Member name=\"path_length\"><ULong/></Member><Member name=\"path\"><Array size=\"64\"><Type name=\"FlatLocation\"/></Array></Member><Member name=\"task_id\"><String length=\"63\"/></Member></Struct></Module></MetaData>"
+};
+
+
+static const uint32_t FreeFleetData_CompactPath_ops [] =
+{
+  DDS_OP_ADR | DDS_OP_TYPE_4BY, offsetof (FreeFleetData_CompactPath, base_sec),
+  DDS_OP_ADR | DDS_OP_TYPE_4BY, offsetof (FreeFleetData_CompactPath, base_nanosec),
+  DDS_OP_ADR | DDS_OP_TYPE_4BY, offsetof (FreeFleetData_CompactPath, origin_x),
+  DDS_OP_ADR | DDS_OP_TYPE_4BY, offsetof (FreeFleetData_CompactPath, origin_y),
+  DDS_OP_ADR | DDS_OP_TYPE_4BY, offsetof (FreeFleetData_CompactPath, origin_yaw),
+  DDS_OP_ADR | DDS_OP_TYPE_4BY, offsetof (FreeFleetData_CompactPath, position_resolution),
+  DDS_OP_ADR | DDS_OP_TYPE_4BY, offsetof (FreeFleetData_CompactPath, yaw_resolution),
+  DDS_OP_ADR | DDS_OP_TYPE_4BY, offsetof (FreeFleetData_CompactPath, time_resolution_msec),
+  DDS_OP_ADR | DDS_OP_TYPE_SEQ | DDS_OP_SUBTYPE_2BY, offsetof (FreeFleetData_CompactPath, dt),
+  DDS_OP_ADR | DDS_OP_TYPE_SEQ | DDS_OP_SUBTYPE_2BY, offsetof (FreeFleetData_CompactPath, dx),
+  DDS_OP_ADR | DDS_OP_TYPE_SEQ | DDS_OP_SUBTYPE_2BY, offsetof (FreeFleetData_CompactPath, dy),
+  DDS_OP_ADR | DDS_OP_TYPE_SEQ | DDS_OP_SUBTYPE_2BY, offsetof (FreeFleetData_CompactPath, dyaw),
+  DDS_OP_ADR | DDS_OP_TYPE_SEQ | DDS_OP_SUBTYPE_STR, offsetof (FreeFleetData_CompactPath, level_names),
+  DDS_OP_ADR | DDS_OP_TYPE_SEQ | DDS_OP_SUBTYPE_4BY, offsetof (FreeFleetData_CompactPath, level_run_start),
+  DDS_OP_ADR | DDS_OP_TYPE_SEQ | DDS_OP_SUBTYPE_1BY, offsetof (FreeFleetData_CompactPath, level_run_index),
+  DDS_OP_RTS
+};
+
+const dds_topic_descriptor_t FreeFleetData_CompactPath_desc =
+{
+  sizeof (FreeFleetData_CompactPath),
+  sizeof (char *),
+  DDS_TOPIC_NO_OPTIMIZE,
+  0u,
+  "FreeFleetData::CompactPath",
+  NULL,
+  16,
+  FreeFleetData_CompactPath_ops,
+  "<MetaData version=\"1.0.0\"><Module name=\"FreeFleetData\"><Struct name=\"CompactPath\"><Member name=\"base_sec\"><Long/></Member><Member name=\"base_nanosec\"><ULong/></Member><Member name=\"origin_x\"><Float/></Member><Member name=\"origin_y\"><Float/></Member><Member name=\"origin_yaw\"><Float/></Member><Member name=\"position_resolution\"><Float/></Member><Member name=\"yaw_resolution\"><Float/></Member><Member name=\"time_resolution_msec\"><ULong/></Member><Member name=\"dt\"><Sequence><Short/></Sequence></Member><Member name=\"dx\"><Sequence><Short/></Sequence></Member><Member name=\"dy\"><Sequence><Short/></Sequence></Member><Member name=\"dyaw\"><Sequence><Short/></Sequence></Member><Member name=\"level_names\"><Sequence><String/></Sequence></Member><Member name=\"level_run_start\"><Sequence><ULong/></Sequence></Member><Member name=\"level_run_index\"><Sequence><Octet/></Sequence></Member></Struct></Module></MetaData>"
+};
+
+
+static const dds_key_descriptor_t FreeFleetData_CompactRobotState_keys[1] =
+{
+  { "name", 0 }
+};
+
+static const uint32_t FreeFleetData_CompactRobotState_ops [] =
+{
+  DDS_OP_ADR | DDS_OP_TYPE_STR | DDS_OP_FLAG_KEY, offsetof (FreeFleetData_CompactRobotState, name),
+  DDS_OP_ADR | DDS_OP_TYPE_STR, offsetof (FreeFleetData_CompactRobotState, model),
+  DDS_OP_ADR | DDS_OP_TYPE_STR, offsetof (FreeFleetData_CompactRobotState, task_id),
+  DDS_OP_ADR | DDS_OP_TYPE_4BY, offsetof (FreeFleetData_CompactRobotState, mode.mode),
+  DDS_OP_ADR | DDS_OP_TYPE_4BY, offsetof (FreeFleetData_CompactRobotState, battery_percent),
+  DDS_OP_ADR | DDS_OP_TYPE_4BY, offsetof (FreeFleetData_CompactRobotState, location.sec),
+  DDS_OP_ADR | DDS_OP_TYPE_4BY, offsetof (FreeFleetData_CompactRobotState, location.nanosec),
+  DDS_OP_ADR | DDS_OP_TYPE_4BY, offsetof (FreeFleetData_CompactRobotState, location.x),
+  DDS_OP_ADR | DDS_OP_TYPE_4BY, offsetof (FreeFleetData_CompactRobotState, location.y),
+  DDS_OP_ADR | DDS_OP_TYPE_4BY, offsetof (FreeFleetData_CompactRobotState, location.yaw),
+  DDS_OP_ADR | DDS_OP_TYPE_STR, offsetof (FreeFleetData_CompactRobotState, location.level_name),
+  DDS_OP_ADR | DDS_OP_TYPE_4BY, offsetof (FreeFleetData_CompactRobotState, path.base_sec),
+  DDS_OP_ADR | DDS_OP_TYPE_4BY, offsetof (FreeFleetData_CompactRobotState, path.base_nanosec),
+  DDS_OP_ADR | DDS_OP_TYPE_4BY, offsetof (FreeFleetData_CompactRobotState, path.origin_x),
+  DDS_OP_ADR | DDS_OP_TYPE_4BY, offsetof (FreeFleetData_CompactRobotState, path.origin_y),
+  DDS_OP_ADR | DDS_OP_TYPE_4BY, offsetof (FreeFleetData_CompactRobotState, path.origin_yaw),
+  DDS_OP_ADR | DDS_OP_TYPE_4BY, offsetof (FreeFleetData_CompactRobotState, path.position_resolution),
+  DDS_OP_ADR | DDS_OP_TYPE_4BY, offsetof (FreeFleetData_CompactRobotState, path.yaw_resolution),
+  DDS_OP_ADR | DDS_OP_TYPE_4BY, offsetof (FreeFleetData_CompactRobotState, path.time_resolution_msec),
+  DDS_OP_ADR | DDS_OP_TYPE_SEQ | DDS_OP_SUBTYPE_2BY, offsetof (FreeFleetData_CompactRobotState, path.dt),
+  DDS_OP_ADR | DDS_OP_TYPE_SEQ | DDS_OP_SUBTYPE_2BY, offsetof (FreeFleetData_CompactRobotState, path.dx),
+  DDS_OP_ADR | DDS_OP_TYPE_SEQ | DDS_OP_SUBTYPE_2BY, offsetof (FreeFleetData_CompactRobotState, path.dy),
+  DDS_OP_ADR | DDS_OP_TYPE_SEQ | DDS_OP_SUBTYPE_2BY, offsetof (FreeFleetData_CompactRobotState, path.dyaw),
+  DDS_OP_ADR | DDS_OP_TYPE_SEQ | DDS_OP_SUBTYPE_STR, offsetof (FreeFleetData_CompactRobotState, path.level_names),
+  DDS_OP_ADR | DDS_OP_TYPE_SEQ | DDS_OP_SUBTYPE_4BY, offsetof (FreeFleetData_CompactRobotState, path.level_run_start),
+  DDS_OP_ADR | DDS_OP_TYPE_SEQ | DDS_OP_SUBTYPE_1BY, offsetof (FreeFleetData_CompactRobotState, path.level_run_index),
+  DDS_OP_RTS
+};
+
+const dds_topic_descriptor_t FreeFleetData_CompactRobotState_desc =
+{
+  sizeof (FreeFleetData_CompactRobotState),
+  sizeof (char *),
+  DDS_TOPIC_NO_OPTIMIZE,
+  1u,
+  "FreeFleetData::CompactRobotState",
+  FreeFleetData_CompactRobotState_keys,
+  27,
+  FreeFleetData_CompactRobotState_ops,
+  "<MetaData version=\"1.0.0\"><Module name=\"FreeFleetData\"><Struct name=\"RobotMode\"><Member name=\"mode\"><ULong/></Member></Struct><Struct name=\"Location\"><Member name=\"sec\"><Long/></Member><Member name=\"nanosec\"><ULong/></Member><Member name=\"x\"><Float/></Member><Member name=\"y\"><Float/></Member><Member name=\"yaw\"><Float/></Member><Member name=\"level_name\"><String/></Member></Struct><Struct name=\"CompactPath\"><Member name=\"base_sec\"><Long/></Member><Member name=\"base_nanosec\"><ULong/></Member><Member name=\"origin_x\"><Float/></Member><Member name=\"origin_y\"><Float/></Member><Member name=\"origin_yaw\"><Float/></Member><Member name=\"position_resolution\"><Float/></Member><Member name=\"yaw_resolution\"><Float/></Member><Member name=\"time_resolution_msec\"><ULong/></Member><Member name=\"dt\"><Sequence><Short/></Sequence></Member><Member name=\"dx\"><Sequence><Short/></Sequence></Member><Member name=\"dy\"><Sequence><Short/></Sequence></Member><Member name=\"dyaw\"><Sequence><Short/></Sequence></Member><Member name=\"level_names\"><Sequence><String/></Sequence></Member><Member name=\"level_run_start\"><Sequence><ULong/></Sequence></Member><Member name=\"level_run_index\"><Sequence><Octet/></Sequence></Member></Struct><Struct name=\"CompactRobotState\"><Member name=\"name\"><String/></Member><Member name=\"model\"><String/></Member><Member name=\"task_id\"><String/></Member><Member name=\"mode\"><Type name=\"RobotMode\"/></Member><Member name=\"battery_percent\"><Float/></Member><Member name=\"location\"><Type name=\"Location\"/></Member><Member name=\"path\"><Type name=\"CompactPath\"/></Member></Struct></Module></MetaData>"
+};
+
+
+static const uint32_t FreeFleetData_CompactPathRequest_ops [] =
+{
+  DDS_OP_ADR | DDS_OP_TYPE_STR, offsetof (FreeFleetData_CompactPathRequest, fleet_name),
+  DDS_OP_ADR | DDS_OP_TYPE_STR, offsetof (FreeFleetData_CompactPathRequest, robot_name),
+  DDS_OP_ADR | DDS_OP_TYPE_4BY, offsetof (FreeFleetData_CompactPathRequest, path.base_sec),
+  DDS_OP_ADR | DDS_OP_TYPE_4BY, offsetof (FreeFleetData_CompactPathRequest, path.base_nanosec),
+  DDS_OP_ADR | DDS_OP_TYPE_4BY, offsetof (FreeFleetData_CompactPathRequest, path.origin_x),
+  DDS_OP_ADR | DDS_OP_TYPE_4BY, offsetof (FreeFleetData_CompactPathRequest, path.origin_y),
+  DDS_OP_ADR | DDS_OP_TYPE_4BY, offsetof (FreeFleetData_CompactPathRequest, path.origin_yaw),
+  DDS_OP_ADR | DDS_OP_TYPE_4BY, offsetof (FreeFleetData_CompactPathRequest, path.position_resolution),
+  DDS_OP_ADR | DDS_OP_TYPE_4BY, offsetof (FreeFleetData_CompactPathRequest, path.yaw_resolution),
+  DDS_OP_ADR | DDS_OP_TYPE_4BY, offsetof (FreeFleetData_CompactPathRequest, path.time_resolution_msec),
+  DDS_OP_ADR | DDS_OP_TYPE_SEQ | DDS_OP_SUBTYPE_2BY, offsetof (FreeFleetData_CompactPathRequest, path.dt),
+  DDS_OP_ADR | DDS_OP_TYPE_SEQ | DDS_OP_SUBTYPE_2BY, offsetof (FreeFleetData_CompactPathRequest, path.dx),
+  DDS_OP_ADR | DDS_OP_TYPE_SEQ | DDS_OP_SUBTYPE_2BY, offsetof (FreeFleetData_CompactPathRequest, path.dy),
+  DDS_OP_ADR | DDS_OP_TYPE_SEQ | DDS_OP_SUBTYPE_2BY, offsetof (FreeFleetData_CompactPathRequest, path.dyaw),
+  DDS_OP_ADR | DDS_OP_TYPE_SEQ | DDS_OP_SUBTYPE_STR, offsetof (FreeFleetData_CompactPathRequest, path.level_names),
+  DDS_OP_ADR | DDS_OP_TYPE_SEQ | DDS_OP_SUBTYPE_4BY, offsetof (FreeFleetData_CompactPathRequest, path.level_run_start),
+  DDS_OP_ADR | DDS_OP_TYPE_SEQ | DDS_OP_SUBTYPE_1BY, offsetof (FreeFleetData_CompactPathRequest, path.level_run_index),
+  DDS_OP_ADR | DDS_OP_TYPE_STR, offsetof (FreeFleetData_CompactPathRequest, task_id),
+  DDS_OP_RTS
+};
+
+const dds_topic_descriptor_t FreeFleetData_CompactPathRequest_desc =
+{
+  sizeof (FreeFleetData_CompactPathRequest),
+  sizeof (char *),
+  DDS_TOPIC_NO_OPTIMIZE,
+  0u,
+  "FreeFleetData::CompactPathRequest",
+  NULL,
+  19,
+  FreeFleetData_CompactPathRequest_ops,
+  "<MetaData version=\"1.0.0\"><Module name=\"FreeFleetData\"><Struct name=\"CompactPath\"><Member name=\"base_sec\"><Long/></Member><Member name=\"base_nanosec\"><ULong/></Member><Member name=\"origin_x\"><Float/></Member><Member name=\"origin_y\"><Float/></Member><Member name=\"origin_yaw\"><Float/></Member><Member name=\"position_resolution\"><Float/></Member><Member name=\"yaw_resolution\"><Float/></Member><Member name=\"time_resolution_msec\"><ULong/></Member><Member name=\"dt\"><Sequence><Short/></Sequence></Member><Member name=\"dx\"><Sequence><Short/></Sequence></Member><Member name=\"dy\"><Sequence><Short/></Sequence></Member><Member name=\"dyaw\"><Sequence><Short/></Sequence></Member><Member name=\"level_names\"><Sequence><String/></Sequence></Member><Member name=\"level_run_start\"><Sequence><ULong/></Sequence></Member><Member name=\"level_run_index\"><Sequence><Octet/></Sequence></Member></Struct><Struct name=\"CompactPathRequest\"><Member name=\"fleet_name\"><String/></Member><Member name=\"robot_name\"><String/></Member><Member name=\"path\"><Type name=\"CompactPath\"/></Member><Member name=\"task_id\"><String/></Member></Struct></Module></MetaData>"
+};
+
+
+static const dds_key_descriptor_t FreeFleetData_RobotStateDelta_keys[1] =
+{
+  { "name", 0 }
+};
+
+static const uint32_t FreeFleetData_RobotStateDelta_ops [] =
+{
+  DDS_OP_ADR | DDS_OP_TYPE_STR | DDS_OP_FLAG_KEY, offsetof (FreeFleetData_RobotStateDelta, name),
+  DDS_OP_ADR | DDS_OP_TYPE_4BY, offsetof (FreeFleetData_RobotStateDelta, keyframe_sec),
+  DDS_OP_ADR | DDS_OP_TYPE_4BY, offsetof (FreeFleetData_RobotStateDelta, keyframe_nanosec),
+  DDS_OP_ADR | DDS_OP_TYPE_4BY, offsetof (FreeFleetData_RobotStateDelta, field_mask),
+  DDS_OP_ADR | DDS_OP_TYPE_STR, offsetof (FreeFleetData_RobotStateDelta, model),
+  DDS_OP_ADR | DDS_OP_TYPE_STR, offsetof (FreeFleetData_RobotStateDelta, task_id),
+  DDS_OP_ADR | DDS_OP_TYPE_4BY, offsetof (FreeFleetData_RobotStateDelta, mode.mode),
+  DDS_OP_ADR | DDS_OP_TYPE_4BY, offsetof (FreeFleetData_RobotStateDelta, battery_percent),
+  DDS_OP_ADR | DDS_OP_TYPE_4BY, offsetof (FreeFleetData_RobotStateDelta, location.sec),
+  DDS_OP_ADR | DDS_OP_TYPE_4BY, offsetof (FreeFleetData_RobotStateDelta, location.nanosec),
+  DDS_OP_ADR | DDS_OP_TYPE_4BY, offsetof (FreeFleetData_RobotStateDelta, location.x),
+  DDS_OP_ADR | DDS_OP_TYPE_4BY, offsetof (FreeFleetData_RobotStateDelta, location.y),
+  DDS_OP_ADR | DDS_OP_TYPE_4BY, offsetof (FreeFleetData_RobotStateDelta, location.yaw),
+  DDS_OP_ADR | DDS_OP_TYPE_STR, offsetof (FreeFleetData_RobotStateDelta, location.level_name),
+  DDS_OP_RTS
+};
+
+const dds_topic_descriptor_t FreeFleetData_RobotStateDelta_desc =
+{
+  sizeof (FreeFleetData_RobotStateDelta),
+  sizeof (char *),
+  DDS_TOPIC_NO_OPTIMIZE,
+  1u,
+  "FreeFleetData::RobotStateDelta",
+  FreeFleetData_RobotStateDelta_keys,
+  15,
+  FreeFleetData_RobotStateDelta_ops,
+  "<MetaData version=\"1.0.0\"><Module name=\"FreeFleetData\"><Struct name=\"RobotMode\"><Member name=\"mode\"><ULong/></Member></Struct><Struct name=\"Location\"><Member name=\"sec\"><Long/></Member><Member name=\"nanosec\"><ULong/></Member><Member name=\"x\"><Float/></Member><Member name=\"y\"><Float/></Member><Member name=\"yaw\"><Float/></Member><Member name=\"level_name\"><String/></Member></Struct><Struct name=\"RobotStateDelta\"><Member name=\"name\"><String/></Member><Member name=\"keyframe_sec\"><Long/></Member><Member name=\"keyframe_nanosec\"><ULong/></Member><Member name=\"field_mask\"><ULong/></Member><Member name=\"model\"><String/></Member><Member name=\"task_id\"><String/></Member><Member name=\"mode\"><Type name=\"RobotMode\"/></Member><Member name=\"battery_percent\"><Float/></Member><Member name=\"location\"><Type name=\"Location\"/></Member></Struct></Module></MetaData>"
+};
+
+
+static const uint32_t FreeFleetData_CompressedPath_ops [] =
+{
+  DDS_OP_ADR | DDS_OP_TYPE_4BY, offsetof (FreeFleetData_CompressedPath, path_length),
+  DDS_OP_ADR | DDS_OP_TYPE_4BY, offsetof (FreeFleetData_CompressedPath, encoded_size),
+  DDS_OP_ADR | DDS_OP_TYPE_SEQ | DDS_OP_SUBTYPE_1BY, offsetof (FreeFleetData_CompressedPath, data),
+  DDS_OP_RTS
+};
+
+const dds_topic_descriptor_t FreeFleetData_CompressedPath_desc =
+{
+  sizeof (FreeFleetData_CompressedPath),
+  sizeof (char *),
+  DDS_TOPIC_NO_OPTIMIZE,
+  0u,
+  "FreeFleetData::CompressedPath",
+  NULL,
+  4,
+  FreeFleetData_CompressedPath_ops,
+  "<MetaData version=\"1.0.0\"><Module name=\"FreeFleetData\"><Struct name=\"CompressedPath\"><Member name=\"path_length\"><ULong/></Member><Member name=\"encoded_size\"><ULong/></Member><Member name=\"data\"><Sequence><Octet/></Sequence></Member></Struct></Module></MetaData>"
+};
+
+
+static const dds_key_descriptor_t FreeFleetData_CompressedRobotState_keys[1] =
+{
+  { "name", 0 }
+};
+
+static const uint32_t FreeFleetData_CompressedRobotState_ops [] =
+{
+  DDS_OP_ADR | DDS_OP_TYPE_STR | DDS_OP_FLAG_KEY, offsetof (FreeFleetData_CompressedRobotState, name),
+  DDS_OP_ADR | DDS_OP_TYPE_STR, offsetof (FreeFleetData_CompressedRobotState, model),
+  DDS_OP_ADR | DDS_OP_TYPE_STR, offsetof (FreeFleetData_CompressedRobotState, task_id),
+  DDS_OP_ADR | DDS_OP_TYPE_4BY, offsetof (FreeFleetData_CompressedRobotState, mode.mode),
+  DDS_OP_ADR | DDS_OP_TYPE_4BY, offsetof (FreeFleetData_CompressedRobotState, battery_percent),
+  DDS_OP_ADR | DDS_OP_TYPE_4BY, offsetof (FreeFleetData_CompressedRobotState, location.sec),
+  DDS_OP_ADR | DDS_OP_TYPE_4BY, offsetof (FreeFleetData_CompressedRobotState, location.nanosec),
+  DDS_OP_ADR | DDS_OP_TYPE_4BY, offsetof (FreeFleetData_CompressedRobotState, location.x),
+  DDS_OP_ADR | DDS_OP_TYPE_4BY, offsetof (FreeFleetData_CompressedRobotState, location.y),
+  DDS_OP_ADR | DDS_OP_TYPE_4BY, offsetof (FreeFleetData_CompressedRobotState, location.yaw),
+  DDS_OP_ADR | DDS_OP_TYPE_STR, offsetof (FreeFleetData_CompressedRobotState, location.level_name),
+  DDS_OP_ADR | DDS_OP_TYPE_SEQ | DDS_OP_SUBTYPE_STU, offsetof (FreeFleetData_CompressedRobotState, path),
+  sizeof (FreeFleetData_Location), (17u << 16u) + 4u,
+  DDS_OP_ADR | DDS_OP_TYPE_4BY, offsetof (FreeFleetData_Location, sec),
+  DDS_OP_ADR | DDS_OP_TYPE_4BY, offsetof (FreeFleetData_Location, nanosec),
+  DDS_OP_ADR | DDS_OP_TYPE_4BY, offsetof (FreeFleetData_Location, x),
+  DDS_OP_ADR | DDS_OP_TYPE_4BY, offsetof (FreeFleetData_Location, y),
+  DDS_OP_ADR | DDS_OP_TYPE_4BY, offsetof (FreeFleetData_Location, yaw),
+  DDS_OP_ADR | DDS_OP_TYPE_STR, offsetof (FreeFleetData_Location, level_name),
+  DDS_OP_RTS,
+  DDS_OP_ADR | DDS_OP_TYPE_4BY, offsetof (FreeFleetData_CompressedRobotState, compressed_path.path_length),
+  DDS_OP_ADR | DDS_OP_TYPE_4BY, offsetof (FreeFleetData_CompressedRobotState, compressed_path.encoded_size),
+  DDS_OP_ADR | DDS_OP_TYPE_SEQ | DDS_OP_SUBTYPE_1BY, offsetof (FreeFleetData_CompressedRobotState, compressed_path.data),
+  DDS_OP_RTS
+};
+
+const dds_topic_descriptor_t FreeFleetData_CompressedRobotState_desc =
+{
+  sizeof (FreeFleetData_CompressedRobotState),
+  sizeof (char *),
+  DDS_TOPIC_NO_OPTIMIZE,
+  1u,
+  "FreeFleetData::CompressedRobotState",
+  FreeFleetData_CompressedRobotState_keys,
+  24,
+  FreeFleetData_CompressedRobotState_ops,
+  "<MetaData version=\"1.0.0\"><Module name=\"FreeFleetData\"><Struct name=\"RobotMode\"><Member name=\"mode\"><ULong/></Member></Struct><Struct name=\"Location\"><Member name=\"sec\"><Long/></Member><Member name=\"nanosec\"><ULong/></Member><Member name=\"x\"><Float/></Member><Member name=\"y\"><Float/></Member><Member name=\"yaw\"><Float/></Member><Member name=\"level_name\"><String/></Member></Struct><Struct name=\"CompressedPath\"><Member name=\"path_length\"><ULong/></Member><Member name=\"encoded_size\"><ULong/></Member><Member name=\"data\"><Sequence><Octet/></Sequence></Member></Struct><Struct name=\"CompressedRobotState\"><Member name=\"name\"><String/></Member><Member name=\"model\"><String/></Member><Member name=\"task_id\"><String/></Member><Member name=\"mode\"><Type name=\"RobotMode\"/></Member><Member name=\"battery_percent\"><Float/></Member><Member name=\"location\"><Type name=\"Location\"/></Member><Member name=\"path\"><Sequence><Type name=\"Location\"/></Sequence></Member><Member name=\"compressed_path\"><Type name=\"CompressedPath\"/></Member></Struct></Module></MetaData>"
+};
+
+
+static const uint32_t FreeFleetData_CompressedPathRequest_ops [] =
+{
+  DDS_OP_ADR | DDS_OP_TYPE_STR, offsetof (FreeFleetData_CompressedPathRequest, fleet_name),
+  DDS_OP_ADR | DDS_OP_TYPE_STR, offsetof (FreeFleetData_CompressedPathRequest, robot_name),
+  DDS_OP_ADR | DDS_OP_TYPE_SEQ | DDS_OP_SUBTYPE_STU, offsetof (FreeFleetData_CompressedPathRequest, path),
+  sizeof (FreeFleetData_Location), (17u << 16u) + 4u,
+  DDS_OP_ADR | DDS_OP_TYPE_4BY, offsetof (FreeFleetData_Location, sec),
+  DDS_OP_ADR | DDS_OP_TYPE_4BY, offsetof (FreeFleetData_Location, nanosec),
+  DDS_OP_ADR | DDS_OP_TYPE_4BY, offsetof (FreeFleetData_Location, x),
+  DDS_OP_ADR | DDS_OP_TYPE_4BY, offsetof (FreeFleetData_Location, y),
+  DDS_OP_ADR | DDS_OP_TYPE_4BY, offsetof (FreeFleetData_Location, yaw),
+  DDS_OP_ADR | DDS_OP_TYPE_STR, offsetof (FreeFleetData_Location, level_name),
+  DDS_OP_RTS,
+  DDS_OP_ADR | DDS_OP_TYPE_4BY, offsetof (FreeFleetData_CompressedPathRequest, compressed_path.path_length),
+  DDS_OP_ADR | DDS_OP_TYPE_4BY, offsetof (FreeFleetData_CompressedPathRequest, compressed_path.encoded_size),
+  DDS_OP_ADR | DDS_OP_TYPE_SEQ | DDS_OP_SUBTYPE_1BY, offsetof (FreeFleetData_CompressedPathRequest, compressed_path.data),
+  DDS_OP_ADR | DDS_OP_TYPE_STR, offsetof (FreeFleetData_CompressedPathRequest, task_id),
+  DDS_OP_RTS
+};
+
+const dds_topic_descriptor_t FreeFleetData_CompressedPathRequest_desc =
+{
+  sizeof (FreeFleetData_CompressedPathRequest),
+  sizeof (char *),
+  DDS_TOPIC_NO_OPTIMIZE,
+  0u,
+  "FreeFleetData::CompressedPathRequest",
+  NULL,
+  16,
+  FreeFleetData_CompressedPathRequest_ops,
+  "<MetaData version=\"1.0.0\"><Module name=\"FreeFleetData\"><Struct name=\"Location\"><Member name=\"sec\"><Long/></Member><Member name=\"nanosec\"><ULong/></Member><Member name=\"x\"><Float/></Member><Member name=\"y\"><Float/></Member><Member name=\"yaw\"><Float/></Member><Member name=\"level_name\"><String/></Member></Struct><Struct name=\"CompressedPath\"><Member name=\"path_length\"><ULong/></Member><Member name=\"encoded_size\"><ULong/></Member><Member name=\"data\"><Sequence><Octet/></Sequence></Member></Struct><Struct name=\"CompressedPathRequest\"><Member name=\"fleet_name\"><String/></Member><Member name=\"robot_name\"><String/></Member><Member name=\"path\"><Sequence><Type name=\"Location\"/></Sequence></Member><Member name=\"compressed_path\"><Type name=\"CompressedPath\"/></Member><Member name=\"task_id\"><String/></Member></Struct></Module></MetaData>"
+};
+
+
+static const dds_key_descriptor_t FreeFleetData_RobotRegistration_keys[1] =
+{
+  { "robot_name", 0 }
+};
+
+static const uint32_t FreeFleetData_RobotRegistration_ops [] =
+{
+  DDS_OP_ADR | DDS_OP_TYPE_STR | DDS_OP_FLAG_KEY, offsetof (FreeFleetData_RobotRegistration, robot_name),
+  DDS_OP_ADR | DDS_OP_TYPE_4BY, offsetof (FreeFleetData_RobotRegistration, robot_id),
+  DDS_OP_RTS
+};
+
+const dds_topic_descriptor_t FreeFleetData_RobotRegistration_desc =
+{
+  sizeof (FreeFleetData_RobotRegistration),
+  sizeof (char *),
+  DDS_TOPIC_NO_OPTIMIZE,
+  1u,
+  "FreeFleetData::RobotRegistration",
+  FreeFleetData_RobotRegistration_keys,
+  3,
+  FreeFleetData_RobotRegistration_ops,
+  "<MetaData version=\"1.0.0\"><Module name=\"FreeFleetData\"><Struct name=\"RobotRegistration\"><Member name=\"robot_name\"><String/></Member><Member name=\"robot_id\"><ULong/></Member></Struct></Module></MetaData>"
+};
+
+
+static const dds_key_descriptor_t FreeFleetData_RegisteredRobotState_keys[1] =
+{
+  { "robot_id", 0 }
+};
+
+static const uint32_t FreeFleetData_RegisteredRobotState_ops [] =
+{
+  DDS_OP_ADR | DDS_OP_TYPE_4BY | DDS_OP_FLAG_KEY, offsetof (FreeFleetData_RegisteredRobotState, robot_id),
+  DDS_OP_ADR | DDS_OP_TYPE_STR, offsetof (FreeFleetData_RegisteredRobotState, model),
+  DDS_OP_ADR | DDS_OP_TYPE_STR, offsetof (FreeFleetData_RegisteredRobotState, task_id),
+  DDS_OP_ADR | DDS_OP_TYPE_4BY, offsetof (FreeFleetData_RegisteredRobotState, mode.mode),
+  DDS_OP_ADR | DDS_OP_TYPE_4BY, offsetof (FreeFleetData_RegisteredRobotState, battery_percent),
+  DDS_OP_ADR | DDS_OP_TYPE_4BY, offsetof (FreeFleetData_RegisteredRobotState, location.sec),
+  DDS_OP_ADR | DDS_OP_TYPE_4BY, offsetof (FreeFleetData_RegisteredRobotState, location.nanosec),
+  DDS_OP_ADR | DDS_OP_TYPE_4BY, offsetof (FreeFleetData_RegisteredRobotState, location.x),
+  DDS_OP_ADR | DDS_OP_TYPE_4BY, offsetof (FreeFleetData_RegisteredRobotState, location.y),
+  DDS_OP_ADR | DDS_OP_TYPE_4BY, offsetof (FreeFleetData_RegisteredRobotState, location.yaw),
+  DDS_OP_ADR | DDS_OP_TYPE_STR, offsetof (FreeFleetData_RegisteredRobotState, location.level_name),
+  DDS_OP_ADR | DDS_OP_TYPE_SEQ | DDS_OP_SUBTYPE_STU, offsetof (FreeFleetData_RegisteredRobotState, path),
+  sizeof (FreeFleetData_Location), (17u << 16u) + 4u,
+  DDS_OP_ADR | DDS_OP_TYPE_4BY, offsetof (FreeFleetData_Location, sec),
+  DDS_OP_ADR | DDS_OP_TYPE_4BY, offsetof (FreeFleetData_Location, nanosec),
+  DDS_OP_ADR | DDS_OP_TYPE_4BY, offsetof (FreeFleetData_Location, x),
+  DDS_OP_ADR | DDS_OP_TYPE_4BY, offsetof (FreeFleetData_Location, y),
+  DDS_OP_ADR | DDS_OP_TYPE_4BY, offsetof (FreeFleetData_Location, yaw),
+  DDS_OP_ADR | DDS_OP_TYPE_STR, offsetof (FreeFleetData_Location, level_name),
+  DDS_OP_RTS,
+  DDS_OP_RTS
+};
+
+const dds_topic_descriptor_t FreeFleetData_RegisteredRobotState_desc =
+{
+  sizeof (FreeFleetData_RegisteredRobotState),
+  sizeof (char *),
+  DDS_TOPIC_NO_OPTIMIZE | DDS_TOPIC_FIXED_KEY,
+  1u,
+  "FreeFleetData::RegisteredRobotState",
+  FreeFleetData_RegisteredRobotState_keys,
+  21,
+  FreeFleetData_RegisteredRobotState_ops,
+  "<MetaData version=\"1.0.0\"><Module name=\"FreeFleetData\"><Struct name=\"RobotMode\"><Member name=\"mode\"><ULong/></Member></Struct><Struct name=\"Location\"><Member name=\"sec\"><Long/></Member><Member name=\"nanosec\"><ULong/></Member><Member name=\"x\"><Float/></Member><Member name=\"y\"><Float/></Member><Member name=\"yaw\"><Float/></Member><Member name=\"level_name\"><String/></Member></Struct><Struct name=\"RegisteredRobotState\"><Member name=\"robot_id\"><ULong/></Member><Member name=\"model\"><String/></Member><Member name=\"task_id\"><String/></Member><Member name=\"mode\"><Type name=\"RobotMode\"/></Member><Member name=\"battery_percent\"><Float/></Member><Member name=\"location\"><Type name=\"Location\"/></Member><Member name=\"path\"><Sequence><Type name=\"Location\"/></Sequence></Member></Struct></Module></MetaData>"
+};
+
+
+static const uint32_t FreeFleetData_RegisteredModeRequest_ops [] =
+{
+  DDS_OP_ADR | DDS_OP_TYPE_4BY, offsetof (FreeFleetData_RegisteredModeRequest, robot_id),
+  DDS_OP_ADR | DDS_OP_TYPE_4BY, offsetof (FreeFleetData_RegisteredModeRequest, mode.mode),
+  DDS_OP_ADR | DDS_OP_TYPE_STR, offsetof (FreeFleetData_RegisteredModeRequest, task_id),
+  DDS_OP_ADR | DDS_OP_TYPE_SEQ | DDS_OP_SUBTYPE_STU, offsetof (FreeFleetData_RegisteredModeRequest, parameters),
+  sizeof (FreeFleetData_ModeParameter), (9u << 16u) + 4u,
+  DDS_OP_ADR | DDS_OP_TYPE_STR, offsetof (FreeFleetData_ModeParameter, name),
+  DDS_OP_ADR | DDS_OP_TYPE_STR, offsetof (FreeFleetData_ModeParameter, value),
+  DDS_OP_RTS,
+  DDS_OP_RTS
+};
+
+const dds_topic_descriptor_t FreeFleetData_RegisteredModeRequest_desc =
+{
+  sizeof (FreeFleetData_RegisteredModeRequest),
+  sizeof (char *),
+  DDS_TOPIC_NO_OPTIMIZE,
+  0u,
+  "FreeFleetData::RegisteredModeRequest",
+  NULL,
+  9,
+  FreeFleetData_RegisteredModeRequest_ops,
+  "<MetaData version=\"1.0.0\"><Module name=\"FreeFleetData\"><Struct name=\"RobotMode\"><Member name=\"mode\"><ULong/></Member></Struct><Struct name=\"ModeParameter\"><Member name=\"name\"><String/></Member><Member name=\"value\"><String/></Member></Struct><Struct name=\"RegisteredModeRequest\"><Member name=\"robot_id\"><ULong/></Member><Member name=\"mode\"><Type name=\"RobotMode\"/></Member><Member name=\"task_id\"><String/></Member><Member name=\"parameters\"><Sequence><Type name=\"ModeParameter\"/></Sequence></Member></Struct></Module></MetaData>"
+};
+
+
+static const uint32_t FreeFleetData_RegisteredPathRequest_ops [] =
+{
+  DDS_OP_ADR | DDS_OP_TYPE_4BY, offsetof (FreeFleetData_RegisteredPathRequest, robot_id),
+  DDS_OP_ADR | DDS_OP_TYPE_SEQ | DDS_OP_SUBTYPE_STU, offsetof (FreeFleetData_RegisteredPathRequest, path),
+  sizeof (FreeFleetData_Location), (17u << 16u) + 4u,
+  DDS_OP_ADR | DDS_OP_TYPE_4BY, offsetof (FreeFleetData_Location, sec),
+  DDS_OP_ADR | DDS_OP_TYPE_4BY, offsetof (FreeFleetData_Location, nanosec),
+  DDS_OP_ADR | DDS_OP_TYPE_4BY, offsetof (FreeFleetData_Location, x),
+  DDS_OP_ADR | DDS_OP_TYPE_4BY, offsetof (FreeFleetData_Location, y),
+  DDS_OP_ADR | DDS_OP_TYPE_4BY, offsetof (FreeFleetData_Location, yaw),
+  DDS_OP_ADR | DDS_OP_TYPE_STR, offsetof (FreeFleetData_Location, level_name),
+  DDS_OP_RTS,
+  DDS_OP_ADR | DDS_OP_TYPE_STR, offsetof (FreeFleetData_RegisteredPathRequest, task_id),
+  DDS_OP_RTS
+};
+
+const dds_topic_descriptor_t FreeFleetData_RegisteredPathRequest_desc =
+{
+  sizeof (FreeFleetData_RegisteredPathRequest),
+  sizeof (char *),
+  DDS_TOPIC_NO_OPTIMIZE,
+  0u,
+  "FreeFleetData::RegisteredPathRequest",
+  NULL,
+  12,
+  FreeFleetData_RegisteredPathRequest_ops,
+  "<MetaData version=\"1.0.0\"><Module name=\"FreeFleetData\"><Struct name=\"Location\"><Member name=\"sec\"><Long/></Member><Member name=\"nanosec\"><ULong/></Member><Member name=\"x\"><Float/></Member><Member name=\"y\"><Float/></Member><Member name=\"yaw\"><Float/></Member><Member name=\"level_name\"><String/></Member></Struct><Struct name=\"RegisteredPathRequest\"><Member name=\"robot_id\"><ULong/></Member><Member name=\"path\"><Sequence><Type name=\"Location\"/></Sequence></Member><Member name=\"task_id\"><String/></Member></Struct></Module></MetaData>"
+};
+
+
+static const uint32_t FreeFleetData_RegisteredDestinationRequest_ops [] =
+{
+  DDS_OP_ADR | DDS_OP_TYPE_4BY, offsetof (FreeFleetData_RegisteredDestinationRequest, robot_id),
+  DDS_OP_ADR | DDS_OP_TYPE_4BY, offsetof (FreeFleetData_RegisteredDestinationRequest, destination.sec),
+  DDS_OP_ADR | DDS_OP_TYPE_4BY, offsetof (FreeFleetData_RegisteredDestinationRequest, destination.nanosec),
+  DDS_OP_ADR | DDS_OP_TYPE_4BY, offsetof (FreeFleetData_RegisteredDestinationRequest, destination.x),
+  DDS_OP_ADR | DDS_OP_TYPE_4BY, offsetof (FreeFleetData_RegisteredDestinationRequest, destination.y),
+  DDS_OP_ADR | DDS_OP_TYPE_4BY, offsetof (FreeFleetData_RegisteredDestinationRequest, destination.yaw),
+  DDS_OP_ADR | DDS_OP_TYPE_STR, offsetof (FreeFleetData_RegisteredDestinationRequest, destination.level_name),
+  DDS_OP_ADR | DDS_OP_TYPE_STR, offsetof (FreeFleetData_RegisteredDestinationRequest, task_id),
+  DDS_OP_RTS
+};
+
+const dds_topic_descriptor_t FreeFleetData_RegisteredDestinationRequest_desc =
+{
+  sizeof (FreeFleetData_RegisteredDestinationRequest),
+  sizeof (char *),
+  DDS_TOPIC_NO_OPTIMIZE,
+  0u,
+  "FreeFleetData::RegisteredDestinationRequest",
+  NULL,
+  9,
+  FreeFleetData_RegisteredDestinationRequest_ops,
+  "<MetaData version=\"1.0.0\"><Module name=\"FreeFleetData\"><Struct name=\"Location\"><Member name=\"sec\"><Long/></Member><Member name=\"nanosec\"><ULong/></Member><Member name=\"x\"><Float/></Member><Member name=\"y\"><Float/></Member><Member name=\"yaw\"><Float/></Member><Member name=\"level_name\"><String/></Member></Struct><Struct name=\"RegisteredDestinationRequest\"><Member name=\"robot_id\"><ULong/></Member><Member name=\"destination\"><Type name=\"Location\"/></Member><Member name=\"task_id\"><String/></Member></Struct></Module></MetaData>"
+};
+
+
+static const uint32_t FreeFleetData_RequestAck_ops [] =
+{
+  DDS_OP_ADR | DDS_OP_TYPE_STR, offsetof (FreeFleetData_RequestAck, fleet_name),
+  DDS_OP_ADR | DDS_OP_TYPE_STR, offsetof (FreeFleetData_RequestAck, robot_name),
+  DDS_OP_ADR | DDS_OP_TYPE_STR, offsetof (FreeFleetData_RequestAck, task_id),
+  DDS_OP_ADR | DDS_OP_TYPE_4BY, offsetof (FreeFleetData_RequestAck, request_type),
+  DDS_OP_ADR | DDS_OP_TYPE_1BY, offsetof (FreeFleetData_RequestAck, accepted),
+  DDS_OP_RTS
+};
+
+const dds_topic_descriptor_t FreeFleetData_RequestAck_desc =
+{
+  sizeof (FreeFleetData_RequestAck),
+  sizeof (char *),
+  DDS_TOPIC_NO_OPTIMIZE,
+  0u,
+  "FreeFleetData::RequestAck",
+  NULL,
+  6,
+  FreeFleetData_RequestAck_ops,
+  "<MetaData version=\"1.0.0\"><Module name=\"FreeFleetData\"><Struct name=\"RequestAck\"><Member name=\"fleet_name\"><String/></Member><Member name=\"robot_name\"><String/></Member><Member name=\"task_id\"><String/></Member><Member name=\"request_type\"><ULong/></Member><Member name=\"accepted\"><Boolean/></Member></Struct></Module></MetaData>"
+};
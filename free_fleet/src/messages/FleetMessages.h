@@ -190,6 +190,501 @@ extern const dds_topic_descriptor_t FreeFleetData_DestinationRequest_desc;
 #define FreeFleetData_DestinationRequest_free(d,o) \
 dds_sample_free ((d), &FreeFleetData_DestinationRequest_desc, (o))
 
+#define FreeFleetData_FLAT_STRING_MAX_LENGTH 63
+#define FreeFleetData_FLAT_PATH_MAX_LENGTH 64
+
+
+typedef struct FreeFleetData_FlatLocation
+{
+  int32_t sec;
+  uint32_t nanosec;
+  float x;
+  float y;
+  float yaw;
+  char level_name[63+1];
+} FreeFleetData_FlatLocation;
+
+extern const dds_topic_descriptor_t FreeFleetData_FlatLocation_desc;
+
+#define FreeFleetData_FlatLocation__alloc() \
+((FreeFleetData_FlatLocation*) dds_alloc (sizeof (FreeFleetData_FlatLocation)));
+
+#define FreeFleetData_FlatLocation_free(d,o) \
+dds_sample_free ((d), &FreeFleetData_FlatLocation_desc, (o))
+
+
+typedef struct FreeFleetData_FlatRobotState
+{
+  char name[63+1];
+  char model[63+1];
+  char task_id[63+1];
+  FreeFleetData_RobotMode mode;
+  float battery_percent;
+  FreeFleetData_FlatLocation location;
+  uint32_t path_length;
+  FreeFleetData_FlatLocation path[64];
+} FreeFleetData_FlatRobotState;
+
+extern const dds_topic_descriptor_t FreeFleetData_FlatRobotState_desc;
+
+#define FreeFleetData_FlatRobotState__alloc() \
+((FreeFleetData_FlatRobotState*) dds_alloc (sizeof (FreeFleetData_FlatRobotState)));
+
+#define FreeFleetData_FlatRobotState_free(d,o) \
+dds_sample_free ((d), &FreeFleetData_FlatRobotState_desc, (o))
+
+
+typedef struct FreeFleetData_FlatPathRequest
+{
+  char fleet_name[63+1];
+  char robot_name[63+1];
+  uint32_t path_length;
+  FreeFleetData_FlatLocation path[64];
+  char task_id[63+1];
+} FreeFleetData_FlatPathRequest;
+
+extern const dds_topic_descriptor_t FreeFleetData_FlatPathRequest_desc;
+
+#define FreeFleetData_FlatPathRequest__alloc() \
+((FreeFleetData_FlatPathRequest*) dds_alloc (sizeof (FreeFleetData_FlatPathRequest)));
+
+#define FreeFleetData_FlatPathRequest_free(d,o) \
+dds_sample_free ((d), &FreeFleetData_FlatPathRequest_desc, (o))
+
+typedef struct FreeFleetData_CompactPath_dt_seq
+{
+  uint32_t _maximum;
+  uint32_t _length;
+  int16_t *_buffer;
+  bool _release;
+} FreeFleetData_CompactPath_dt_seq;
+
+#define FreeFleetData_CompactPath_dt_seq__alloc() \
+((FreeFleetData_CompactPath_dt_seq*) dds_alloc (sizeof (FreeFleetData_CompactPath_dt_seq)));
+
+#define FreeFleetData_CompactPath_dt_seq_allocbuf(l) \
+((int16_t *) dds_alloc ((l) * sizeof (int16_t)))
+
+typedef struct FreeFleetData_CompactPath_dx_seq
+{
+  uint32_t _maximum;
+  uint32_t _length;
+  int16_t *_buffer;
+  bool _release;
+} FreeFleetData_CompactPath_dx_seq;
+
+#define FreeFleetData_CompactPath_dx_seq__alloc() \
+((FreeFleetData_CompactPath_dx_seq*) dds_alloc (sizeof (FreeFleetData_CompactPath_dx_seq)));
+
+#define FreeFleetData_CompactPath_dx_seq_allocbuf(l) \
+((int16_t *) dds_alloc ((l) * sizeof (int16_t)))
+
+typedef struct FreeFleetData_CompactPath_dy_seq
+{
+  uint32_t _maximum;
+  uint32_t _length;
+  int16_t *_buffer;
+  bool _release;
+} FreeFleetData_CompactPath_dy_seq;
+
+#define FreeFleetData_CompactPath_dy_seq__alloc() \
+((FreeFleetData_CompactPath_dy_seq*) dds_alloc (sizeof (FreeFleetData_CompactPath_dy_seq)));
+
+#define FreeFleetData_CompactPath_dy_seq_allocbuf(l) \
+((int16_t *) dds_alloc ((l) * sizeof (int16_t)))
+
+typedef struct FreeFleetData_CompactPath_dyaw_seq
+{
+  uint32_t _maximum;
+  uint32_t _length;
+  int16_t *_buffer;
+  bool _release;
+} FreeFleetData_CompactPath_dyaw_seq;
+
+#define FreeFleetData_CompactPath_dyaw_seq__alloc() \
+((FreeFleetData_CompactPath_dyaw_seq*) dds_alloc (sizeof (FreeFleetData_CompactPath_dyaw_seq)));
+
+#define FreeFleetData_CompactPath_dyaw_seq_allocbuf(l) \
+((int16_t *) dds_alloc ((l) * sizeof (int16_t)))
+
+typedef struct FreeFleetData_CompactPath_level_names_seq
+{
+  uint32_t _maximum;
+  uint32_t _length;
+  char * *_buffer;
+  bool _release;
+} FreeFleetData_CompactPath_level_names_seq;
+
+#define FreeFleetData_CompactPath_level_names_seq__alloc() \
+((FreeFleetData_CompactPath_level_names_seq*) dds_alloc (sizeof (FreeFleetData_CompactPath_level_names_seq)));
+
+#define FreeFleetData_CompactPath_level_names_seq_allocbuf(l) \
+((char * *) dds_alloc ((l) * sizeof (char *)))
+
+typedef struct FreeFleetData_CompactPath_level_run_start_seq
+{
+  uint32_t _maximum;
+  uint32_t _length;
+  uint32_t *_buffer;
+  bool _release;
+} FreeFleetData_CompactPath_level_run_start_seq;
+
+#define FreeFleetData_CompactPath_level_run_start_seq__alloc() \
+((FreeFleetData_CompactPath_level_run_start_seq*) dds_alloc (sizeof (FreeFleetData_CompactPath_level_run_start_seq)));
+
+#define FreeFleetData_CompactPath_level_run_start_seq_allocbuf(l) \
+((uint32_t *) dds_alloc ((l) * sizeof (uint32_t)))
+
+typedef struct FreeFleetData_CompactPath_level_run_index_seq
+{
+  uint32_t _maximum;
+  uint32_t _length;
+  uint8_t *_buffer;
+  bool _release;
+} FreeFleetData_CompactPath_level_run_index_seq;
+
+#define FreeFleetData_CompactPath_level_run_index_seq__alloc() \
+((FreeFleetData_CompactPath_level_run_index_seq*) dds_alloc (sizeof (FreeFleetData_CompactPath_level_run_index_seq)));
+
+#define FreeFleetData_CompactPath_level_run_index_seq_allocbuf(l) \
+((uint8_t *) dds_alloc ((l) * sizeof (uint8_t)))
+
+
+typedef struct FreeFleetData_CompactPath
+{
+  int32_t base_sec;
+  uint32_t base_nanosec;
+  float origin_x;
+  float origin_y;
+  float origin_yaw;
+  float position_resolution;
+  float yaw_resolution;
+  uint32_t time_resolution_msec;
+  FreeFleetData_CompactPath_dt_seq dt;
+  FreeFleetData_CompactPath_dx_seq dx;
+  FreeFleetData_CompactPath_dy_seq dy;
+  FreeFleetData_CompactPath_dyaw_seq dyaw;
+  FreeFleetData_CompactPath_level_names_seq level_names;
+  FreeFleetData_CompactPath_level_run_start_seq level_run_start;
+  FreeFleetData_CompactPath_level_run_index_seq level_run_index;
+} FreeFleetData_CompactPath;
+
+extern const dds_topic_descriptor_t FreeFleetData_CompactPath_desc;
+
+#define FreeFleetData_CompactPath__alloc() \
+((FreeFleetData_CompactPath*) dds_alloc (sizeof (FreeFleetData_CompactPath)));
+
+#define FreeFleetData_CompactPath_free(d,o) \
+dds_sample_free ((d), &FreeFleetData_CompactPath_desc, (o))
+
+
+typedef struct FreeFleetData_CompactRobotState
+{
+  char * name;
+  char * model;
+  char * task_id;
+  FreeFleetData_RobotMode mode;
+  float battery_percent;
+  FreeFleetData_Location location;
+  FreeFleetData_CompactPath path;
+} FreeFleetData_CompactRobotState;
+
+extern const dds_topic_descriptor_t FreeFleetData_CompactRobotState_desc;
+
+#define FreeFleetData_CompactRobotState__alloc() \
+((FreeFleetData_CompactRobotState*) dds_alloc (sizeof (FreeFleetData_CompactRobotState)));
+
+#define FreeFleetData_CompactRobotState_free(d,o) \
+dds_sample_free ((d), &FreeFleetData_CompactRobotState_desc, (o))
+
+
+typedef struct FreeFleetData_CompactPathRequest
+{
+  char * fleet_name;
+  char * robot_name;
+  FreeFleetData_CompactPath path;
+  char * task_id;
+} FreeFleetData_CompactPathRequest;
+
+extern const dds_topic_descriptor_t FreeFleetData_CompactPathRequest_desc;
+
+#define FreeFleetData_CompactPathRequest__alloc() \
+((FreeFleetData_CompactPathRequest*) dds_alloc (sizeof (FreeFleetData_CompactPathRequest)));
+
+#define FreeFleetData_CompactPathRequest_free(d,o) \
+dds_sample_free ((d), &FreeFleetData_CompactPathRequest_desc, (o))
+
+#define FreeFleetData_RobotStateDelta_Constants_FIELD_MODEL 1
+#define FreeFleetData_RobotStateDelta_Constants_FIELD_TASK_ID 2
+#define FreeFleetData_RobotStateDelta_Constants_FIELD_MODE 4
+#define FreeFleetData_RobotStateDelta_Constants_FIELD_BATTERY_PERCENT 8
+#define FreeFleetData_RobotStateDelta_Constants_FIELD_LOCATION 16
+
+typedef struct FreeFleetData_RobotStateDelta
+{
+  char * name;
+  int32_t keyframe_sec;
+  uint32_t keyframe_nanosec;
+  uint32_t field_mask;
+  char * model;
+  char * task_id;
+  FreeFleetData_RobotMode mode;
+  float battery_percent;
+  FreeFleetData_Location location;
+} FreeFleetData_RobotStateDelta;
+
+extern const dds_topic_descriptor_t FreeFleetData_RobotStateDelta_desc;
+
+#define FreeFleetData_RobotStateDelta__alloc() \
+((FreeFleetData_RobotStateDelta*) dds_alloc (sizeof (FreeFleetData_RobotStateDelta)));
+
+#define FreeFleetData_RobotStateDelta_free(d,o) \
+dds_sample_free ((d), &FreeFleetData_RobotStateDelta_desc, (o))
+
+
+typedef struct FreeFleetData_CompressedPath_data_seq
+{
+  uint32_t _maximum;
+  uint32_t _length;
+  uint8_t *_buffer;
+  bool _release;
+} FreeFleetData_CompressedPath_data_seq;
+
+#define FreeFleetData_CompressedPath_data_seq__alloc() \
+((FreeFleetData_CompressedPath_data_seq*) dds_alloc (sizeof (FreeFleetData_CompressedPath_data_seq)));
+
+#define FreeFleetData_CompressedPath_data_seq_allocbuf(l) \
+((uint8_t *) dds_alloc ((l) * sizeof (uint8_t)))
+
+
+typedef struct FreeFleetData_CompressedPath
+{
+  uint32_t path_length;
+  uint32_t encoded_size;
+  FreeFleetData_CompressedPath_data_seq data;
+} FreeFleetData_CompressedPath;
+
+extern const dds_topic_descriptor_t FreeFleetData_CompressedPath_desc;
+
+#define FreeFleetData_CompressedPath__alloc() \
+((FreeFleetData_CompressedPath*) dds_alloc (sizeof (FreeFleetData_CompressedPath)));
+
+#define FreeFleetData_CompressedPath_free(d,o) \
+dds_sample_free ((d), &FreeFleetData_CompressedPath_desc, (o))
+
+
+typedef struct FreeFleetData_CompressedRobotState_path_seq
+{
+  uint32_t _maximum;
+  uint32_t _length;
+  FreeFleetData_Location *_buffer;
+  bool _release;
+} FreeFleetData_CompressedRobotState_path_seq;
+
+#define FreeFleetData_CompressedRobotState_path_seq__alloc() \
+((FreeFleetData_CompressedRobotState_path_seq*) dds_alloc (sizeof (FreeFleetData_CompressedRobotState_path_seq)));
+
+#define FreeFleetData_CompressedRobotState_path_seq_allocbuf(l) \
+((FreeFleetData_Location *) dds_alloc ((l) * sizeof (FreeFleetData_Location)))
+
+
+typedef struct FreeFleetData_CompressedRobotState
+{
+  char * name;
+  char * model;
+  char * task_id;
+  FreeFleetData_RobotMode mode;
+  float battery_percent;
+  FreeFleetData_Location location;
+  FreeFleetData_CompressedRobotState_path_seq path;
+  FreeFleetData_CompressedPath compressed_path;
+} FreeFleetData_CompressedRobotState;
+
+extern const dds_topic_descriptor_t FreeFleetData_CompressedRobotState_desc;
+
+#define FreeFleetData_CompressedRobotState__alloc() \
+((FreeFleetData_CompressedRobotState*) dds_alloc (sizeof (FreeFleetData_CompressedRobotState)));
+
+#define FreeFleetData_CompressedRobotState_free(d,o) \
+dds_sample_free ((d), &FreeFleetData_CompressedRobotState_desc, (o))
+
+
+typedef struct FreeFleetData_CompressedPathRequest_path_seq
+{
+  uint32_t _maximum;
+  uint32_t _length;
+  FreeFleetData_Location *_buffer;
+  bool _release;
+} FreeFleetData_CompressedPathRequest_path_seq;
+
+#define FreeFleetData_CompressedPathRequest_path_seq__alloc() \
+((FreeFleetData_CompressedPathRequest_path_seq*) dds_alloc (sizeof (FreeFleetData_CompressedPathRequest_path_seq)));
+
+#define FreeFleetData_CompressedPathRequest_path_seq_allocbuf(l) \
+((FreeFleetData_Location *) dds_alloc ((l) * sizeof (FreeFleetData_Location)))
+
+
+typedef struct FreeFleetData_CompressedPathRequest
+{
+  char * fleet_name;
+  char * robot_name;
+  FreeFleetData_CompressedPathRequest_path_seq path;
+  FreeFleetData_CompressedPath compressed_path;
+  char * task_id;
+} FreeFleetData_CompressedPathRequest;
+
+extern const dds_topic_descriptor_t FreeFleetData_CompressedPathRequest_desc;
+
+#define FreeFleetData_CompressedPathRequest__alloc() \
+((FreeFleetData_CompressedPathRequest*) dds_alloc (sizeof (FreeFleetData_CompressedPathRequest)));
+
+#define FreeFleetData_CompressedPathRequest_free(d,o) \
+dds_sample_free ((d), &FreeFleetData_CompressedPathRequest_desc, (o))
+
+
+typedef struct FreeFleetData_RobotRegistration
+{
+  char * robot_name;
+  uint32_t robot_id;
+} FreeFleetData_RobotRegistration;
+
+extern const dds_topic_descriptor_t FreeFleetData_RobotRegistration_desc;
+
+#define FreeFleetData_RobotRegistration__alloc() \
+((FreeFleetData_RobotRegistration*) dds_alloc (sizeof (FreeFleetData_RobotRegistration)));
+
+#define FreeFleetData_RobotRegistration_free(d,o) \
+dds_sample_free ((d), &FreeFleetData_RobotRegistration_desc, (o))
+
+typedef struct FreeFleetData_RegisteredRobotState_path_seq
+{
+  uint32_t _maximum;
+  uint32_t _length;
+  FreeFleetData_Location *_buffer;
+  bool _release;
+} FreeFleetData_RegisteredRobotState_path_seq;
+
+#define FreeFleetData_RegisteredRobotState_path_seq__alloc() \
+((FreeFleetData_RegisteredRobotState_path_seq*) dds_alloc (sizeof (FreeFleetData_RegisteredRobotState_path_seq)));
+
+#define FreeFleetData_RegisteredRobotState_path_seq_allocbuf(l) \
+((FreeFleetData_Location *) dds_alloc ((l) * sizeof (FreeFleetData_Location)))
+
+
+typedef struct FreeFleetData_RegisteredRobotState
+{
+  uint32_t robot_id;
+  char * model;
+  char * task_id;
+  FreeFleetData_RobotMode mode;
+  float battery_percent;
+  FreeFleetData_Location location;
+  FreeFleetData_RegisteredRobotState_path_seq path;
+} FreeFleetData_RegisteredRobotState;
+
+extern const dds_topic_descriptor_t FreeFleetData_RegisteredRobotState_desc;
+
+#define FreeFleetData_RegisteredRobotState__alloc() \
+((FreeFleetData_RegisteredRobotState*) dds_alloc (sizeof (FreeFleetData_RegisteredRobotState)));
+
+#define FreeFleetData_RegisteredRobotState_free(d,o) \
+dds_sample_free ((d), &FreeFleetData_RegisteredRobotState_desc, (o))
+
+typedef struct FreeFleetData_RegisteredModeRequest_parameters_seq
+{
+  uint32_t _maximum;
+  uint32_t _length;
+  FreeFleetData_ModeParameter *_buffer;
+  bool _release;
+} FreeFleetData_RegisteredModeRequest_parameters_seq;
+
+#define FreeFleetData_RegisteredModeRequest_parameters_seq__alloc() \
+((FreeFleetData_RegisteredModeRequest_parameters_seq*) dds_alloc (sizeof (FreeFleetData_RegisteredModeRequest_parameters_seq)));
+
+#define FreeFleetData_RegisteredModeRequest_parameters_seq_allocbuf(l) \
+((FreeFleetData_ModeParameter *) dds_alloc ((l) * sizeof (FreeFleetData_ModeParameter)))
+
+
+typedef struct FreeFleetData_RegisteredModeRequest
+{
+  uint32_t robot_id;
+  FreeFleetData_RobotMode mode;
+  char * task_id;
+  FreeFleetData_RegisteredModeRequest_parameters_seq parameters;
+} FreeFleetData_RegisteredModeRequest;
+
+extern const dds_topic_descriptor_t FreeFleetData_RegisteredModeRequest_desc;
+
+#define FreeFleetData_RegisteredModeRequest__alloc() \
+((FreeFleetData_RegisteredModeRequest*) dds_alloc (sizeof (FreeFleetData_RegisteredModeRequest)));
+
+#define FreeFleetData_RegisteredModeRequest_free(d,o) \
+dds_sample_free ((d), &FreeFleetData_RegisteredModeRequest_desc, (o))
+
+typedef struct FreeFleetData_RegisteredPathRequest_path_seq
+{
+  uint32_t _maximum;
+  uint32_t _length;
+  FreeFleetData_Location *_buffer;
+  bool _release;
+} FreeFleetData_RegisteredPathRequest_path_seq;
+
+#define FreeFleetData_RegisteredPathRequest_path_seq__alloc() \
+((FreeFleetData_RegisteredPathRequest_path_seq*) dds_alloc (sizeof (FreeFleetData_RegisteredPathRequest_path_seq)));
+
+#define FreeFleetData_RegisteredPathRequest_path_seq_allocbuf(l) \
+((FreeFleetData_Location *) dds_alloc ((l) * sizeof (FreeFleetData_Location)))
+
+
+typedef struct FreeFleetData_RegisteredPathRequest
+{
+  uint32_t robot_id;
+  FreeFleetData_RegisteredPathRequest_path_seq path;
+  char * task_id;
+} FreeFleetData_RegisteredPathRequest;
+
+extern const dds_topic_descriptor_t FreeFleetData_RegisteredPathRequest_desc;
+
+#define FreeFleetData_RegisteredPathRequest__alloc() \
+((FreeFleetData_RegisteredPathRequest*) dds_alloc (sizeof (FreeFleetData_RegisteredPathRequest)));
+
+#define FreeFleetData_RegisteredPathRequest_free(d,o) \
+dds_sample_free ((d), &FreeFleetData_RegisteredPathRequest_desc, (o))
+
+
+typedef struct FreeFleetData_RegisteredDestinationRequest
+{
+  uint32_t robot_id;
+  FreeFleetData_Location destination;
+  char * task_id;
+} FreeFleetData_RegisteredDestinationRequest;
+
+extern const dds_topic_descriptor_t FreeFleetData_RegisteredDestinationRequest_desc;
+
+#define FreeFleetData_RegisteredDestinationRequest__alloc() \
+((FreeFleetData_RegisteredDestinationRequest*) dds_alloc (sizeof (FreeFleetData_RegisteredDestinationRequest)));
+
+#define FreeFleetData_RegisteredDestinationRequest_free(d,o) \
+dds_sample_free ((d), &FreeFleetData_RegisteredDestinationRequest_desc, (o))
+
+
+typedef struct FreeFleetData_RequestAck
+{
+  char * fleet_name;
+  char * robot_name;
+  char * task_id;
+  uint32_t request_type;
+  bool accepted;
+} FreeFleetData_RequestAck;
+
+extern const dds_topic_descriptor_t FreeFleetData_RequestAck_desc;
+
+#define FreeFleetData_RequestAck__alloc() \
+((FreeFleetData_RequestAck*) dds_alloc (sizeof (FreeFleetData_RequestAck)));
+
+#define FreeFleetData_RequestAck_free(d,o) \
+dds_sample_free ((d), &FreeFleetData_RequestAck_desc, (o))
+
 #ifdef __cplusplus
 }
 #endif
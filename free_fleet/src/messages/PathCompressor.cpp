@@ -0,0 +1,368 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <cstring>
+#include <climits>
+
+#ifdef FREE_FLEET_WITH_LZ4
+#include <lz4.h>
+#endif
+
+#include "../dds_utils/common.hpp"
+
+#include "message_utils.hpp"
+#include "PathCompressor.hpp"
+
+namespace free_fleet {
+namespace messages {
+
+namespace {
+
+// Size of the fixed size fields of a waypoint in the encoded path, and the
+// size of the length of its level name.
+constexpr size_t waypoint_fields_size = 5 * sizeof(uint32_t);
+constexpr size_t level_name_length_size = sizeof(uint32_t);
+
+/// Largest ratio of the decompressed to the compressed size that LZ4 can
+/// reach, which bounds the encoded size of a genuine compressed path.
+constexpr size_t lz4_max_ratio = 255;
+
+/// Largest encoded path that is decompressed, about 700k waypoints, which
+/// bounds the memory that a single corrupt sample can make a thread allocate.
+constexpr size_t max_encoded_path_size = 16 * 1024 * 1024;
+
+uint32_t float_bits(float _value)
+{
+  uint32_t bits;
+  std::memcpy(&bits, &_value, sizeof(bits));
+  return bits;
+}
+
+float bits_float(uint32_t _bits)
+{
+  float value;
+  std::memcpy(&value, &_bits, sizeof(value));
+  return value;
+}
+
+size_t encoded_path_size(const std::vector<Location>& _path)
+{
+  size_t encoded_size = _path.size() * waypoint_fields_size;
+  for (const auto& location : _path)
+    encoded_size += level_name_length_size + location.level_name.size();
+  return encoded_size;
+}
+
+/// Value of one of the fixed size fields of the waypoint, seconds are
+/// stored as the difference to the previous waypoint.
+uint32_t waypoint_field(
+    const std::vector<Location>& _path, size_t _index, size_t _field)
+{
+  const Location& location = _path[_index];
+  switch (_field)
+  {
+    case 0:
+      return static_cast<uint32_t>(location.sec) -
+          (_index > 0 ? static_cast<uint32_t>(_path[_index - 1].sec) : 0u);
+    case 1:
+      return location.nanosec;
+    case 2:
+      return float_bits(location.x);
+    case 3:
+      return float_bits(location.y);
+    default:
+      return float_bits(location.yaw);
+  }
+}
+
+/// Encodes the path as the fixed size fields of all the waypoints, each
+/// field stored as 4 planes of little endian bytes, followed by the level
+/// names of all the waypoints.
+void encode_path(
+    const std::vector<Location>& _path, std::vector<uint8_t>& _encoded)
+{
+  const size_t length = _path.size();
+  _encoded.resize(encoded_path_size(_path));
+
+  uint8_t* out = _encoded.data();
+  for (size_t field = 0; field < 5; ++field)
+  {
+    for (size_t plane = 0; plane < 4; ++plane)
+    {
+      for (size_t i = 0; i < length; ++i)
+        *out++ = static_cast<uint8_t>(
+            waypoint_field(_path, i, field) >> (8 * plane));
+    }
+  }
+
+  for (const auto& location : _path)
+  {
+    const uint32_t name_length =
+        static_cast<uint32_t>(location.level_name.size());
+    for (size_t plane = 0; plane < 4; ++plane)
+      *out++ = static_cast<uint8_t>(name_length >> (8 * plane));
+    std::memcpy(out, location.level_name.data(), name_length);
+    out += name_length;
+  }
+}
+
+bool decode_path(
+    const uint8_t* _encoded,
+    size_t _encoded_size,
+    size_t _length,
+    std::vector<Location>& _path)
+{
+  if (_encoded_size < _length * waypoint_fields_size)
+    return false;
+
+  _path.resize(_length);
+  const uint8_t* in = _encoded;
+  for (size_t field = 0; field < 5; ++field)
+  {
+    for (size_t i = 0; i < _length; ++i)
+    {
+      uint32_t value = 0;
+      for (size_t plane = 0; plane < 4; ++plane)
+        value |=
+            static_cast<uint32_t>(in[plane * _length + i]) << (8 * plane);
+
+      Location& location = _path[i];
+      switch (field)
+      {
+        case 0:
+          location.sec = static_cast<int32_t>(
+              value + (i > 0 ? static_cast<uint32_t>(_path[i - 1].sec) : 0u));
+          break;
+        case 1:
+          location.nanosec = value;
+          break;
+        case 2:
+          location.x = bits_float(value);
+          break;
+        case 3:
+          location.y = bits_float(value);
+          break;
+        default:
+          location.yaw = bits_float(value);
+          break;
+      }
+    }
+    in += 4 * _length;
+  }
+
+  const uint8_t* end = _encoded + _encoded_size;
+  for (auto& location : _path)
+  {
+    if (static_cast<size_t>(end - in) < level_name_length_size)
+      return false;
+    uint32_t name_length = 0;
+    for (size_t plane = 0; plane < 4; ++plane)
+      name_length |= static_cast<uint32_t>(in[plane]) << (8 * plane);
+    in += level_name_length_size;
+
+    if (static_cast<size_t>(end - in) < name_length)
+      return false;
+    location.level_name.assign(reinterpret_cast<const char*>(in), name_length);
+    in += name_length;
+  }
+  return in == end;
+}
+
+/// Compresses the encoded path into the data of the compressed path.
+///
+/// \return
+///   False if the path could not be compressed, or did not get any smaller.
+bool compress(
+    const std::vector<uint8_t>& _encoded,
+    FreeFleetData_CompressedPath& _compressed_path)
+{
+#ifdef FREE_FLEET_WITH_LZ4
+  if (_encoded.size() > static_cast<size_t>(INT_MAX))
+    return false;
+
+  const int encoded_size = static_cast<int>(_encoded.size());
+  const int bound = LZ4_compressBound(encoded_size);
+  if (bound <= 0)
+    return false;
+
+  common::dds_sequence_resize(
+      _compressed_path.data, static_cast<size_t>(bound));
+  const int compressed_size = LZ4_compress_default(
+      reinterpret_cast<const char*>(_encoded.data()),
+      reinterpret_cast<char*>(_compressed_path.data._buffer),
+      encoded_size,
+      bound);
+  if (compressed_size <= 0 || compressed_size >= encoded_size)
+    return false;
+
+  _compressed_path.data._length = static_cast<uint32_t>(compressed_size);
+  _compressed_path.encoded_size = static_cast<uint32_t>(encoded_size);
+  return true;
+#else
+  (void)_encoded;
+  (void)_compressed_path;
+  return false;
+#endif
+}
+
+bool decompress_path(
+    const FreeFleetData_CompressedPath& _compressed_path,
+    std::vector<Location>& _path)
+{
+#ifdef FREE_FLEET_WITH_LZ4
+  // Keeps the capacity of the buffer for the following conversions of this
+  // thread, like the outputs of the other conversions.
+  thread_local std::vector<uint8_t> encoded;
+
+  // The encoded size is taken from the wire, so it is checked before the
+  // buffer is resized to it.
+  const size_t encoded_size = _compressed_path.encoded_size;
+  if (encoded_size > max_encoded_path_size ||
+      encoded_size > _compressed_path.data._length * lz4_max_ratio ||
+      _compressed_path.data._length > static_cast<uint32_t>(INT_MAX))
+    return false;
+
+  encoded.resize(encoded_size);
+  const int decompressed_size = LZ4_decompress_safe(
+      reinterpret_cast<const char*>(_compressed_path.data._buffer),
+      reinterpret_cast<char*>(encoded.data()),
+      static_cast<int>(_compressed_path.data._length),
+      static_cast<int>(encoded.size()));
+  if (decompressed_size < 0 ||
+      static_cast<size_t>(decompressed_size) != encoded_size)
+    return false;
+
+  return decode_path(
+      encoded.data(), encoded.size(), _compressed_path.path_length, _path);
+#else
+  (void)_compressed_path;
+  (void)_path;
+  return false;
+#endif
+}
+
+template <typename Sequence>
+bool convert_path(
+    const Sequence& _path,
+    const FreeFleetData_CompressedPath& _compressed_path,
+    std::vector<Location>& _output)
+{
+  if (_compressed_path.data._length == 0)
+  {
+    _output.resize(_path._length);
+    for (uint32_t i = 0; i < _path._length; ++i)
+      convert(_path._buffer[i], _output[i]);
+    return true;
+  }
+
+  if (decompress_path(_compressed_path, _output))
+    return true;
+  _output.clear();
+  return false;
+}
+
+} // anonymous namespace
+
+bool path_compression_available()
+{
+#ifdef FREE_FLEET_WITH_LZ4
+  return true;
+#else
+  return false;
+#endif
+}
+
+PathCompressor::PathCompressor(size_t _threshold) :
+  threshold(_threshold)
+{}
+
+template <typename Sequence>
+void PathCompressor::convert_path(
+    const std::vector<Location>& _input,
+    Sequence& _output_path,
+    FreeFleetData_CompressedPath& _output_compressed_path,
+    common::DdsStringCapacities* _capacities)
+{
+  const size_t length = _input.size();
+  _output_compressed_path.path_length = static_cast<uint32_t>(length);
+  if (encoded_path_size(_input) >= threshold && path_compression_available())
+  {
+    encode_path(_input, encoded);
+    if (compress(encoded, _output_compressed_path))
+    {
+      common::dds_sequence_resize(_output_path, 0);
+      return;
+    }
+  }
+
+  _output_compressed_path.encoded_size = 0;
+  common::dds_sequence_resize(_output_compressed_path.data, 0);
+  common::dds_sequence_resize(_output_path, length);
+  for (size_t i = 0; i < length; ++i)
+    messages::convert(_input[i], _output_path._buffer[i], _capacities);
+}
+
+void PathCompressor::convert(
+    const RobotState& _input, FreeFleetData_CompressedRobotState& _output,
+    common::DdsStringCapacities* _capacities)
+{
+  common::dds_string_assign(_output.name, _input.name, _capacities);
+  common::dds_string_assign(_output.model, _input.model, _capacities);
+  common::dds_string_assign(_output.task_id, _input.task_id, _capacities);
+  messages::convert(_input.mode, _output.mode);
+  _output.battery_percent = _input.battery_percent;
+  messages::convert(_input.location, _output.location, _capacities);
+  convert_path(
+      _input.path, _output.path, _output.compressed_path, _capacities);
+}
+
+void PathCompressor::convert(
+    const PathRequest& _input, FreeFleetData_CompressedPathRequest& _output,
+    common::DdsStringCapacities* _capacities)
+{
+  common::dds_string_assign(
+      _output.fleet_name, _input.fleet_name, _capacities);
+  common::dds_string_assign(
+      _output.robot_name, _input.robot_name, _capacities);
+  convert_path(
+      _input.path, _output.path, _output.compressed_path, _capacities);
+  common::dds_string_assign(_output.task_id, _input.task_id, _capacities);
+}
+
+bool convert(
+    const FreeFleetData_CompressedRobotState& _input, RobotState& _output)
+{
+  _output.name.assign(_input.name);
+  _output.model.assign(_input.model);
+  _output.task_id.assign(_input.task_id);
+  convert(_input.mode, _output.mode);
+  _output.battery_percent = _input.battery_percent;
+  convert(_input.location, _output.location);
+  return convert_path(_input.path, _input.compressed_path, _output.path);
+}
+
+bool convert(
+    const FreeFleetData_CompressedPathRequest& _input, PathRequest& _output)
+{
+  _output.fleet_name.assign(_input.fleet_name);
+  _output.robot_name.assign(_input.robot_name);
+  _output.task_id.assign(_input.task_id);
+  return convert_path(_input.path, _input.compressed_path, _output.path);
+}
+
+} // namespace messages
+} // namespace free_fleet
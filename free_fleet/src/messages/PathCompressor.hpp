@@ -0,0 +1,95 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef FREE_FLEET__SRC__MESSAGES__PATHCOMPRESSOR_HPP
+#define FREE_FLEET__SRC__MESSAGES__PATHCOMPRESSOR_HPP
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+#include <free_fleet/messages/Location.hpp>
+#include <free_fleet/messages/RobotState.hpp>
+#include <free_fleet/messages/PathRequest.hpp>
+
+#include "FleetMessages.h"
+#include "../dds_utils/common.hpp"
+
+namespace free_fleet {
+namespace messages {
+
+/// Whether this build of free fleet is able to compress paths, which
+/// requires LZ4.
+bool path_compression_available();
+
+/// Converts robot states and path requests into the compressed messages.
+/// Paths are encoded into a byte buffer, with the bytes of the times,
+/// positions and yaws stored column by column so that LZ4 finds long
+/// matches, and the buffer is LZ4 compressed when its size reaches the
+/// threshold. Smaller paths, and paths that do not get any smaller when
+/// compressed, are sent as is.
+///
+/// The encoding buffer is kept between conversions, so a compressor should
+/// not be used by multiple threads at once.
+class PathCompressor
+{
+public:
+
+  /// \param[in] threshold
+  ///   Encoded size of a path in bytes, from which the path is compressed.
+  ///   A waypoint takes 24 bytes plus the length of its level name.
+  PathCompressor(size_t threshold);
+
+  /// The strings of the output are assigned with the given capacities, if
+  /// the output is converted into over and over.
+  void convert(
+      const RobotState& input, FreeFleetData_CompressedRobotState& output,
+      common::DdsStringCapacities* capacities = nullptr);
+
+  void convert(
+      const PathRequest& input, FreeFleetData_CompressedPathRequest& output,
+      common::DdsStringCapacities* capacities = nullptr);
+
+private:
+
+  size_t threshold;
+
+  std::vector<uint8_t> encoded;
+
+  template <typename Sequence>
+  void convert_path(
+      const std::vector<Location>& input,
+      Sequence& output_path,
+      FreeFleetData_CompressedPath& output_compressed_path,
+      common::DdsStringCapacities* capacities);
+
+};
+
+// Conversions from the compressed messages return false if the path was
+// compressed but could not be decompressed, for example as LZ4 is not
+// available, in which case the path of the output is left empty.
+
+bool convert(
+    const FreeFleetData_CompressedRobotState& _input, RobotState& _output);
+
+bool convert(
+    const FreeFleetData_CompressedPathRequest& _input, PathRequest& _output);
+
+} // namespace messages
+} // namespace free_fleet
+
+#endif // FREE_FLEET__SRC__MESSAGES__PATHCOMPRESSOR_HPP
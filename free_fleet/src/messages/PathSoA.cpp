@@ -0,0 +1,296 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <cmath>
+#include <limits>
+
+#include <free_fleet/messages/PathSoA.hpp>
+
+namespace free_fleet {
+namespace messages {
+
+PathSoA::PathSoA()
+{}
+
+PathSoA::PathSoA(const std::vector<Location>& _path)
+{
+  assign(_path);
+}
+
+void PathSoA::assign(const std::vector<Location>& _path)
+{
+  clear();
+  reserve(_path.size());
+  for (const auto& location : _path)
+    push_back(location);
+}
+
+void PathSoA::push_back(const Location& _location)
+{
+  secs.push_back(_location.sec);
+  nanosecs.push_back(_location.nanosec);
+  xs.push_back(_location.x);
+  ys.push_back(_location.y);
+  yaws.push_back(_location.yaw);
+  level_indices.push_back(find_level(_location.level_name));
+}
+
+void PathSoA::to_locations(std::vector<Location>& _path) const
+{
+  _path.resize(size());
+  for (size_t i = 0; i < _path.size(); ++i)
+  {
+    Location& location = _path[i];
+    location.sec = secs[i];
+    location.nanosec = nanosecs[i];
+    location.x = xs[i];
+    location.y = ys[i];
+    location.yaw = yaws[i];
+    location.level_name.assign(levels[level_indices[i]]);
+  }
+}
+
+Location PathSoA::location(size_t _index) const
+{
+  return Location {
+      secs[_index],
+      nanosecs[_index],
+      xs[_index],
+      ys[_index],
+      yaws[_index],
+      levels[level_indices[_index]]};
+}
+
+void PathSoA::reserve(size_t _size)
+{
+  secs.reserve(_size);
+  nanosecs.reserve(_size);
+  xs.reserve(_size);
+  ys.reserve(_size);
+  yaws.reserve(_size);
+  level_indices.reserve(_size);
+}
+
+void PathSoA::clear()
+{
+  secs.clear();
+  nanosecs.clear();
+  xs.clear();
+  ys.clear();
+  yaws.clear();
+  level_indices.clear();
+  levels.clear();
+}
+
+size_t PathSoA::size() const
+{
+  return xs.size();
+}
+
+bool PathSoA::empty() const
+{
+  return xs.empty();
+}
+
+const std::vector<int32_t>& PathSoA::sec() const
+{
+  return secs;
+}
+
+const std::vector<uint32_t>& PathSoA::nanosec() const
+{
+  return nanosecs;
+}
+
+const std::vector<float>& PathSoA::x() const
+{
+  return xs;
+}
+
+const std::vector<float>& PathSoA::y() const
+{
+  return ys;
+}
+
+const std::vector<float>& PathSoA::yaw() const
+{
+  return yaws;
+}
+
+const std::vector<uint32_t>& PathSoA::level_index() const
+{
+  return level_indices;
+}
+
+const std::vector<std::string>& PathSoA::level_names() const
+{
+  return levels;
+}
+
+double PathSoA::distance_to(size_t _index, double _x, double _y) const
+{
+  const double dx = xs[_index] - _x;
+  const double dy = ys[_index] - _y;
+  return std::sqrt(dx * dx + dy * dy);
+}
+
+// The loops below only read the position arrays, and accumulate into a
+// fixed number of independent lanes without branches, so that they can be
+// vectorized by the compiler.
+
+double PathSoA::length(size_t _begin) const
+{
+  const size_t n = size();
+  if (_begin + 1 >= n)
+    return 0.0;
+
+  // Segment lengths are summed into independent lanes, which the compiler
+  // can keep in a vector register, and only added up at the end.
+  const size_t lanes = 8;
+  const float* x = xs.data();
+  const float* y = ys.data();
+  float partial[lanes] = {};
+  size_t i = _begin + 1;
+  for (; i + lanes <= n; i += lanes)
+  {
+    for (size_t j = 0; j < lanes; ++j)
+    {
+      const float dx = x[i + j] - x[i + j - 1];
+      const float dy = y[i + j] - y[i + j - 1];
+      partial[j] += std::sqrt(dx * dx + dy * dy);
+    }
+  }
+
+  double total = 0.0;
+  for (; i < n; ++i)
+  {
+    const float dx = x[i] - x[i - 1];
+    const float dy = y[i] - y[i - 1];
+    total += std::sqrt(dx * dx + dy * dy);
+  }
+  for (size_t j = 0; j < lanes; ++j)
+    total += partial[j];
+  return total;
+}
+
+double PathSoA::max_segment_length() const
+{
+  const size_t n = size();
+  const float* x = xs.data();
+  const float* y = ys.data();
+  const size_t lanes = 8;
+  float partial[lanes] = {};
+  size_t i = 1;
+  for (; i + lanes <= n; i += lanes)
+  {
+    for (size_t j = 0; j < lanes; ++j)
+    {
+      const float dx = x[i + j] - x[i + j - 1];
+      const float dy = y[i + j] - y[i + j - 1];
+      const float squared = dx * dx + dy * dy;
+      partial[j] = squared > partial[j] ? squared : partial[j];
+    }
+  }
+  float max_squared = 0.0f;
+  for (; i < n; ++i)
+  {
+    const float dx = x[i] - x[i - 1];
+    const float dy = y[i] - y[i - 1];
+    const float squared = dx * dx + dy * dy;
+    max_squared = squared > max_squared ? squared : max_squared;
+  }
+  for (size_t j = 0; j < lanes; ++j)
+    max_squared = partial[j] > max_squared ? partial[j] : max_squared;
+  return std::sqrt(static_cast<double>(max_squared));
+}
+
+double PathSoA::duration(size_t _begin) const
+{
+  if (_begin >= size())
+    return 0.0;
+  const size_t last = size() - 1;
+  return static_cast<double>(secs[last] - secs[_begin]) +
+      (static_cast<double>(nanosecs[last]) - nanosecs[_begin]) * 1e-9;
+}
+
+size_t PathSoA::nearest_waypoint(double _x, double _y) const
+{
+  const size_t n = size();
+  const float* x = xs.data();
+  const float* y = ys.data();
+  const float px = static_cast<float>(_x);
+  const float py = static_cast<float>(_y);
+
+  // The smallest squared distance is found first over independent lanes,
+  // then the first waypoint at that distance is looked up.
+  const size_t lanes = 8;
+  float partial[lanes];
+  for (size_t j = 0; j < lanes; ++j)
+    partial[j] = std::numeric_limits<float>::infinity();
+  size_t i = 0;
+  for (; i + lanes <= n; i += lanes)
+  {
+    for (size_t j = 0; j < lanes; ++j)
+    {
+      const float dx = x[i + j] - px;
+      const float dy = y[i + j] - py;
+      const float squared = dx * dx + dy * dy;
+      partial[j] = squared < partial[j] ? squared : partial[j];
+    }
+  }
+  float min_squared = std::numeric_limits<float>::infinity();
+  for (; i < n; ++i)
+  {
+    const float dx = x[i] - px;
+    const float dy = y[i] - py;
+    const float squared = dx * dx + dy * dy;
+    min_squared = squared < min_squared ? squared : min_squared;
+  }
+  for (size_t j = 0; j < lanes; ++j)
+    min_squared = partial[j] < min_squared ? partial[j] : min_squared;
+
+  // Allows for rounding differences between the vectorized and the scalar
+  // computations of the distances, for example due to fused multiply-adds.
+  const float threshold =
+      min_squared + min_squared * 1e-6f + std::numeric_limits<float>::min();
+  for (i = 0; i < n; ++i)
+  {
+    const float dx = x[i] - px;
+    const float dy = y[i] - py;
+    if (dx * dx + dy * dy <= threshold)
+      return i;
+  }
+  return n;
+}
+
+uint32_t PathSoA::find_level(const std::string& _level_name)
+{
+  // Paths only go through a handful of levels, and consecutive waypoints
+  // are mostly on the same level, so the last level is checked first.
+  if (!level_indices.empty() && levels[level_indices.back()] == _level_name)
+    return level_indices.back();
+  for (size_t i = 0; i < levels.size(); ++i)
+  {
+    if (levels[i] == _level_name)
+      return static_cast<uint32_t>(i);
+  }
+  levels.push_back(_level_name);
+  return static_cast<uint32_t>(levels.size() - 1);
+}
+
+} // namespace messages
+} // namespace free_fleet
@@ -0,0 +1,49 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef FREE_FLEET__SRC__MESSAGES__REGISTERED_HPP
+#define FREE_FLEET__SRC__MESSAGES__REGISTERED_HPP
+
+#include <string>
+#include <cstdint>
+
+namespace free_fleet {
+namespace messages {
+
+/// Numeric ID that the server assigned to the robot with the given name.
+/// Registrations are published by the server when it first receives a full
+/// robot state from a robot, and are kept by DDS for clients that join later.
+struct RobotRegistration
+{
+  std::string robot_name;
+  uint32_t robot_id;
+};
+
+/// Message addressed by the ID of its robot instead of by its fleet and robot
+/// names, which are left out when it is sent. Only refers to the message,
+/// which needs to outlive it.
+template <typename Message>
+struct Registered
+{
+  uint32_t robot_id;
+  const Message* message;
+};
+
+} // namespace messages
+} // namespace free_fleet
+
+#endif // FREE_FLEET__SRC__MESSAGES__REGISTERED_HPP
@@ -0,0 +1,55 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef FREE_FLEET__SRC__MESSAGES__ROBOTSTATEDELTA_HPP
+#define FREE_FLEET__SRC__MESSAGES__ROBOTSTATEDELTA_HPP
+
+#include <string>
+#include <cstdint>
+
+#include <free_fleet/messages/Location.hpp>
+#include <free_fleet/messages/RobotMode.hpp>
+
+namespace free_fleet {
+namespace messages {
+
+/// Fields of a robot state that changed since the last keyframe sent by the
+/// client. The keyframe is the last full robot state, identified by the time
+/// of its location, and fields that are not set in the field mask are the
+/// same as in the keyframe. The path is never part of a delta, a new
+/// keyframe is sent whenever the path changes.
+struct RobotStateDelta
+{
+  std::string name;
+  int32_t keyframe_sec;
+  uint32_t keyframe_nanosec;
+
+  /// Bitmask of the FreeFleetData_RobotStateDelta_Constants_FIELD_* values
+  /// for the fields that differ from the keyframe.
+  uint32_t field_mask;
+
+  std::string model;
+  std::string task_id;
+  RobotMode mode;
+  float battery_percent;
+  Location location;
+};
+
+} // namespace messages
+} // namespace free_fleet
+
+#endif // FREE_FLEET__SRC__MESSAGES__ROBOTSTATEDELTA_HPP
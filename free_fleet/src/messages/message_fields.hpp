@@ -0,0 +1,419 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef FREE_FLEET__SRC__MESSAGES__MESSAGE_FIELDS_HPP
+#define FREE_FLEET__SRC__MESSAGES__MESSAGE_FIELDS_HPP
+
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+
+#include "../dds_utils/common.hpp"
+
+namespace free_fleet {
+namespace messages {
+namespace fields {
+
+// Conversions between the free fleet messages and the DDS messages are
+// generated from a table of the fields of each message pair, which is a
+// specialization of MessageFields listing the fields in the order they are
+// converted. Both conversion directions are generated from the same table,
+// with to_dds and from_dds.
+//
+// Fields are converted according to their types, with std::string to DDS
+// strings, std::vector to DDS sequences, nested messages using their own
+// tables, and scalars by assignment. Sequences of identical trivially
+// copyable elements, and blocks of consecutive trivially copyable fields
+// that have the same layout in both messages, are copied with a single
+// memcpy. The strings and sequences of the DDS messages are allocated with
+// DDS by default, or from an arena that backs a single outgoing sample.
+
+/// Field with the same name in the free fleet message and the DDS message.
+template <
+    typename MessageMember, MessageMember message_member,
+    typename DdsMember, DdsMember dds_member>
+struct Field {};
+
+/// Consecutive fields that are copied as a single block of memory. The
+/// fields need to be trivially copyable and have the same representation in
+/// both messages.
+template <
+    typename MessageMember, MessageMember message_first,
+    typename DdsMember, DdsMember dds_first,
+    size_t message_size, size_t dds_size>
+struct Block
+{
+  static_assert(message_size == dds_size,
+      "blocks need to have the same size in both messages");
+};
+
+template <typename... Fields>
+struct FieldList {};
+
+/// Table of the fields of a message pair, specializations define type as
+/// the FieldList of the message.
+template <typename Message, typename DdsMessage>
+struct MessageFields {};
+
+#define FREE_FLEET_FIELD(Message, DdsMessage, member) \
+  ::free_fleet::messages::fields::Field< \
+      decltype(&Message::member), &Message::member, \
+      decltype(&DdsMessage::member), &DdsMessage::member>
+
+#define FREE_FLEET_FIELD_BLOCK(Message, DdsMessage, first, last) \
+  ::free_fleet::messages::fields::Block< \
+      decltype(&Message::first), &Message::first, \
+      decltype(&DdsMessage::first), &DdsMessage::first, \
+      offsetof(Message, last) + sizeof(Message::last) - \
+          offsetof(Message, first), \
+      offsetof(DdsMessage, last) + sizeof(DdsMessage::last) - \
+          offsetof(DdsMessage, first)>
+
+/// Checks that a field of a block has the same type and the same offset from
+/// the first field of the block in both messages, so that the block can be
+/// copied with a single memcpy. Every field of a block after the first one is
+/// checked next to the table that lists the block.
+#define FREE_FLEET_FIELD_IN_BLOCK(Message, DdsMessage, first, member) \
+  static_assert( \
+      std::is_same< \
+          decltype(Message::member), decltype(DdsMessage::member)>::value && \
+      offsetof(Message, member) - offsetof(Message, first) == \
+          offsetof(DdsMessage, member) - offsetof(DdsMessage, first), \
+      #member " needs to be at the same offset in the block of both messages")
+
+//==============================================================================
+
+template <typename T>
+struct void_type
+{
+  using type = void;
+};
+
+template <typename Message, typename DdsMessage, typename = void>
+struct has_fields : std::false_type {};
+
+template <typename Message, typename DdsMessage>
+struct has_fields<Message, DdsMessage,
+    typename void_type<
+        typename MessageFields<Message, DdsMessage>::type>::type>
+  : std::true_type {};
+
+template <typename T, typename = void>
+struct is_dds_sequence : std::false_type {};
+
+template <typename T>
+struct is_dds_sequence<T,
+    typename void_type<decltype(std::declval<T&>()._buffer)>::type>
+  : std::true_type {};
+
+template <typename Input, typename Output>
+struct is_bulk_copyable : std::integral_constant<bool,
+    std::is_same<Input, Output>::value &&
+    std::is_trivially_copyable<Input>::value> {};
+
+/// Allocates the strings and sequences of DDS messages with DDS, reusing the
+/// existing strings and sequence buffers of the output.
+struct DdsAllocator
+{
+  /// Capacities of the strings of the output, if it is converted into over
+  /// and over, see common::DdsStringCapacities.
+  common::DdsStringCapacities* capacities = nullptr;
+
+  void assign_string(char*& _dst, const std::string& _src)
+  {
+    common::dds_string_assign(_dst, _src, capacities);
+  }
+
+  template <typename Sequence>
+  void resize_sequence(Sequence& _seq, size_t _length)
+  {
+    common::dds_sequence_resize(_seq, _length);
+  }
+};
+
+// All the value conversions are declared up front, as they call each other
+// for nested messages and sequences. Conversions into DDS messages take the
+// allocator of the strings and sequences, which is either DdsAllocator or
+// a dds::SampleArena.
+
+template <typename Allocator>
+void to_dds_value(
+    const std::string& _input, char*& _output, Allocator& _allocator);
+
+template <size_t N, typename Allocator>
+void to_dds_value(
+    const std::string& _input, char (&_output)[N], Allocator& _allocator);
+
+template <typename T, typename Allocator>
+typename std::enable_if<std::is_arithmetic<T>::value>::type
+to_dds_value(const T& _input, T& _output, Allocator& _allocator);
+
+template <typename Element, typename Sequence, typename Allocator>
+typename std::enable_if<is_dds_sequence<Sequence>::value>::type
+to_dds_value(
+    const std::vector<Element>& _input, Sequence& _output,
+    Allocator& _allocator);
+
+template <typename Message, typename DdsMessage, typename Allocator>
+typename std::enable_if<has_fields<Message, DdsMessage>::value>::type
+to_dds_value(
+    const Message& _input, DdsMessage& _output, Allocator& _allocator);
+
+inline void from_dds_value(char* const& _input, std::string& _output);
+
+template <size_t N>
+void from_dds_value(const char (&_input)[N], std::string& _output);
+
+template <typename T>
+typename std::enable_if<std::is_arithmetic<T>::value>::type
+from_dds_value(const T& _input, T& _output);
+
+template <typename Sequence, typename Element>
+typename std::enable_if<is_dds_sequence<Sequence>::value>::type
+from_dds_value(const Sequence& _input, std::vector<Element>& _output);
+
+template <typename DdsMessage, typename Message>
+typename std::enable_if<has_fields<Message, DdsMessage>::value>::type
+from_dds_value(const DdsMessage& _input, Message& _output);
+
+//==============================================================================
+
+template <
+    typename MessageMember, MessageMember message_member,
+    typename DdsMember, DdsMember dds_member,
+    typename Message, typename DdsMessage, typename Allocator>
+void to_dds_field(
+    Field<MessageMember, message_member, DdsMember, dds_member>,
+    const Message& _input, DdsMessage& _output, Allocator& _allocator)
+{
+  to_dds_value(_input.*message_member, _output.*dds_member, _allocator);
+}
+
+template <
+    typename MessageMember, MessageMember message_member,
+    typename DdsMember, DdsMember dds_member,
+    typename Message, typename DdsMessage>
+void from_dds_field(
+    Field<MessageMember, message_member, DdsMember, dds_member>,
+    const DdsMessage& _input, Message& _output)
+{
+  from_dds_value(_input.*dds_member, _output.*message_member);
+}
+
+template <
+    typename MessageMember, MessageMember message_first,
+    typename DdsMember, DdsMember dds_first,
+    size_t message_size, size_t dds_size,
+    typename Message, typename DdsMessage, typename Allocator>
+void to_dds_field(
+    Block<MessageMember, message_first, DdsMember, dds_first,
+        message_size, dds_size>,
+    const Message& _input, DdsMessage& _output, Allocator&)
+{
+  std::memcpy(
+      static_cast<void*>(&(_output.*dds_first)),
+      static_cast<const void*>(&(_input.*message_first)),
+      message_size);
+}
+
+template <
+    typename MessageMember, MessageMember message_first,
+    typename DdsMember, DdsMember dds_first,
+    size_t message_size, size_t dds_size,
+    typename Message, typename DdsMessage>
+void from_dds_field(
+    Block<MessageMember, message_first, DdsMember, dds_first,
+        message_size, dds_size>,
+    const DdsMessage& _input, Message& _output)
+{
+  std::memcpy(
+      static_cast<void*>(&(_output.*message_first)),
+      static_cast<const void*>(&(_input.*dds_first)),
+      message_size);
+}
+
+template <
+    typename... Fields, typename Message, typename DdsMessage,
+    typename Allocator>
+void to_dds_fields(
+    FieldList<Fields...>, const Message& _input, DdsMessage& _output,
+    Allocator& _allocator)
+{
+  using expand = int[];
+  (void)expand{
+      0, (to_dds_field(Fields{}, _input, _output, _allocator), 0)...};
+}
+
+template <typename... Fields, typename Message, typename DdsMessage>
+void from_dds_fields(
+    FieldList<Fields...>, const DdsMessage& _input, Message& _output)
+{
+  using expand = int[];
+  (void)expand{0, (from_dds_field(Fields{}, _input, _output), 0)...};
+}
+
+/// Converts the free fleet message into the DDS message, allocating its
+/// strings and sequences with the allocator.
+template <typename Message, typename DdsMessage, typename Allocator>
+void to_dds(
+    const Message& _input, DdsMessage& _output, Allocator& _allocator)
+{
+  to_dds_fields(
+      typename MessageFields<Message, DdsMessage>::type{},
+      _input, _output, _allocator);
+}
+
+/// Converts the free fleet message into the DDS message, reusing the
+/// strings and sequence buffers of the output.
+template <typename Message, typename DdsMessage>
+void to_dds(const Message& _input, DdsMessage& _output)
+{
+  DdsAllocator allocator;
+  to_dds(_input, _output, allocator);
+}
+
+/// Converts the DDS message into the free fleet message, reusing the
+/// strings and vectors of the output.
+template <typename Message, typename DdsMessage>
+void from_dds(const DdsMessage& _input, Message& _output)
+{
+  from_dds_fields(
+      typename MessageFields<Message, DdsMessage>::type{}, _input, _output);
+}
+
+//==============================================================================
+
+template <typename Allocator>
+void to_dds_value(
+    const std::string& _input, char*& _output, Allocator& _allocator)
+{
+  _allocator.assign_string(_output, _input);
+}
+
+template <size_t N, typename Allocator>
+void to_dds_value(
+    const std::string& _input, char (&_output)[N], Allocator&)
+{
+  common::dds_bounded_string_copy(_output, _input);
+}
+
+template <typename T, typename Allocator>
+typename std::enable_if<std::is_arithmetic<T>::value>::type
+to_dds_value(const T& _input, T& _output, Allocator&)
+{
+  _output = _input;
+}
+
+template <typename Input, typename Output, typename Allocator>
+typename std::enable_if<is_bulk_copyable<Input, Output>::value>::type
+to_dds_elements(
+    const Input* _input, Output* _output, size_t _count, Allocator&)
+{
+  if (_count > 0)
+    std::memcpy(_output, _input, _count * sizeof(Input));
+}
+
+template <typename Input, typename Output, typename Allocator>
+typename std::enable_if<!is_bulk_copyable<Input, Output>::value>::type
+to_dds_elements(
+    const Input* _input, Output* _output, size_t _count,
+    Allocator& _allocator)
+{
+  for (size_t i = 0; i < _count; ++i)
+    to_dds_value(_input[i], _output[i], _allocator);
+}
+
+template <typename Element, typename Sequence, typename Allocator>
+typename std::enable_if<is_dds_sequence<Sequence>::value>::type
+to_dds_value(
+    const std::vector<Element>& _input, Sequence& _output,
+    Allocator& _allocator)
+{
+  _allocator.resize_sequence(_output, _input.size());
+  to_dds_elements(
+      _input.data(), _output._buffer, _input.size(), _allocator);
+}
+
+template <typename Message, typename DdsMessage, typename Allocator>
+typename std::enable_if<has_fields<Message, DdsMessage>::value>::type
+to_dds_value(
+    const Message& _input, DdsMessage& _output, Allocator& _allocator)
+{
+  to_dds(_input, _output, _allocator);
+}
+
+inline void from_dds_value(char* const& _input, std::string& _output)
+{
+  if (_input)
+    _output.assign(_input);
+  else
+    _output.clear();
+}
+
+template <size_t N>
+void from_dds_value(const char (&_input)[N], std::string& _output)
+{
+  const void* end = std::memchr(_input, '\0', N);
+  _output.assign(
+      _input, end ? static_cast<const char*>(end) - _input : N);
+}
+
+template <typename T>
+typename std::enable_if<std::is_arithmetic<T>::value>::type
+from_dds_value(const T& _input, T& _output)
+{
+  _output = _input;
+}
+
+template <typename Input, typename Output>
+typename std::enable_if<is_bulk_copyable<Input, Output>::value>::type
+from_dds_elements(const Input* _input, Output* _output, size_t _count)
+{
+  if (_count > 0)
+    std::memcpy(_output, _input, _count * sizeof(Input));
+}
+
+template <typename Input, typename Output>
+typename std::enable_if<!is_bulk_copyable<Input, Output>::value>::type
+from_dds_elements(const Input* _input, Output* _output, size_t _count)
+{
+  for (size_t i = 0; i < _count; ++i)
+    from_dds_value(_input[i], _output[i]);
+}
+
+template <typename Sequence, typename Element>
+typename std::enable_if<is_dds_sequence<Sequence>::value>::type
+from_dds_value(const Sequence& _input, std::vector<Element>& _output)
+{
+  _output.resize(_input._length);
+  from_dds_elements(_input._buffer, _output.data(), _input._length);
+}
+
+template <typename DdsMessage, typename Message>
+typename std::enable_if<has_fields<Message, DdsMessage>::value>::type
+from_dds_value(const DdsMessage& _input, Message& _output)
+{
+  from_dds<Message>(_input, _output);
+}
+
+} // namespace fields
+} // namespace messages
+} // namespace free_fleet
+
+#endif // FREE_FLEET__SRC__MESSAGES__MESSAGE_FIELDS_HPP
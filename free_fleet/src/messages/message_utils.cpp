@@ -15,181 +15,947 @@
  *
  */
 
+#include <cmath>
+#include <cstdlib>
+#include <cstdint>
+#include <climits>
+#include <algorithm>
+
 #include <dds/dds.h>
 
 #include "../dds_utils/common.hpp"
 
 #include "message_utils.hpp"
+#include "message_fields.hpp"
 
 namespace free_fleet {
 namespace messages {
 
-void convert(const RobotMode& _input, FreeFleetData_RobotMode& _output)
+namespace fields {
+
+// Field tables of the messages, which generate the conversions in both
+// directions. Fields that are not listed are left untouched.
+
+template <>
+struct MessageFields<RobotMode, FreeFleetData_RobotMode>
 {
   // Consequently, free fleet robot modes need to be ordered similarly as 
   // RMF robot modes.
-  _output.mode = _input.mode;
+  using M = RobotMode;
+  using D = FreeFleetData_RobotMode;
+  using type = FieldList<
+      FREE_FLEET_FIELD(M, D, mode)>;
+};
+
+template <>
+struct MessageFields<Location, FreeFleetData_Location>
+{
+  using M = Location;
+  using D = FreeFleetData_Location;
+  using type = FieldList<
+      FREE_FLEET_FIELD_BLOCK(M, D, sec, yaw),
+      FREE_FLEET_FIELD(M, D, level_name)>;
+
+  FREE_FLEET_FIELD_IN_BLOCK(M, D, sec, nanosec);
+  FREE_FLEET_FIELD_IN_BLOCK(M, D, sec, x);
+  FREE_FLEET_FIELD_IN_BLOCK(M, D, sec, y);
+  FREE_FLEET_FIELD_IN_BLOCK(M, D, sec, yaw);
+};
+
+template <>
+struct MessageFields<RobotState, FreeFleetData_RobotState>
+{
+  using M = RobotState;
+  using D = FreeFleetData_RobotState;
+  using type = FieldList<
+      FREE_FLEET_FIELD(M, D, name),
+      FREE_FLEET_FIELD(M, D, model),
+      FREE_FLEET_FIELD(M, D, task_id),
+      FREE_FLEET_FIELD(M, D, mode),
+      FREE_FLEET_FIELD(M, D, battery_percent),
+      FREE_FLEET_FIELD(M, D, location),
+      FREE_FLEET_FIELD(M, D, path)>;
+};
+
+template <>
+struct MessageFields<ModeParameter, FreeFleetData_ModeParameter>
+{
+  using M = ModeParameter;
+  using D = FreeFleetData_ModeParameter;
+  using type = FieldList<
+      FREE_FLEET_FIELD(M, D, name),
+      FREE_FLEET_FIELD(M, D, value)>;
+};
+
+template <>
+struct MessageFields<ModeRequest, FreeFleetData_ModeRequest>
+{
+  using M = ModeRequest;
+  using D = FreeFleetData_ModeRequest;
+  using type = FieldList<
+      FREE_FLEET_FIELD(M, D, fleet_name),
+      FREE_FLEET_FIELD(M, D, robot_name),
+      FREE_FLEET_FIELD(M, D, mode),
+      FREE_FLEET_FIELD(M, D, task_id),
+      FREE_FLEET_FIELD(M, D, parameters)>;
+};
+
+template <>
+struct MessageFields<PathRequest, FreeFleetData_PathRequest>
+{
+  using M = PathRequest;
+  using D = FreeFleetData_PathRequest;
+  using type = FieldList<
+      FREE_FLEET_FIELD(M, D, fleet_name),
+      FREE_FLEET_FIELD(M, D, robot_name),
+      FREE_FLEET_FIELD(M, D, path),
+      FREE_FLEET_FIELD(M, D, task_id)>;
+};
+
+template <>
+struct MessageFields<DestinationRequest, FreeFleetData_DestinationRequest>
+{
+  using M = DestinationRequest;
+  using D = FreeFleetData_DestinationRequest;
+  using type = FieldList<
+      FREE_FLEET_FIELD(M, D, fleet_name),
+      FREE_FLEET_FIELD(M, D, robot_name),
+      FREE_FLEET_FIELD(M, D, destination),
+      FREE_FLEET_FIELD(M, D, task_id)>;
+};
+
+template <>
+struct MessageFields<RequestAck, FreeFleetData_RequestAck>
+{
+  using M = RequestAck;
+  using D = FreeFleetData_RequestAck;
+  using type = FieldList<
+      FREE_FLEET_FIELD(M, D, fleet_name),
+      FREE_FLEET_FIELD(M, D, robot_name),
+      FREE_FLEET_FIELD(M, D, task_id),
+      FREE_FLEET_FIELD(M, D, request_type),
+      FREE_FLEET_FIELD(M, D, accepted)>;
+};
+
+template <>
+struct MessageFields<Location, FreeFleetData_FlatLocation>
+{
+  using M = Location;
+  using D = FreeFleetData_FlatLocation;
+  using type = FieldList<
+      FREE_FLEET_FIELD_BLOCK(M, D, sec, yaw),
+      FREE_FLEET_FIELD(M, D, level_name)>;
+
+  FREE_FLEET_FIELD_IN_BLOCK(M, D, sec, nanosec);
+  FREE_FLEET_FIELD_IN_BLOCK(M, D, sec, x);
+  FREE_FLEET_FIELD_IN_BLOCK(M, D, sec, y);
+  FREE_FLEET_FIELD_IN_BLOCK(M, D, sec, yaw);
+};
+
+template <>
+struct MessageFields<RobotStateDelta, FreeFleetData_RobotStateDelta>
+{
+  using M = RobotStateDelta;
+  using D = FreeFleetData_RobotStateDelta;
+  using type = FieldList<
+      FREE_FLEET_FIELD(M, D, name),
+      FREE_FLEET_FIELD_BLOCK(M, D, keyframe_sec, field_mask),
+      FREE_FLEET_FIELD(M, D, model),
+      FREE_FLEET_FIELD(M, D, task_id),
+      FREE_FLEET_FIELD(M, D, mode),
+      FREE_FLEET_FIELD(M, D, battery_percent),
+      FREE_FLEET_FIELD(M, D, location)>;
+
+  FREE_FLEET_FIELD_IN_BLOCK(M, D, keyframe_sec, keyframe_nanosec);
+  FREE_FLEET_FIELD_IN_BLOCK(M, D, keyframe_sec, field_mask);
+};
+
+template <>
+struct MessageFields<RobotRegistration, FreeFleetData_RobotRegistration>
+{
+  using M = RobotRegistration;
+  using D = FreeFleetData_RobotRegistration;
+  using type = FieldList<
+      FREE_FLEET_FIELD(M, D, robot_name),
+      FREE_FLEET_FIELD(M, D, robot_id)>;
+};
+
+template <>
+struct MessageFields<RobotState, FreeFleetData_RegisteredRobotState>
+{
+  using M = RobotState;
+  using D = FreeFleetData_RegisteredRobotState;
+  using type = FieldList<
+      FREE_FLEET_FIELD(M, D, model),
+      FREE_FLEET_FIELD(M, D, task_id),
+      FREE_FLEET_FIELD(M, D, mode),
+      FREE_FLEET_FIELD(M, D, battery_percent),
+      FREE_FLEET_FIELD(M, D, location),
+      FREE_FLEET_FIELD(M, D, path)>;
+};
+
+template <>
+struct MessageFields<ModeRequest, FreeFleetData_RegisteredModeRequest>
+{
+  using M = ModeRequest;
+  using D = FreeFleetData_RegisteredModeRequest;
+  using type = FieldList<
+      FREE_FLEET_FIELD(M, D, mode),
+      FREE_FLEET_FIELD(M, D, task_id),
+      FREE_FLEET_FIELD(M, D, parameters)>;
+};
+
+template <>
+struct MessageFields<PathRequest, FreeFleetData_RegisteredPathRequest>
+{
+  using M = PathRequest;
+  using D = FreeFleetData_RegisteredPathRequest;
+  using type = FieldList<
+      FREE_FLEET_FIELD(M, D, path),
+      FREE_FLEET_FIELD(M, D, task_id)>;
+};
+
+template <>
+struct MessageFields<
+    DestinationRequest, FreeFleetData_RegisteredDestinationRequest>
+{
+  using M = DestinationRequest;
+  using D = FreeFleetData_RegisteredDestinationRequest;
+  using type = FieldList<
+      FREE_FLEET_FIELD(M, D, destination),
+      FREE_FLEET_FIELD(M, D, task_id)>;
+};
+
+} // namespace fields
+
+void convert(const RobotMode& _input, FreeFleetData_RobotMode& _output)
+{
+  fields::to_dds(_input, _output);
 }
 
 void convert(const FreeFleetData_RobotMode& _input, RobotMode& _output)
 {
-  // Consequently, free fleet robot modes need to be ordered similarly as 
-  // RMF robot modes.
-  _output.mode = _input.mode;
+  fields::from_dds(_input, _output);
 }
 
-void convert(const Location& _input, FreeFleetData_Location& _output)
+void convert(
+    const Location& _input, FreeFleetData_Location& _output,
+    common::DdsStringCapacities* _capacities)
 {
-  _output.sec = _input.sec;
-  _output.nanosec = _input.nanosec;
-  _output.x = _input.x;
-  _output.y = _input.y;
-  _output.yaw = _input.yaw;
-  _output.level_name = common::dds_string_alloc_and_copy(_input.level_name);
+  fields::DdsAllocator allocator;
+  allocator.capacities = _capacities;
+  fields::to_dds(_input, _output, allocator);
 }
 
 void convert(const FreeFleetData_Location& _input, Location& _output)
 {
-  _output.sec = _input.sec;
-  _output.nanosec = _input.nanosec;
-  _output.x = _input.x;
-  _output.y = _input.y;
-  _output.yaw = _input.yaw;
-  _output.level_name = std::string(_input.level_name);
+  fields::from_dds(_input, _output);
 }
 
 void convert(const RobotState& _input, FreeFleetData_RobotState& _output)
 {
-  _output.name = common::dds_string_alloc_and_copy(_input.name);
-  _output.model = common::dds_string_alloc_and_copy(_input.model);
-  _output.task_id = common::dds_string_alloc_and_copy(_input.task_id);
+  fields::to_dds(_input, _output);
+}
+
+void convert(const FreeFleetData_RobotState& _input, RobotState& _output)
+{
+  fields::from_dds(_input, _output);
+}
+
+void convert(const ModeParameter& _input, FreeFleetData_ModeParameter& _output)
+{
+  fields::to_dds(_input, _output);
+}
+
+void convert(const FreeFleetData_ModeParameter& _input, ModeParameter& _output)
+{
+  fields::from_dds(_input, _output);
+}
+
+void convert(const ModeRequest& _input, FreeFleetData_ModeRequest& _output)
+{
+  fields::to_dds(_input, _output);
+}
+
+void convert(const FreeFleetData_ModeRequest& _input, ModeRequest& _output)
+{
+  fields::from_dds(_input, _output);
+}
+
+void convert(const PathRequest& _input, FreeFleetData_PathRequest& _output)
+{
+  fields::to_dds(_input, _output);
+}
+
+void convert(const FreeFleetData_PathRequest& _input, PathRequest& _output)
+{
+  fields::from_dds(_input, _output);
+}
+
+void convert(
+    const DestinationRequest& _input, 
+    FreeFleetData_DestinationRequest& _output)
+{
+  fields::to_dds(_input, _output);
+}
+
+void convert(
+    const FreeFleetData_DestinationRequest& _input,
+    DestinationRequest& _output)
+{
+  fields::from_dds(_input, _output);
+}
+
+void convert(
+    const RequestAck& _input, FreeFleetData_RequestAck& _output,
+    common::DdsStringCapacities* _capacities)
+{
+  fields::DdsAllocator allocator;
+  allocator.capacities = _capacities;
+  fields::to_dds(_input, _output, allocator);
+}
+
+void convert(const FreeFleetData_RequestAck& _input, RequestAck& _output)
+{
+  fields::from_dds(_input, _output);
+}
+
+void convert(
+    const RobotState& _input,
+    FreeFleetData_RobotState& _output,
+    dds::SampleArena& _arena)
+{
+  fields::to_dds(_input, _output, _arena);
+}
+
+void convert(
+    const ModeRequest& _input,
+    FreeFleetData_ModeRequest& _output,
+    dds::SampleArena& _arena)
+{
+  fields::to_dds(_input, _output, _arena);
+}
+
+void convert(
+    const PathRequest& _input,
+    FreeFleetData_PathRequest& _output,
+    dds::SampleArena& _arena)
+{
+  fields::to_dds(_input, _output, _arena);
+}
+
+void convert(
+    const DestinationRequest& _input,
+    FreeFleetData_DestinationRequest& _output,
+    dds::SampleArena& _arena)
+{
+  fields::to_dds(_input, _output, _arena);
+}
+
+void convert(
+    const RobotRegistration& _input,
+    FreeFleetData_RobotRegistration& _output,
+    common::DdsStringCapacities* _capacities)
+{
+  fields::DdsAllocator allocator;
+  allocator.capacities = _capacities;
+  fields::to_dds(_input, _output, allocator);
+}
+
+void convert(
+    const Registered<RobotState>& _input,
+    FreeFleetData_RegisteredRobotState& _output,
+    dds::SampleArena& _arena)
+{
+  _output.robot_id = _input.robot_id;
+  fields::to_dds(*_input.message, _output, _arena);
+}
+
+void convert(
+    const FreeFleetData_RegisteredRobotState& _input, RobotState& _output)
+{
+  fields::from_dds(_input, _output);
+}
+
+void convert(
+    const Registered<ModeRequest>& _input,
+    FreeFleetData_RegisteredModeRequest& _output,
+    dds::SampleArena& _arena)
+{
+  _output.robot_id = _input.robot_id;
+  fields::to_dds(*_input.message, _output, _arena);
+}
+
+void convert(
+    const FreeFleetData_RegisteredModeRequest& _input, ModeRequest& _output)
+{
+  fields::from_dds(_input, _output);
+}
+
+void convert(
+    const Registered<PathRequest>& _input,
+    FreeFleetData_RegisteredPathRequest& _output,
+    dds::SampleArena& _arena)
+{
+  _output.robot_id = _input.robot_id;
+  fields::to_dds(*_input.message, _output, _arena);
+}
+
+void convert(
+    const FreeFleetData_RegisteredPathRequest& _input, PathRequest& _output)
+{
+  fields::from_dds(_input, _output);
+}
+
+void convert(
+    const Registered<DestinationRequest>& _input,
+    FreeFleetData_RegisteredDestinationRequest& _output,
+    dds::SampleArena& _arena)
+{
+  _output.robot_id = _input.robot_id;
+  fields::to_dds(*_input.message, _output, _arena);
+}
+
+void convert(
+    const FreeFleetData_RegisteredDestinationRequest& _input,
+    DestinationRequest& _output)
+{
+  fields::from_dds(_input, _output);
+}
+
+namespace {
+
+template <typename Sequence>
+void convert_path(const Sequence& _input, PathSoA& _output)
+{
+  _output.clear();
+  _output.reserve(_input._length);
+  Location location;
+  for (uint32_t i = 0; i < _input._length; ++i)
+  {
+    convert(_input._buffer[i], location);
+    _output.push_back(location);
+  }
+}
+
+} // anonymous namespace
+
+void convert(
+    const FreeFleetData_RobotState_path_seq& _input, PathSoA& _output)
+{
+  convert_path(_input, _output);
+}
+
+void convert(
+    const FreeFleetData_PathRequest_path_seq& _input, PathSoA& _output)
+{
+  convert_path(_input, _output);
+}
+
+namespace {
+
+bool fits_flat_string(const std::string& _str)
+{
+  return _str.length() <= FreeFleetData_FLAT_STRING_MAX_LENGTH;
+}
+
+bool fits_flat_path(const std::vector<Location>& _path)
+{
+  if (_path.size() > FreeFleetData_FLAT_PATH_MAX_LENGTH)
+    return false;
+  for (const auto& location : _path)
+  {
+    if (!fits_flat_string(location.level_name))
+      return false;
+  }
+  return true;
+}
+
+/// Converts the path into a flat path. All the waypoints of a flat path go
+/// out over the wire, so the waypoints left over from a longer path that was
+/// previously converted into the same output are zeroed.
+void convert_flat_path(
+    const std::vector<Location>& _input,
+    FreeFleetData_FlatLocation* _output_path,
+    uint32_t& _output_path_length)
+{
+  const uint32_t previous_length = std::min<uint32_t>(
+      _output_path_length, FreeFleetData_FLAT_PATH_MAX_LENGTH);
+  _output_path_length = static_cast<uint32_t>(
+      std::min<size_t>(_input.size(), FreeFleetData_FLAT_PATH_MAX_LENGTH));
+  for (uint32_t i = 0; i < _output_path_length; ++i)
+    convert(_input[i], _output_path[i]);
+  for (uint32_t i = _output_path_length; i < previous_length; ++i)
+    _output_path[i] = FreeFleetData_FlatLocation();
+}
+
+} // anonymous namespace
+
+bool fits_flat_message(const RobotState& _input)
+{
+  return fits_flat_string(_input.name) &&
+      fits_flat_string(_input.model) &&
+      fits_flat_string(_input.task_id) &&
+      fits_flat_string(_input.location.level_name) &&
+      fits_flat_path(_input.path);
+}
+
+bool fits_flat_message(const PathRequest& _input)
+{
+  return fits_flat_string(_input.fleet_name) &&
+      fits_flat_string(_input.robot_name) &&
+      fits_flat_string(_input.task_id) &&
+      fits_flat_path(_input.path);
+}
+
+void convert(const Location& _input, FreeFleetData_FlatLocation& _output)
+{
+  fields::to_dds(_input, _output);
+}
+
+void convert(const FreeFleetData_FlatLocation& _input, Location& _output)
+{
+  fields::from_dds(_input, _output);
+}
+
+void convert(const RobotState& _input, FreeFleetData_FlatRobotState& _output)
+{
+  common::dds_bounded_string_copy(_output.name, _input.name);
+  common::dds_bounded_string_copy(_output.model, _input.model);
+  common::dds_bounded_string_copy(_output.task_id, _input.task_id);
   convert(_input.mode, _output.mode);
   _output.battery_percent = _input.battery_percent;
   convert(_input.location, _output.location);
 
-  size_t path_length = _input.path.size();
-  _output.path._maximum = static_cast<uint32_t>(path_length);
-  _output.path._length = static_cast<uint32_t>(path_length);
-  _output.path._buffer = 
-      FreeFleetData_RobotState_path_seq_allocbuf(path_length);
-  _output.path._release = false;
-  for (size_t i = 0; i < path_length; ++i)
-    convert(_input.path[i], _output.path._buffer[i]);
+  convert_flat_path(_input.path, _output.path, _output.path_length);
 }
 
-void convert(const FreeFleetData_RobotState& _input, RobotState& _output)
+void convert(const FreeFleetData_FlatRobotState& _input, RobotState& _output)
 {
-  _output.name = std::string(_input.name);
-  _output.model = std::string(_input.model);
-  _output.task_id = std::string(_input.task_id);
+  _output.name.assign(_input.name);
+  _output.model.assign(_input.model);
+  _output.task_id.assign(_input.task_id);
   convert(_input.mode, _output.mode);
   _output.battery_percent = _input.battery_percent;
   convert(_input.location, _output.location);
 
-  _output.path.clear();
-  for (uint32_t i = 0; i < _input.path._length; ++i)
+  const uint32_t path_length = std::min<uint32_t>(
+      _input.path_length, FreeFleetData_FLAT_PATH_MAX_LENGTH);
+  _output.path.resize(path_length);
+  for (uint32_t i = 0; i < path_length; ++i)
+    convert(_input.path[i], _output.path[i]);
+}
+
+void convert(const PathRequest& _input, FreeFleetData_FlatPathRequest& _output)
+{
+  common::dds_bounded_string_copy(_output.fleet_name, _input.fleet_name);
+  common::dds_bounded_string_copy(_output.robot_name, _input.robot_name);
+
+  convert_flat_path(_input.path, _output.path, _output.path_length);
+
+  common::dds_bounded_string_copy(_output.task_id, _input.task_id);
+}
+
+void convert(const FreeFleetData_FlatPathRequest& _input, PathRequest& _output)
+{
+  _output.fleet_name.assign(_input.fleet_name);
+  _output.robot_name.assign(_input.robot_name);
+
+  const uint32_t path_length = std::min<uint32_t>(
+      _input.path_length, FreeFleetData_FLAT_PATH_MAX_LENGTH);
+  _output.path.resize(path_length);
+  for (uint32_t i = 0; i < path_length; ++i)
+    convert(_input.path[i], _output.path[i]);
+
+  _output.task_id.assign(_input.task_id);
+}
+
+namespace {
+
+constexpr double pi = 3.14159265358979323846;
+
+const double compact_min_position_resolution = 0.001;
+
+const double compact_yaw_resolution = 2.0 * pi / 65536.0;
+
+/// Largest delta used when picking a resolution, which leaves some room for
+/// the quantization error carried over from the previous delta.
+const double compact_max_delta = 32000.0;
+
+/// Largest number of distinct level names in a compact path, as they are
+/// referenced by an octet.
+const size_t compact_max_level_num = 256;
+
+const int64_t nanosec_per_msec = 1000000;
+
+const int64_t nanosec_per_sec = 1000000000;
+
+int64_t to_nanosec(int32_t _sec, uint32_t _nanosec)
+{
+  return static_cast<int64_t>(_sec) * nanosec_per_sec + _nanosec;
+}
+
+int16_t quantize(double _delta, double _resolution)
+{
+  const long steps = std::lround(_delta / _resolution);
+  return static_cast<int16_t>(std::max(-32767L, std::min(32767L, steps)));
+}
+
+double normalize_angle(double _angle)
+{
+  return std::remainder(_angle, 2.0 * pi);
+}
+
+bool fits_compact_path(const std::vector<Location>& _path)
+{
+  std::vector<const std::string*> level_names;
+  for (const auto& location : _path)
   {
-    Location tmp;
-    convert(_input.path._buffer[i], tmp);
-    _output.path.push_back(tmp);
+    auto it = std::find_if(level_names.begin(), level_names.end(),
+        [&](const std::string* _name)
+        {
+          return *_name == location.level_name;
+        });
+    if (it == level_names.end())
+      level_names.push_back(&location.level_name);
   }
+  return level_names.size() <= compact_max_level_num;
 }
 
+} // anonymous namespace
 
-void convert(const ModeParameter& _input, FreeFleetData_ModeParameter& _output)
+bool fits_compact_message(const RobotState& _input)
 {
-  _output.name = common::dds_string_alloc_and_copy(_input.name);
-  _output.value = common::dds_string_alloc_and_copy(_input.value);
+  return fits_compact_path(_input.path);
 }
 
-void convert(const FreeFleetData_ModeParameter& _input, ModeParameter& _output)
+bool fits_compact_message(const PathRequest& _input)
 {
-  _output.name = std::string(_input.name);
-  _output.value = std::string(_input.value);
+  return fits_compact_path(_input.path);
 }
 
-void convert(const ModeRequest& _input, FreeFleetData_ModeRequest& _output)
+void convert(
+    const std::vector<Location>& _input, FreeFleetData_CompactPath& _output,
+    common::DdsStringCapacities* _capacities)
 {
-  _output.fleet_name = common::dds_string_alloc_and_copy(_input.fleet_name);
-  _output.robot_name = common::dds_string_alloc_and_copy(_input.robot_name);
-  convert(_input.mode, _output.mode);
-  _output.task_id = common::dds_string_alloc_and_copy(_input.task_id);
+  const size_t path_length = _input.size();
+  common::dds_sequence_resize(_output.dt, path_length);
+  common::dds_sequence_resize(_output.dx, path_length);
+  common::dds_sequence_resize(_output.dy, path_length);
+  common::dds_sequence_resize(_output.dyaw, path_length);
+  common::dds_sequence_resize(_output.level_names, 0);
+  common::dds_sequence_resize(_output.level_run_start, 0);
+  common::dds_sequence_resize(_output.level_run_index, 0);
+  _output.yaw_resolution = static_cast<float>(compact_yaw_resolution);
+
+  if (_input.empty())
+  {
+    _output.base_sec = 0;
+    _output.base_nanosec = 0;
+    _output.origin_x = 0.0;
+    _output.origin_y = 0.0;
+    _output.origin_yaw = 0.0;
+    _output.position_resolution =
+        static_cast<float>(compact_min_position_resolution);
+    _output.time_resolution_msec = 1;
+    return;
+  }
+
+  const Location& origin = _input[0];
+  _output.base_sec = origin.sec;
+  _output.base_nanosec = origin.nanosec;
+  _output.origin_x = origin.x;
+  _output.origin_y = origin.y;
+  _output.origin_yaw = origin.yaw;
+
+  // Resolutions are picked so that the largest step fits into a delta.
+  double max_step = 0.0;
+  double max_time_step_msec = 0.0;
+  for (size_t i = 1; i < path_length; ++i)
+  {
+    max_step = std::max(max_step, std::fabs(
+        static_cast<double>(_input[i].x) - _input[i - 1].x));
+    max_step = std::max(max_step, std::fabs(
+        static_cast<double>(_input[i].y) - _input[i - 1].y));
+    max_time_step_msec = std::max(max_time_step_msec, std::fabs(
+        static_cast<double>(
+            to_nanosec(_input[i].sec, _input[i].nanosec) -
+            to_nanosec(_input[i - 1].sec, _input[i - 1].nanosec)) /
+        nanosec_per_msec));
+  }
+  _output.position_resolution = static_cast<float>(
+      std::max(compact_min_position_resolution, max_step / compact_max_delta));
+  _output.time_resolution_msec = static_cast<uint32_t>(
+      std::max(1.0, std::ceil(max_time_step_msec / compact_max_delta)));
 
-  size_t mode_parameter_num = _input.parameters.size();
-  _output.parameters._maximum = static_cast<uint32_t>(mode_parameter_num);
-  _output.parameters._length = static_cast<uint32_t>(mode_parameter_num);
-  _output.parameters._buffer = 
-      FreeFleetData_ModeRequest_parameters_seq_allocbuf(mode_parameter_num);
-  for (size_t i = 0; i < mode_parameter_num; ++i)
-    convert(_input.parameters[i], _output.parameters._buffer[i]);
+  const double position_resolution = _output.position_resolution;
+  const double yaw_resolution = _output.yaw_resolution;
+  const double time_resolution =
+      static_cast<double>(_output.time_resolution_msec) * nanosec_per_msec;
+
+  int64_t time = to_nanosec(_output.base_sec, _output.base_nanosec);
+  double x = _output.origin_x;
+  double y = _output.origin_y;
+  double yaw = _output.origin_yaw;
+  for (size_t i = 0; i < path_length; ++i)
+  {
+    const Location& location = _input[i];
+
+    _output.dt._buffer[i] = quantize(
+        static_cast<double>(to_nanosec(location.sec, location.nanosec) - time),
+        time_resolution);
+    time += static_cast<int64_t>(_output.dt._buffer[i] * time_resolution);
+    _output.dx._buffer[i] = quantize(location.x - x, position_resolution);
+    x += _output.dx._buffer[i] * position_resolution;
+    _output.dy._buffer[i] = quantize(location.y - y, position_resolution);
+    y += _output.dy._buffer[i] * position_resolution;
+    _output.dyaw._buffer[i] =
+        quantize(normalize_angle(location.yaw - yaw), yaw_resolution);
+    yaw += _output.dyaw._buffer[i] * yaw_resolution;
+
+    // Levels are stored as runs of consecutive waypoints on the same level
+    const uint32_t run_num = _output.level_run_start._length;
+    if (run_num > 0 &&
+        location.level_name == _output.level_names._buffer[
+            _output.level_run_index._buffer[run_num - 1]])
+      continue;
+
+    uint32_t level = 0;
+    const uint32_t level_num = _output.level_names._length;
+    while (level < level_num &&
+        location.level_name != _output.level_names._buffer[level])
+      ++level;
+    if (level == level_num)
+    {
+      common::dds_sequence_resize(_output.level_names, level_num + 1);
+      common::dds_string_assign(
+          _output.level_names._buffer[level], location.level_name,
+          _capacities);
+    }
+
+    common::dds_sequence_resize(_output.level_run_start, run_num + 1);
+    common::dds_sequence_resize(_output.level_run_index, run_num + 1);
+    _output.level_run_start._buffer[run_num] = static_cast<uint32_t>(i);
+    _output.level_run_index._buffer[run_num] = static_cast<uint8_t>(level);
+  }
 }
 
-void convert(const FreeFleetData_ModeRequest& _input, ModeRequest& _output)
+void convert(
+    const FreeFleetData_CompactPath& _input, std::vector<Location>& _output)
 {
-  _output.fleet_name = std::string(_input.fleet_name);
-  _output.robot_name = std::string(_input.robot_name);
-  convert(_input.mode, _output.mode);
-  _output.task_id = std::string(_input.task_id);
+  const uint32_t path_length = std::min({
+      _input.dt._length,
+      _input.dx._length,
+      _input.dy._length,
+      _input.dyaw._length});
+  const uint32_t run_num = std::min(
+      _input.level_run_start._length, _input.level_run_index._length);
+  _output.resize(path_length);
 
-  _output.parameters.clear();
-  for (uint32_t i = 0; i < _input.parameters._length; ++i)
+  const double position_resolution = _input.position_resolution;
+  const double yaw_resolution = _input.yaw_resolution;
+  const double time_resolution =
+      static_cast<double>(_input.time_resolution_msec) * nanosec_per_msec;
+  int64_t time = to_nanosec(_input.base_sec, _input.base_nanosec);
+  double x = _input.origin_x;
+  double y = _input.origin_y;
+  double yaw = _input.origin_yaw;
+  const char* level_name = "";
+  uint32_t run = 0;
+  for (uint32_t i = 0; i < path_length; ++i)
   {
-    ModeParameter tmp;
-    convert(_input.parameters._buffer[i], tmp);
-    _output.parameters.push_back(tmp);
+    time += static_cast<int64_t>(_input.dt._buffer[i] * time_resolution);
+    x += _input.dx._buffer[i] * position_resolution;
+    y += _input.dy._buffer[i] * position_resolution;
+    yaw += _input.dyaw._buffer[i] * yaw_resolution;
+
+    Location& location = _output[i];
+    int64_t sec = time / nanosec_per_sec;
+    int64_t nanosec = time % nanosec_per_sec;
+    if (nanosec < 0)
+    {
+      --sec;
+      nanosec += nanosec_per_sec;
+    }
+    location.sec = static_cast<int32_t>(sec);
+    location.nanosec = static_cast<uint32_t>(nanosec);
+    location.x = static_cast<float>(x);
+    location.y = static_cast<float>(y);
+    location.yaw = static_cast<float>(normalize_angle(yaw));
+
+    for (; run < run_num && _input.level_run_start._buffer[run] <= i; ++run)
+    {
+      const uint8_t level = _input.level_run_index._buffer[run];
+      level_name =
+          level < _input.level_names._length &&
+              _input.level_names._buffer[level] ?
+          _input.level_names._buffer[level] : "";
+    }
+    location.level_name.assign(level_name);
   }
 }
 
-void convert(const PathRequest& _input, FreeFleetData_PathRequest& _output)
+void convert(
+    const RobotState& _input, FreeFleetData_CompactRobotState& _output,
+    common::DdsStringCapacities* _capacities)
+{
+  common::dds_string_assign(_output.name, _input.name, _capacities);
+  common::dds_string_assign(_output.model, _input.model, _capacities);
+  common::dds_string_assign(_output.task_id, _input.task_id, _capacities);
+  convert(_input.mode, _output.mode);
+  _output.battery_percent = _input.battery_percent;
+  convert(_input.location, _output.location, _capacities);
+  convert(_input.path, _output.path, _capacities);
+}
+
+void convert(
+    const FreeFleetData_CompactRobotState& _input, RobotState& _output)
 {
-  _output.fleet_name = common::dds_string_alloc_and_copy(_input.fleet_name);
-  _output.robot_name = common::dds_string_alloc_and_copy(_input.robot_name);
+  _output.name.assign(_input.name);
+  _output.model.assign(_input.model);
+  _output.task_id.assign(_input.task_id);
+  convert(_input.mode, _output.mode);
+  _output.battery_percent = _input.battery_percent;
+  convert(_input.location, _output.location);
+  convert(_input.path, _output.path);
+}
 
-  size_t path_length = _input.path.size();
-  _output.path._maximum = static_cast<uint32_t>(path_length);
-  _output.path._length = static_cast<uint32_t>(path_length);
-  _output.path._buffer = 
-      FreeFleetData_PathRequest_path_seq_allocbuf(path_length);
-  for (size_t i = 0; i < path_length; ++i)
-    convert(_input.path[i], _output.path._buffer[i]);
+void convert(
+    const PathRequest& _input, FreeFleetData_CompactPathRequest& _output,
+    common::DdsStringCapacities* _capacities)
+{
+  common::dds_string_assign(
+      _output.fleet_name, _input.fleet_name, _capacities);
+  common::dds_string_assign(
+      _output.robot_name, _input.robot_name, _capacities);
+  convert(_input.path, _output.path, _capacities);
+  common::dds_string_assign(_output.task_id, _input.task_id, _capacities);
+}
 
-  _output.task_id = common::dds_string_alloc_and_copy(_input.task_id);
+void convert(
+    const FreeFleetData_CompactPathRequest& _input, PathRequest& _output)
+{
+  _output.fleet_name.assign(_input.fleet_name);
+  _output.robot_name.assign(_input.robot_name);
+  convert(_input.path, _output.path);
+  _output.task_id.assign(_input.task_id);
 }
 
-void convert(const FreeFleetData_PathRequest& _input, PathRequest& _output)
+bool same_location(const Location& _a, const Location& _b)
 {
-  _output.fleet_name = std::string(_input.fleet_name);
-  _output.robot_name = std::string(_input.robot_name);
+  return _a.sec == _b.sec &&
+      _a.nanosec == _b.nanosec &&
+      _a.x == _b.x &&
+      _a.y == _b.y &&
+      _a.yaw == _b.yaw &&
+      _a.level_name == _b.level_name;
+}
 
-  _output.path.clear();
-  for (uint32_t i = 0; i < _input.path._length; ++i)
+bool same_path(
+    const std::vector<Location>& _a, const std::vector<Location>& _b)
+{
+  if (_a.size() != _b.size())
+    return false;
+  for (size_t i = 0; i < _a.size(); ++i)
   {
-    Location tmp;
-    convert(_input.path._buffer[i], tmp);
-    _output.path.push_back(tmp);
+    if (!same_location(_a[i], _b[i]))
+      return false;
   }
+  return true;
+}
 
-  _output.task_id = std::string(_input.task_id);
+void make_robot_state_delta(
+    const RobotState& _keyframe,
+    const RobotState& _input,
+    RobotStateDelta& _output)
+{
+  _output.name = _input.name;
+  _output.keyframe_sec = _keyframe.location.sec;
+  _output.keyframe_nanosec = _keyframe.location.nanosec;
+
+  // Unchanged strings are cleared, so that they are sent as empty strings
+  _output.field_mask = 0;
+  _output.model.clear();
+  _output.task_id.clear();
+  if (_input.model != _keyframe.model)
+  {
+    _output.field_mask |= FreeFleetData_RobotStateDelta_Constants_FIELD_MODEL;
+    _output.model = _input.model;
+  }
+  if (_input.task_id != _keyframe.task_id)
+  {
+    _output.field_mask |=
+        FreeFleetData_RobotStateDelta_Constants_FIELD_TASK_ID;
+    _output.task_id = _input.task_id;
+  }
+  if (_input.mode.mode != _keyframe.mode.mode)
+    _output.field_mask |= FreeFleetData_RobotStateDelta_Constants_FIELD_MODE;
+  if (_input.battery_percent != _keyframe.battery_percent)
+    _output.field_mask |=
+        FreeFleetData_RobotStateDelta_Constants_FIELD_BATTERY_PERCENT;
+  if (!same_location(_input.location, _keyframe.location))
+    _output.field_mask |=
+        FreeFleetData_RobotStateDelta_Constants_FIELD_LOCATION;
+
+  _output.mode = _input.mode;
+  _output.battery_percent = _input.battery_percent;
+  _output.location = _input.location;
+  if (!(_output.field_mask &
+      FreeFleetData_RobotStateDelta_Constants_FIELD_LOCATION))
+    _output.location.level_name.clear();
 }
 
 void convert(
-    const DestinationRequest& _input, 
-    FreeFleetData_DestinationRequest& _output)
+    const RobotStateDelta& _input, FreeFleetData_RobotStateDelta& _output)
 {
-  _output.fleet_name = common::dds_string_alloc_and_copy(_input.fleet_name);
-  _output.robot_name = common::dds_string_alloc_and_copy(_input.robot_name);
-  convert(_input.destination, _output.destination);
-  _output.task_id = common::dds_string_alloc_and_copy(_input.task_id);
+  fields::to_dds(_input, _output);
 }
 
 void convert(
-    const FreeFleetData_DestinationRequest& _input,
-    DestinationRequest& _output)
+    const RobotStateDelta& _input,
+    FreeFleetData_RobotStateDelta& _output,
+    dds::SampleArena& _arena)
 {
-  _output.fleet_name = std::string(_input.fleet_name);
-  _output.robot_name = std::string(_input.robot_name);
-  convert(_input.destination, _output.destination);
-  _output.task_id = std::string(_input.task_id);
+  fields::to_dds(_input, _output, _arena);
+}
+
+bool apply_robot_state_delta(
+    const FreeFleetData_RobotStateDelta& _delta,
+    const RobotState& _keyframe,
+    RobotState& _output)
+{
+  if (_delta.keyframe_sec != _keyframe.location.sec ||
+      _delta.keyframe_nanosec != _keyframe.location.nanosec)
+    return false;
+
+  // The output is usually the previous state of the same robot, so the
+  // fields are assigned in place, reusing its buffers, and the path is only
+  // copied when it changed with a new keyframe.
+  const uint32_t mask = _delta.field_mask;
+  _output.name = _keyframe.name;
+  if (mask & FreeFleetData_RobotStateDelta_Constants_FIELD_MODEL)
+    _output.model.assign(_delta.model);
+  else
+    _output.model = _keyframe.model;
+  if (mask & FreeFleetData_RobotStateDelta_Constants_FIELD_TASK_ID)
+    _output.task_id.assign(_delta.task_id);
+  else
+    _output.task_id = _keyframe.task_id;
+  if (mask & FreeFleetData_RobotStateDelta_Constants_FIELD_MODE)
+    convert(_delta.mode, _output.mode);
+  else
+    _output.mode = _keyframe.mode;
+  if (mask & FreeFleetData_RobotStateDelta_Constants_FIELD_BATTERY_PERCENT)
+    _output.battery_percent = _delta.battery_percent;
+  else
+    _output.battery_percent = _keyframe.battery_percent;
+  if (mask & FreeFleetData_RobotStateDelta_Constants_FIELD_LOCATION)
+    convert(_delta.location, _output.location);
+  else
+    _output.location = _keyframe.location;
+  if (!same_path(_output.path, _keyframe.path))
+    _output.path = _keyframe.path;
+  return true;
 }
 
 } // namespace messages
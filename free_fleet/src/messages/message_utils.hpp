@@ -18,24 +18,46 @@
 #ifndef FREE_FLEET__SRC__MESSAGES__MESSAGE_UTILS_HPP
 #define FREE_FLEET__SRC__MESSAGES__MESSAGE_UTILS_HPP
 
+#include <vector>
+
 #include <free_fleet/messages/Location.hpp>
+#include <free_fleet/messages/PathSoA.hpp>
 #include <free_fleet/messages/RobotMode.hpp>
 #include <free_fleet/messages/RobotState.hpp>
 #include <free_fleet/messages/ModeParameter.hpp>
 #include <free_fleet/messages/ModeRequest.hpp>
 #include <free_fleet/messages/PathRequest.hpp>
 #include <free_fleet/messages/DestinationRequest.hpp>
+#include <free_fleet/messages/RequestAck.hpp>
 
+#include "Registered.hpp"
+#include "RobotStateDelta.hpp"
 #include "FleetMessages.h"
 
+#include "../dds_utils/common.hpp"
+#include "../dds_utils/SampleArena.hpp"
+
 namespace free_fleet {
 namespace messages {
 
+// Conversions into the DDS messages reuse the existing strings and sequence
+// buffers of the output, which therefore needs to be either zero initialized,
+// for example using dds_alloc, or the output of a previous conversion.
+//
+// Conversions from the DDS messages similarly assign into the existing
+// strings and vectors of the output, so converting into the same output
+// repeatedly does not allocate once its capacity is large enough.
+//
+// Conversions that take the capacities of the strings of the output also
+// reuse the strings that got shorter, see common::DdsStringCapacities.
+
 void convert(const RobotMode& _input, FreeFleetData_RobotMode& _output);
 
 void convert(const FreeFleetData_RobotMode& _input, RobotMode& _output);
 
-void convert(const Location& _input, FreeFleetData_Location& _output);
+void convert(
+    const Location& _input, FreeFleetData_Location& _output,
+    common::DdsStringCapacities* _capacities = nullptr);
 
 void convert(const FreeFleetData_Location& _input, Location& _output);
 
@@ -63,6 +85,173 @@ void convert(
     const FreeFleetData_DestinationRequest& _input,
     DestinationRequest& _output);
 
+void convert(
+    const RequestAck& _input, FreeFleetData_RequestAck& _output,
+    common::DdsStringCapacities* _capacities = nullptr);
+
+void convert(const FreeFleetData_RequestAck& _input, RequestAck& _output);
+
+void convert(
+    const FreeFleetData_RobotState_path_seq& _input, PathSoA& _output);
+
+void convert(
+    const FreeFleetData_PathRequest_path_seq& _input, PathSoA& _output);
+
+// Conversions into DDS messages backed by an arena, which allocate all the
+// strings and sequences of the output from the arena. The output needs to be
+// zero initialized, and must not be freed with DDS, see dds::SampleArena.
+
+void convert(
+    const RobotState& _input,
+    FreeFleetData_RobotState& _output,
+    dds::SampleArena& _arena);
+
+void convert(
+    const ModeRequest& _input,
+    FreeFleetData_ModeRequest& _output,
+    dds::SampleArena& _arena);
+
+void convert(
+    const PathRequest& _input,
+    FreeFleetData_PathRequest& _output,
+    dds::SampleArena& _arena);
+
+void convert(
+    const DestinationRequest& _input,
+    FreeFleetData_DestinationRequest& _output,
+    dds::SampleArena& _arena);
+
+void convert(
+    const RobotStateDelta& _input,
+    FreeFleetData_RobotStateDelta& _output,
+    dds::SampleArena& _arena);
+
+// Registered messages carry the robot ID instead of the fleet and robot
+// names. Conversions from the registered messages leave the names of the
+// output untouched, these are filled in from the robot ID by the receiver.
+
+void convert(
+    const RobotRegistration& _input,
+    FreeFleetData_RobotRegistration& _output,
+    common::DdsStringCapacities* _capacities = nullptr);
+
+void convert(
+    const Registered<RobotState>& _input,
+    FreeFleetData_RegisteredRobotState& _output,
+    dds::SampleArena& _arena);
+
+void convert(
+    const FreeFleetData_RegisteredRobotState& _input, RobotState& _output);
+
+void convert(
+    const Registered<ModeRequest>& _input,
+    FreeFleetData_RegisteredModeRequest& _output,
+    dds::SampleArena& _arena);
+
+void convert(
+    const FreeFleetData_RegisteredModeRequest& _input, ModeRequest& _output);
+
+void convert(
+    const Registered<PathRequest>& _input,
+    FreeFleetData_RegisteredPathRequest& _output,
+    dds::SampleArena& _arena);
+
+void convert(
+    const FreeFleetData_RegisteredPathRequest& _input, PathRequest& _output);
+
+void convert(
+    const Registered<DestinationRequest>& _input,
+    FreeFleetData_RegisteredDestinationRequest& _output,
+    dds::SampleArena& _arena);
+
+void convert(
+    const FreeFleetData_RegisteredDestinationRequest& _input,
+    DestinationRequest& _output);
+
+// Conversions into the flat messages truncate strings and paths that exceed
+// the bounds of the flat messages, fits_flat_message should be used to check
+// the input beforehand.
+
+bool fits_flat_message(const RobotState& _input);
+
+bool fits_flat_message(const PathRequest& _input);
+
+void convert(const Location& _input, FreeFleetData_FlatLocation& _output);
+
+void convert(const FreeFleetData_FlatLocation& _input, Location& _output);
+
+void convert(const RobotState& _input, FreeFleetData_FlatRobotState& _output);
+
+void convert(const FreeFleetData_FlatRobotState& _input, RobotState& _output);
+
+void convert(const PathRequest& _input, FreeFleetData_FlatPathRequest& _output);
+
+void convert(const FreeFleetData_FlatPathRequest& _input, PathRequest& _output);
+
+// Compact paths store the first waypoint as the base time and origin, and
+// every waypoint as 16 bit deltas from the previous decoded waypoint. Level
+// names are stored once in a table, and referenced by runs of waypoints on
+// the same level. Yaw is quantized to 2^-16 of a turn, positions to 1 mm and
+// times to 1 ms, or coarser if consecutive waypoints are too far apart to be
+// encoded at these resolutions. As the deltas are taken from the decoded
+// waypoints, the quantization errors do not accumulate along the path.
+// Conversions into the compact messages need the input to be checked with
+// fits_compact_message beforehand.
+
+bool fits_compact_message(const RobotState& _input);
+
+bool fits_compact_message(const PathRequest& _input);
+
+void convert(
+    const std::vector<Location>& _input, FreeFleetData_CompactPath& _output,
+    common::DdsStringCapacities* _capacities = nullptr);
+
+void convert(
+    const FreeFleetData_CompactPath& _input, std::vector<Location>& _output);
+
+void convert(
+    const RobotState& _input, FreeFleetData_CompactRobotState& _output,
+    common::DdsStringCapacities* _capacities = nullptr);
+
+void convert(
+    const FreeFleetData_CompactRobotState& _input, RobotState& _output);
+
+void convert(
+    const PathRequest& _input, FreeFleetData_CompactPathRequest& _output,
+    common::DdsStringCapacities* _capacities = nullptr);
+
+void convert(
+    const FreeFleetData_CompactPathRequest& _input, PathRequest& _output);
+
+// Robot state deltas are taken against a keyframe, which is the last full
+// robot state sent by the client and is identified by the time of its
+// location. Deltas never carry the path, so a new keyframe needs to be sent
+// whenever the path differs from the path of the keyframe.
+
+bool same_location(const Location& _a, const Location& _b);
+
+bool same_path(
+    const std::vector<Location>& _a, const std::vector<Location>& _b);
+
+void make_robot_state_delta(
+    const RobotState& _keyframe,
+    const RobotState& _input,
+    RobotStateDelta& _output);
+
+void convert(
+    const RobotStateDelta& _input, FreeFleetData_RobotStateDelta& _output);
+
+/// Rebuilds the full robot state from the delta and the keyframe it was
+/// taken against.
+///
+/// \return
+///   False if the delta was taken against a different keyframe, in which
+///   case the output is left untouched.
+bool apply_robot_state_delta(
+    const FreeFleetData_RobotStateDelta& _delta,
+    const RobotState& _keyframe,
+    RobotState& _output);
+
 } // namespace 
 } // namespace free_fleet
 
@@ -0,0 +1,128 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <mutex>
+#include <vector>
+#include <iostream>
+#include <condition_variable>
+
+#include "../dds_utils/AsyncPublishHandler.hpp"
+
+using free_fleet::dds::AsyncPublishHandler;
+
+/// Stands in for a DDS writer. It records the batches that the writer thread
+/// writes, and holds the writer thread in its first write until released.
+struct Writer
+{
+  std::mutex mutex;
+  std::condition_variable cv;
+  std::vector<std::vector<int>> batches;
+  bool released = false;
+  int failing_writes = 0;
+
+  AsyncPublishHandler<int>::WriteBatchFunction write_batch()
+  {
+    return [this](const std::vector<int>& _inputs)
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      batches.push_back(_inputs);
+      cv.notify_all();
+      cv.wait(lock, [this]() { return released; });
+      return failing_writes-- <= 0;
+    };
+  }
+
+  void wait_for_batches(size_t _count)
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    cv.wait(lock, [this, _count]() { return batches.size() >= _count; });
+  }
+
+  void release()
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    released = true;
+    cv.notify_all();
+  }
+};
+
+int main()
+{
+  /* Everything that is queued while the writer thread is busy is written
+   * as a single batch. */
+  Writer writer;
+  {
+    AsyncPublishHandler<int> async(writer.write_batch(), 8);
+    async.publish(0);
+    writer.wait_for_batches(1);
+    for (int i = 1; i <= 5; ++i)
+      async.publish(i);
+    writer.release();
+    writer.wait_for_batches(2);
+    if (async.get_dropped_count() != 0)
+    {
+      std::cerr << "dropped messages while the queue had room" << std::endl;
+      return 1;
+    }
+  }
+  if (writer.batches.size() != 2 ||
+      writer.batches[0] != std::vector<int>{0} ||
+      writer.batches[1] != std::vector<int>({1, 2, 3, 4, 5}))
+  {
+    std::cerr << "queued messages were not written as one batch"
+        << std::endl;
+    return 1;
+  }
+
+  /* Messages are dropped once the queue is full, and batches that fail to
+   * be written are dropped as a whole. The third batch is only written
+   * after the failed second one has been counted. */
+  Writer failing_writer;
+  failing_writer.failing_writes = 2;
+  {
+    AsyncPublishHandler<int> async(failing_writer.write_batch(), 4);
+    async.publish(0);
+    failing_writer.wait_for_batches(1);
+    for (int i = 1; i <= 4; ++i)
+      async.publish(i);
+    if (async.publish(5) || async.get_dropped_count() != 1)
+    {
+      std::cerr << "published into a full queue" << std::endl;
+      return 1;
+    }
+
+    failing_writer.release();
+    failing_writer.wait_for_batches(2);
+    async.publish(6);
+    failing_writer.wait_for_batches(3);
+    if (async.get_dropped_count() != 6)
+    {
+      std::cerr << "dropped " << async.get_dropped_count()
+          << " messages instead of 6" << std::endl;
+      return 1;
+    }
+  }
+  if (failing_writer.batches.size() != 3 ||
+      failing_writer.batches[1].size() != 4)
+  {
+    std::cerr << "failed batch was not written as a whole" << std::endl;
+    return 1;
+  }
+
+  std::cout << "AsyncPublishHandler tests passed" << std::endl;
+  return 0;
+}
@@ -0,0 +1,145 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <cstdint>
+#include <iostream>
+
+#include "../dds_utils/BoundedQueue.hpp"
+
+using free_fleet::dds::BoundedQueue;
+
+int main()
+{
+  /* Capacities are rounded up to the next power of two. */
+  if (BoundedQueue<int>(0).capacity() != 2 ||
+      BoundedQueue<int>(3).capacity() != 4 ||
+      BoundedQueue<int>(64).capacity() != 64)
+  {
+    std::cerr << "unexpected capacity" << std::endl;
+    return 1;
+  }
+
+  /* Fill a queue up, then keep it full while going around the ring a few
+   * times, elements have to come out in the order they went in. */
+  BoundedQueue<int> queue(4);
+  int element = 0;
+  if (!queue.empty() || queue.try_pop(element))
+  {
+    std::cerr << "new queue is not empty" << std::endl;
+    return 1;
+  }
+  for (int i = 0; i < 4; ++i)
+    queue.try_push(i);
+  if (queue.try_push(4))
+  {
+    std::cerr << "pushed into a full queue" << std::endl;
+    return 1;
+  }
+  for (int i = 0; i < 12; ++i)
+  {
+    if (!queue.try_pop(element) || element != i || !queue.try_push(i + 4))
+    {
+      std::cerr << "element " << i << " out of order" << std::endl;
+      return 1;
+    }
+  }
+  while (queue.try_pop(element))
+    ;
+  if (!queue.empty())
+  {
+    std::cerr << "drained queue is not empty" << std::endl;
+    return 1;
+  }
+
+  /* Elements are moved into the queue, but left untouched when the queue
+   * is full. */
+  BoundedQueue<std::string> string_queue(2);
+  std::string first(64, 'a');
+  std::string second(64, 'b');
+  std::string dropped(64, 'c');
+  string_queue.try_push(std::move(first));
+  string_queue.try_push(std::move(second));
+  if (string_queue.try_push(std::move(dropped)) ||
+      dropped != std::string(64, 'c'))
+  {
+    std::cerr << "element moved into a full queue" << std::endl;
+    return 1;
+  }
+  std::string popped_string;
+  if (!string_queue.try_pop(popped_string) ||
+      popped_string != std::string(64, 'a'))
+  {
+    std::cerr << "moved element was not kept" << std::endl;
+    return 1;
+  }
+
+  /* Producers and consumers hammer a small queue at the same time, every
+   * element has to be popped exactly once. */
+  const uint64_t producer_count = 4;
+  const uint64_t elements_per_producer = 100000;
+  const uint64_t total = producer_count * elements_per_producer;
+
+  BoundedQueue<uint64_t> shared_queue(64);
+  std::atomic<uint64_t> popped_count(0);
+  std::atomic<uint64_t> popped_sum(0);
+
+  std::vector<std::thread> threads;
+  for (uint64_t p = 0; p < producer_count; ++p)
+  {
+    threads.emplace_back([&shared_queue, p]()
+    {
+      for (uint64_t i = 1; i <= elements_per_producer; ++i)
+      {
+        while (!shared_queue.try_push(p * elements_per_producer + i))
+          std::this_thread::yield();
+      }
+    });
+    threads.emplace_back([&]()
+    {
+      uint64_t popped;
+      while (popped_count.load() < total)
+      {
+        if (!shared_queue.try_pop(popped))
+        {
+          std::this_thread::yield();
+          continue;
+        }
+        popped_sum += popped;
+        ++popped_count;
+      }
+    });
+  }
+  for (auto& thread : threads)
+    thread.join();
+
+  if (popped_count.load() != total ||
+      popped_sum.load() != total * (total + 1) / 2 ||
+      !shared_queue.empty())
+  {
+    std::cerr << "popped " << popped_count.load() << " of " << total
+        << " elements, with a sum of " << popped_sum.load() << std::endl;
+    return 1;
+  }
+
+  std::cout << "BoundedQueue tests passed" << std::endl;
+  return 0;
+}
@@ -0,0 +1,80 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <cstring>
+#include <iostream>
+
+#include <dds/dds.h>
+
+#include "../dds_utils/common.hpp"
+
+using free_fleet::common::dds_string_assign;
+using free_fleet::common::DdsStringCapacities;
+
+int main()
+{
+  /* Without capacities, only shorter contents reuse the buffer. */
+  char* str = nullptr;
+  dds_string_assign(str, "level_1");
+  char* buffer = str;
+  dds_string_assign(str, "L1");
+  if (str != buffer || std::strcmp(str, "L1") != 0)
+  {
+    std::cerr << "shorter string did not reuse the buffer" << std::endl;
+    return 1;
+  }
+  dds_free(str);
+
+  /* With capacities, the buffer is kept while the contents alternate in
+   * length, and only grows beyond its capacity. */
+  DdsStringCapacities capacities;
+  str = nullptr;
+  dds_string_assign(str, "level_1", &capacities);
+  buffer = str;
+  for (int i = 0; i < 4; ++i)
+  {
+    dds_string_assign(str, "L1", &capacities);
+    dds_string_assign(str, "level_2", &capacities);
+    if (str != buffer || std::strcmp(str, "level_2") != 0)
+    {
+      std::cerr << "alternating lengths reallocated the buffer" << std::endl;
+      return 1;
+    }
+  }
+
+  dds_string_assign(str, "a_much_longer_level_name", &capacities);
+  if (capacities.capacity(str) != 24 ||
+      std::strcmp(str, "a_much_longer_level_name") != 0)
+  {
+    std::cerr << "buffer did not grow to the longer string" << std::endl;
+    return 1;
+  }
+
+  /* Forgotten strings fall back to their length, so that a new string that
+   * reuses the address does not take over the capacity. */
+  dds_string_assign(str, "L1", &capacities);
+  capacities.erase(str);
+  if (capacities.capacity(str) != 2)
+  {
+    std::cerr << "freed string kept its capacity" << std::endl;
+    return 1;
+  }
+  dds_free(str);
+
+  std::cout << "dds_string_assign tests passed" << std::endl;
+  return 0;
+}
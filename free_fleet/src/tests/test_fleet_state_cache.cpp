@@ -0,0 +1,137 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include <iostream>
+
+#include <free_fleet/messages/RobotState.hpp>
+
+#include "../FleetStateCache.hpp"
+
+using free_fleet::FleetStateCache;
+using free_fleet::messages::RobotState;
+
+int main()
+{
+  FleetStateCache cache;
+  if (!cache.snapshot() || !cache.snapshot()->empty() || cache.find("robot_1"))
+  {
+    std::cerr << "new cache is not empty" << std::endl;
+    return 1;
+  }
+
+  /* Only the first robot_state_count robot states of a batch are stored. */
+  std::vector<RobotState> robot_states(3);
+  for (size_t i = 0; i < robot_states.size(); ++i)
+  {
+    robot_states[i].name = "robot_" + std::to_string(i + 1);
+    robot_states[i].battery_percent = 10.0f * static_cast<float>(i + 1);
+  }
+  cache.update(robot_states, 2);
+  if (cache.snapshot()->size() != 2 ||
+      cache.find("robot_2")->battery_percent != 20.0f ||
+      cache.find("robot_3"))
+  {
+    std::cerr << "batch update stored the wrong robot states" << std::endl;
+    return 1;
+  }
+
+  /* The stored robot states are handed back in the order of the batch, and
+   * are the ones that the snapshots share. */
+  std::vector<std::shared_ptr<const RobotState>> stored;
+  cache.update(robot_states, 2, &stored);
+  if (stored.size() != 2 ||
+      stored[0] != cache.find("robot_1") ||
+      stored[1] != cache.find("robot_2"))
+  {
+    std::cerr << "stored robot states are not shared with the snapshot"
+        << std::endl;
+    return 1;
+  }
+
+  /* Snapshots that are held on to never change, even after more updates
+   * than the cache has slots. */
+  const auto old_snapshot = cache.snapshot();
+  const auto old_robot_state = cache.find("robot_1");
+  for (int i = 0; i < 16; ++i)
+  {
+    robot_states[0].battery_percent = 50.0f + static_cast<float>(i);
+    cache.update(robot_states[0]);
+  }
+  if (old_snapshot->size() != 2 ||
+      old_snapshot->at("robot_1")->battery_percent != 10.0f ||
+      old_robot_state->battery_percent != 10.0f ||
+      cache.find("robot_1")->battery_percent != 65.0f)
+  {
+    std::cerr << "held snapshot was modified" << std::endl;
+    return 1;
+  }
+
+  /* Both robots are always updated in the same batch, so readers that take
+   * snapshots concurrently always see them with the same battery, which
+   * never goes back. */
+  robot_states[0].battery_percent = 0.0f;
+  robot_states[1].battery_percent = 0.0f;
+  cache.update(robot_states, 2);
+
+  std::atomic<bool> done(false);
+  std::atomic<bool> consistent(true);
+  std::thread writer([&cache, &done, &robot_states]()
+  {
+    for (int i = 0; i < 20000; ++i)
+    {
+      robot_states[0].battery_percent = static_cast<float>(i);
+      robot_states[1].battery_percent = static_cast<float>(i);
+      cache.update(robot_states, 2);
+    }
+    done = true;
+  });
+
+  std::vector<std::thread> readers;
+  for (int r = 0; r < 4; ++r)
+  {
+    readers.emplace_back([&cache, &done, &consistent]()
+    {
+      float last_battery = -1.0f;
+      while (!done)
+      {
+        const auto snapshot = cache.snapshot();
+        const float battery = snapshot->at("robot_1")->battery_percent;
+        if (snapshot->at("robot_2")->battery_percent != battery ||
+            battery < last_battery)
+          consistent = false;
+        last_battery = battery;
+      }
+    });
+  }
+  writer.join();
+  for (auto& reader : readers)
+    reader.join();
+
+  if (!consistent || cache.find("robot_2")->battery_percent != 19999.0f)
+  {
+    std::cerr << "readers saw a partially applied update" << std::endl;
+    return 1;
+  }
+
+  std::cout << "FleetStateCache tests passed" << std::endl;
+  return 0;
+}
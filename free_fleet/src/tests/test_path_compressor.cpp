@@ -0,0 +1,163 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <limits>
+#include <vector>
+#include <cstdint>
+#include <iostream>
+
+#include <dds/dds.h>
+
+#include <free_fleet/messages/Location.hpp>
+#include <free_fleet/messages/RobotState.hpp>
+#include <free_fleet/messages/PathRequest.hpp>
+
+#include "../messages/FleetMessages.h"
+#include "../messages/message_utils.hpp"
+#include "../messages/PathCompressor.hpp"
+
+using free_fleet::messages::Location;
+using free_fleet::messages::PathCompressor;
+
+std::vector<Location> make_path(size_t _length)
+{
+  std::vector<Location> path;
+  for (size_t i = 0; i < _length; ++i)
+  {
+    path.push_back(
+        Location{
+            static_cast<int32_t>(1591866000 + i / 2),
+            static_cast<uint32_t>((i % 2) * 500000000),
+            0.25f * static_cast<float>(i),
+            -0.5f * static_cast<float>(i),
+            0.01f * static_cast<float>(i),
+            i < _length / 2 ? "L1" : "L2"});
+  }
+  return path;
+}
+
+int main()
+{
+  const bool lz4 = free_fleet::messages::path_compression_available();
+  std::cout << "LZ4 compression is "
+      << (lz4 ? "available" : "not available") << std::endl;
+
+  FreeFleetData_CompressedRobotState* compressed_state =
+      FreeFleetData_CompressedRobotState__alloc();
+  FreeFleetData_CompressedPathRequest* compressed_request =
+      FreeFleetData_CompressedPathRequest__alloc();
+
+  free_fleet::messages::RobotState robot_state;
+  robot_state.name = "robot";
+  robot_state.model = "model";
+  robot_state.task_id = "task";
+  robot_state.mode.mode = free_fleet::messages::RobotMode::MODE_MOVING;
+  robot_state.battery_percent = 50.0f;
+  robot_state.location = Location{1, 2, 3.0f, 4.0f, 0.5f, "L1"};
+
+  free_fleet::messages::PathRequest request;
+  request.fleet_name = "fleet";
+  request.robot_name = "robot";
+  request.task_id = "task";
+
+  /* Paths of every length survive a round trip, whether they are below the
+   * threshold or get compressed. Each compressor is used twice, as it keeps
+   * its buffer between conversions. */
+  for (size_t threshold : {size_t(0), size_t(1) << 20})
+  {
+    PathCompressor compressor(threshold);
+    for (size_t length : {0, 1, 100, 100})
+    {
+      robot_state.path = make_path(length);
+      request.path = make_path(length);
+      compressor.convert(robot_state, *compressed_state);
+      compressor.convert(request, *compressed_request);
+
+      // Only long paths are compressed, and only with LZ4
+      const bool compressed =
+          compressed_state->compressed_path.data._length > 0;
+      if (compressed != (lz4 && threshold == 0 && length >= 100) ||
+          compressed_state->compressed_path.path_length != length)
+      {
+        std::cerr << "path of length " << length << " with threshold "
+            << threshold << " was compressed: " << compressed << std::endl;
+        return 1;
+      }
+
+      free_fleet::messages::RobotState decoded_state;
+      free_fleet::messages::PathRequest decoded_request;
+      if (!free_fleet::messages::convert(*compressed_state, decoded_state) ||
+          !free_fleet::messages::convert(
+              *compressed_request, decoded_request))
+      {
+        std::cerr << "failed to decompress a path of length " << length
+            << std::endl;
+        return 1;
+      }
+
+      if (decoded_state.name != "robot" ||
+          decoded_state.model != "model" ||
+          decoded_state.task_id != "task" ||
+          decoded_state.mode.mode != robot_state.mode.mode ||
+          decoded_state.battery_percent != 50.0f ||
+          decoded_state.location.x != 3.0f ||
+          decoded_state.location.level_name != "L1" ||
+          !free_fleet::messages::same_path(
+              decoded_state.path, robot_state.path))
+      {
+        std::cerr << "robot state with a path of length " << length
+            << " changed in the round trip" << std::endl;
+        return 1;
+      }
+
+      if (decoded_request.fleet_name != "fleet" ||
+          decoded_request.robot_name != "robot" ||
+          decoded_request.task_id != "task" ||
+          !free_fleet::messages::same_path(
+              decoded_request.path, request.path))
+      {
+        std::cerr << "path request with a path of length " << length
+            << " changed in the round trip" << std::endl;
+        return 1;
+      }
+    }
+  }
+
+  /* An encoded size from the wire that is larger than LZ4 can expand the
+   * data to is rejected before any buffer gets resized to it. */
+  if (lz4)
+  {
+    PathCompressor compressor(0);
+    robot_state.path = make_path(100);
+    compressor.convert(robot_state, *compressed_state);
+    compressed_state->compressed_path.encoded_size =
+        std::numeric_limits<uint32_t>::max();
+
+    free_fleet::messages::RobotState decoded_state;
+    if (free_fleet::messages::convert(*compressed_state, decoded_state))
+    {
+      std::cerr << "accepted a corrupt encoded size" << std::endl;
+      return 1;
+    }
+  }
+
+  FreeFleetData_CompressedRobotState_free(compressed_state, DDS_FREE_ALL);
+  FreeFleetData_CompressedPathRequest_free(compressed_request, DDS_FREE_ALL);
+
+  std::cout << "PathCompressor tests passed" << std::endl;
+  return 0;
+}
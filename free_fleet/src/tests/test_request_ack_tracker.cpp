@@ -0,0 +1,164 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <chrono>
+#include <string>
+#include <vector>
+#include <iostream>
+
+#include <free_fleet/messages/RequestAck.hpp>
+
+#include "../RequestAckTracker.hpp"
+
+using free_fleet::RequestAckTracker;
+using free_fleet::messages::RequestAck;
+using std::chrono::milliseconds;
+
+int main()
+{
+  const RequestAckTracker::Clock::time_point start;
+  RequestAckTracker::Clock::duration latency;
+
+  /* Acknowledgements only match requests of the same type, robot and task,
+   * and only the first one is passed on. */
+  RequestAckTracker tracker(8, 8);
+  tracker.sent(RequestAck::REQUEST_PATH, "fleet", "robot", "1", start);
+
+  RequestAck ack{"fleet", "robot", "1", RequestAck::REQUEST_MODE, true};
+  const auto now = start + milliseconds(5);
+  if (tracker.acknowledged(ack, now, latency))
+  {
+    std::cerr << "acknowledged a request of another type" << std::endl;
+    return 1;
+  }
+  ack.request_type = RequestAck::REQUEST_PATH;
+  ack.robot_name = "other_robot";
+  if (tracker.acknowledged(ack, now, latency))
+  {
+    std::cerr << "acknowledged a request of another robot" << std::endl;
+    return 1;
+  }
+  ack.robot_name = "robot";
+  if (!tracker.acknowledged(ack, now, latency) ||
+      latency != milliseconds(5) ||
+      tracker.acknowledged(ack, now, latency) ||
+      tracker.latency().count != 1)
+  {
+    std::cerr << "request was not acknowledged exactly once" << std::endl;
+    return 1;
+  }
+
+  /* Robots with the same name in other fleets do not acknowledge the
+   * request. */
+  ack.task_id = "3";
+  tracker.sent(RequestAck::REQUEST_PATH, "fleet", "robot", "3", start);
+  ack.fleet_name = "other_fleet";
+  if (tracker.acknowledged(ack, now, latency))
+  {
+    std::cerr << "acknowledged a request of another fleet" << std::endl;
+    return 1;
+  }
+  ack.fleet_name = "fleet";
+  if (!tracker.acknowledged(ack, now, latency))
+  {
+    std::cerr << "request of the fleet was not acknowledged" << std::endl;
+    return 1;
+  }
+
+  /* Resent requests measure their latency from the last send, but are left
+   * out of the percentiles, as the acknowledgement could be for either. */
+  ack.task_id = "2";
+  if (!tracker.sent(RequestAck::REQUEST_PATH, "fleet", "robot", "2", start) ||
+      tracker.sent(
+          RequestAck::REQUEST_PATH, "fleet", "robot", "2",
+          start + milliseconds(10)))
+  {
+    std::cerr << "resent request was not tracked as resent" << std::endl;
+    return 1;
+  }
+  if (!tracker.acknowledged(ack, start + milliseconds(12), latency) ||
+      latency != milliseconds(2) ||
+      tracker.latency().count != 2)
+  {
+    std::cerr << "resent request was counted in the percentiles"
+        << std::endl;
+    return 1;
+  }
+
+  /* Percentiles are taken over the latest latency_window latencies. */
+  RequestAckTracker latency_tracker(200, 100);
+  ack.request_type = RequestAck::REQUEST_DESTINATION;
+  for (int i = 1; i <= 200; ++i)
+  {
+    ack.task_id = std::to_string(i);
+    latency_tracker.sent(
+        RequestAck::REQUEST_DESTINATION, "fleet", "robot", ack.task_id,
+        start);
+    // The first 100 latencies are pushed out of the window by the rest
+    const auto latency_ms = milliseconds(i <= 100 ? 1000 : i - 100);
+    latency_tracker.acknowledged(ack, start + latency_ms, latency);
+  }
+  const auto percentiles = latency_tracker.latency();
+  if (percentiles.count != 100 ||
+      percentiles.p50 != milliseconds(50) ||
+      percentiles.p90 != milliseconds(90) ||
+      percentiles.p99 != milliseconds(99) ||
+      percentiles.max != milliseconds(100))
+  {
+    std::cerr << "unexpected latency percentiles" << std::endl;
+    return 1;
+  }
+
+  /* Unacknowledged requests come oldest first, and the oldest ones are
+   * dropped once more than max_pending are tracked. */
+  RequestAckTracker pending_tracker(2, 8);
+  for (int i = 1; i <= 3; ++i)
+  {
+    pending_tracker.sent(
+        RequestAck::REQUEST_MODE, "fleet", "robot", std::to_string(i),
+        start + milliseconds(10 * i));
+  }
+  std::vector<free_fleet::Server::UnacknowledgedRequest> requests;
+
+  /* Requests that failed to be published are no longer tracked. */
+  pending_tracker.unsent(RequestAck::REQUEST_MODE, "fleet", "robot", "3");
+  pending_tracker.unsent(
+      RequestAck::REQUEST_MODE, "fleet", "unknown_robot", "2");
+  pending_tracker.unacknowledged(
+      start + milliseconds(40), milliseconds(0), requests);
+  if (requests.size() != 1)
+  {
+    std::cerr << "unsent request is still tracked" << std::endl;
+    return 1;
+  }
+
+  requests.clear();
+  pending_tracker.unacknowledged(
+      start + milliseconds(40), milliseconds(15), requests);
+  if (requests.size() != 1 ||
+      requests[0].task_id != "2" ||
+      requests[0].robot_name != "robot" ||
+      requests[0].request_type != RequestAck::REQUEST_MODE ||
+      requests[0].age != milliseconds(20))
+  {
+    std::cerr << "unexpected unacknowledged requests" << std::endl;
+    return 1;
+  }
+
+  std::cout << "RequestAckTracker tests passed" << std::endl;
+  return 0;
+}
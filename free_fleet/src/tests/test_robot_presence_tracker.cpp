@@ -0,0 +1,144 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <chrono>
+#include <string>
+#include <vector>
+#include <iostream>
+
+#include <free_fleet/messages/RobotState.hpp>
+
+#include "../RobotPresenceTracker.hpp"
+
+using free_fleet::RobotPresenceTracker;
+using Presence = RobotPresenceTracker::Presence;
+using Changes = std::vector<RobotPresenceTracker::Change>;
+using std::chrono::milliseconds;
+
+bool changed_to(
+    const Changes& _changes, const std::string& _robot_name,
+    Presence _presence)
+{
+  return _changes.size() == 1 &&
+      _changes[0].robot_name == _robot_name &&
+      _changes[0].presence == _presence;
+}
+
+int main()
+{
+  const RobotPresenceTracker::Clock::time_point start;
+  RobotPresenceTracker tracker(milliseconds(100));
+  Changes changes;
+  Presence presence;
+
+  /* Robots become alive with their first robot state, only the first
+   * robot_state_count robot states count. */
+  std::vector<free_fleet::messages::RobotState> robot_states(2);
+  robot_states[0].name = "robot_1";
+  robot_states[1].name = "robot_2";
+  tracker.received(robot_states, 1, start, changes);
+  if (!changed_to(changes, "robot_1", Presence::ALIVE) ||
+      tracker.find("robot_2", presence))
+  {
+    std::cerr << "first robot state did not make the robot alive"
+        << std::endl;
+    return 1;
+  }
+
+  changes.clear();
+  tracker.received(robot_states, 1, start + milliseconds(10), changes);
+  if (!changes.empty())
+  {
+    std::cerr << "alive robot changed presence" << std::endl;
+    return 1;
+  }
+
+  /* Missed deadlines only make the robots stale whose last robot state is
+   * about a deadline old. */
+  robot_states[0].name = "robot_2";
+  tracker.received(robot_states, 1, start + milliseconds(60), changes);
+  changes.clear();
+  tracker.deadline_missed(start + milliseconds(80), changes);
+  if (!changes.empty())
+  {
+    std::cerr << "deadline missed before any robot was late" << std::endl;
+    return 1;
+  }
+
+  tracker.deadline_missed(start + milliseconds(105), changes);
+  if (!changed_to(changes, "robot_1", Presence::STALE))
+  {
+    std::cerr << "late robot did not become stale" << std::endl;
+    return 1;
+  }
+
+  changes.clear();
+  robot_states[0].name = "robot_1";
+  tracker.received(robot_states, 1, start + milliseconds(120), changes);
+  if (!changed_to(changes, "robot_1", Presence::ALIVE))
+  {
+    std::cerr << "stale robot did not become alive again" << std::endl;
+    return 1;
+  }
+
+  /* Lost writers make their robots lost once, and those are no longer
+   * visited by missed deadlines. A writer that becomes alive again before
+   * its next robot state leaves the robot stale. */
+  changes.clear();
+  tracker.liveliness_changed("robot_1", false, changes);
+  tracker.liveliness_changed("robot_1", false, changes);
+  tracker.liveliness_changed("unknown_robot", false, changes);
+  if (!changed_to(changes, "robot_1", Presence::LOST))
+  {
+    std::cerr << "lost writer did not make the robot lost once"
+        << std::endl;
+    return 1;
+  }
+
+  changes.clear();
+  tracker.deadline_missed(start + milliseconds(400), changes);
+  if (!changed_to(changes, "robot_2", Presence::STALE) ||
+      !tracker.find("robot_1", presence) || presence != Presence::LOST)
+  {
+    std::cerr << "missed deadline visited a lost robot" << std::endl;
+    return 1;
+  }
+
+  changes.clear();
+  tracker.liveliness_changed("robot_1", true, changes);
+  if (!changed_to(changes, "robot_1", Presence::STALE))
+  {
+    std::cerr << "writer that came back did not make the robot stale"
+        << std::endl;
+    return 1;
+  }
+
+  /* Robots never become stale without a deadline. */
+  RobotPresenceTracker untimed_tracker(milliseconds(0));
+  changes.clear();
+  untimed_tracker.received(robot_states, 1, start, changes);
+  changes.clear();
+  untimed_tracker.deadline_missed(start + std::chrono::hours(1), changes);
+  if (!changes.empty())
+  {
+    std::cerr << "robot became stale without a deadline" << std::endl;
+    return 1;
+  }
+
+  std::cout << "RobotPresenceTracker tests passed" << std::endl;
+  return 0;
+}
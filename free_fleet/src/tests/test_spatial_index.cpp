@@ -0,0 +1,134 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <string>
+#include <vector>
+#include <iostream>
+#include <algorithm>
+
+#include <free_fleet/messages/Location.hpp>
+
+#include "../SpatialIndex.hpp"
+
+using free_fleet::SpatialIndex;
+using free_fleet::messages::Location;
+
+using Names = std::vector<std::string>;
+
+void print_names(const char* _query, const Names& _robot_names)
+{
+  std::cerr << _query << " found [";
+  for (const auto& robot_name : _robot_names)
+    std::cerr << " " << robot_name;
+  std::cerr << " ]" << std::endl;
+}
+
+int main()
+{
+  /* Robots on two levels, spread over several cells. */
+  SpatialIndex index(1.0);
+  index.update("robot_1", Location{0, 0, 0.5f, 0.5f, 0.0f, "L1"});
+  index.update("robot_2", Location{0, 0, 3.0f, 0.0f, 0.0f, "L1"});
+  index.update("robot_3", Location{0, 0, -2.0f, -2.0f, 0.0f, "L1"});
+  index.update("robot_4", Location{0, 0, 0.5f, 0.5f, 0.0f, "L2"});
+  if (index.size() != 4)
+  {
+    std::cerr << "indexed " << index.size() << " robots instead of 4"
+        << std::endl;
+    return 1;
+  }
+
+  /* Nearest robots come closest first, and only from the same level. */
+  Names robot_names;
+  index.find_nearest("L1", 0.0f, 0.0f, 2, robot_names);
+  if (robot_names != Names{"robot_1", "robot_3"})
+  {
+    print_names("find_nearest", robot_names);
+    return 1;
+  }
+
+  robot_names.clear();
+  index.find_nearest("L1", 10.0f, 0.0f, 10, robot_names);
+  if (robot_names != Names{"robot_2", "robot_1", "robot_3"})
+  {
+    print_names("find_nearest past the last cell", robot_names);
+    return 1;
+  }
+
+  robot_names.clear();
+  index.find_nearest("unknown_level", 0.0f, 0.0f, 10, robot_names);
+  if (!robot_names.empty())
+  {
+    print_names("find_nearest on an unknown level", robot_names);
+    return 1;
+  }
+
+  /* Area queries return robots in no particular order, the bounds of the
+   * rectangle are included. */
+  robot_names.clear();
+  index.find_in_radius("L1", 0.0f, 0.0f, 2.9f, robot_names);
+  std::sort(robot_names.begin(), robot_names.end());
+  if (robot_names != Names{"robot_1", "robot_3"})
+  {
+    print_names("find_in_radius", robot_names);
+    return 1;
+  }
+
+  robot_names.clear();
+  index.find_in_rectangle("L1", 0.5f, -1.0f, 3.0f, 0.5f, robot_names);
+  std::sort(robot_names.begin(), robot_names.end());
+  if (robot_names != Names{"robot_1", "robot_2"})
+  {
+    print_names("find_in_rectangle", robot_names);
+    return 1;
+  }
+
+  /* Robots that move are found in their new cell and level only. */
+  index.update("robot_1", Location{0, 0, 50.0f, 50.0f, 0.0f, "L1"});
+  index.update("robot_1", Location{0, 0, 0.0f, 0.0f, 0.0f, "L2"});
+  robot_names.clear();
+  index.find_in_radius("L1", 50.0f, 50.0f, 1.0f, robot_names);
+  index.find_in_radius("L2", 0.0f, 0.0f, 0.5f, robot_names);
+  if (index.size() != 4 || robot_names != Names{"robot_1"})
+  {
+    print_names("find_in_radius after moving", robot_names);
+    return 1;
+  }
+
+  /* Removed robots are no longer found, until their next update. */
+  index.remove("robot_1");
+  index.remove("unknown_robot");
+  robot_names.clear();
+  index.find_nearest("L2", 0.0f, 0.0f, 10, robot_names);
+  if (index.size() != 3 || robot_names != Names{"robot_4"})
+  {
+    print_names("find_nearest after removing", robot_names);
+    return 1;
+  }
+
+  index.update("robot_1", Location{0, 0, 0.4f, 0.0f, 0.0f, "L1"});
+  robot_names.clear();
+  index.find_nearest("L1", 0.0f, 0.0f, 1, robot_names);
+  if (index.size() != 4 || robot_names != Names{"robot_1"})
+  {
+    print_names("find_nearest after updating again", robot_names);
+    return 1;
+  }
+
+  std::cout << "SpatialIndex tests passed" << std::endl;
+  return 0;
+}
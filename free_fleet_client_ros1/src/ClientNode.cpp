@@ -18,6 +18,7 @@
 #include "utilities.hpp"
 #include "ClientNode.hpp"
 #include "ClientNodeConfig.hpp"
+#include <chrono>
 #include <iostream>
 #include <vector>
 
@@ -149,7 +150,6 @@ void ClientNode::start(Fields _fields)
 {
   fields = std::move(_fields);
 
-  update_rate.reset(new ros::Rate(client_node_config.update_frequency));
   publish_rate.reset(new ros::Rate(client_node_config.publish_frequency));
 
   battery_sub = node->subscribe(
@@ -296,23 +296,44 @@ void ClientNode::publish_robot_state()
     }
   }
 
-  if (!fields.client->send_robot_state(new_robot_state))
-    ROS_WARN("failed to send robot state: msg sec %u", new_robot_state.location.sec);
+  // The state is moved into the client, so its stamp is kept for logging
+  const int32_t sec = new_robot_state.location.sec;
+  if (!fields.client->send_robot_state(std::move(new_robot_state)))
+    ROS_WARN("failed to send robot state: msg sec %d", sec);
 }
 
 bool ClientNode::is_valid_request(
+    uint32_t _request_type,
     const std::string& _request_fleet_name,
     const std::string& _request_robot_name,
     const std::string& _request_task_id)
 {
-  ReadLock task_id_lock(task_id_mutex);
-  if (current_task_id == _request_task_id ||
-      client_node_config.robot_name != _request_robot_name ||
+  if (client_node_config.robot_name != _request_robot_name ||
       client_node_config.fleet_name != _request_fleet_name)
     return false;
+
+  // The server sends the current task again if it missed its ack. Requests
+  // of other types may reuse the task ID, and are handled as new requests.
+  ReadLock task_id_lock(task_id_mutex);
+  if (current_task_id == _request_task_id &&
+      current_task_request_type == _request_type)
+  {
+    send_request_ack(_request_type, _request_task_id, true);
+    return false;
+  }
   return true;
 }
 
+void ClientNode::send_request_ack(
+    uint32_t _request_type, const std::string& _task_id, bool _accepted)
+{
+  const messages::RequestAck request_ack{
+      client_node_config.fleet_name, client_node_config.robot_name,
+      _task_id, _request_type, _accepted};
+  if (!fields.client->send_request_ack(request_ack))
+    ROS_WARN("failed to send request ack: task id %s", _task_id.c_str());
+}
+
 ipa_navigation_msgs::MoveBaseGoal ClientNode::location_to_move_base_goal(
     const messages::Location& _location) const
 {
@@ -335,9 +356,23 @@ bool ClientNode::read_mode_request()
   std::vector<messages::ModeParameter> mode_parameters;
   if (fields.client->read_mode_request(mode_request) && 
       is_valid_request(
-          mode_request.fleet_name, mode_request.robot_name, 
+          messages::RequestAck::REQUEST_MODE,
+          mode_request.fleet_name, mode_request.robot_name,
           mode_request.task_id))
   {
+    // The request is acknowledged once it is accepted for execution, as the
+    // docking and tool services below can block for a long time. When they
+    // fail, the robot state reports a request error for this task instead.
+    send_request_ack(
+        messages::RequestAck::REQUEST_MODE, mode_request.task_id, true);
+
+    {
+      WriteLock task_id_lock(task_id_mutex);
+      current_task_id = mode_request.task_id;
+      current_task_request_type = messages::RequestAck::REQUEST_MODE;
+    }
+    request_error = false;
+
     if (mode_request.mode.mode == messages::RobotMode::MODE_PAUSED)
     {
       ROS_INFO("received a PAUSE command.");
@@ -434,11 +469,6 @@ bool ClientNode::read_mode_request()
       }
       using_tool = false;
     }    
-
-    WriteLock task_id_lock(task_id_mutex);
-    current_task_id = mode_request.task_id;
-
-    request_error = false;
     return true;
   }
   return false;
@@ -449,35 +479,58 @@ bool ClientNode::read_path_request()
   messages::PathRequest path_request;
   if (fields.client->read_path_request(path_request) &&
       is_valid_request(
+          messages::RequestAck::REQUEST_PATH,
           path_request.fleet_name, path_request.robot_name,
           path_request.task_id))
   {
     ROS_INFO("received a Path command of size %lu.", path_request.path.size());
 
     if (path_request.path.size() <= 0)
+    {
+      send_request_ack(
+          messages::RequestAck::REQUEST_PATH, path_request.task_id, false);
       return false;
+    }
+
+    const messages::PathSoA path(path_request.path);
+    ROS_INFO("path length: %.2f, duration: %.2f",
+        path.length(), path.duration());
 
     // Sanity check: the first waypoint of the Path must be within N meters of
-    // our current position. Otherwise, ignore the request.
+    // our current position, and consecutive waypoints must be within M
+    // meters of each other. Otherwise, ignore the request.
     {
       ReadLock robot_transform_lock(robot_transform_mutex);
-      const double dx =
-          path_request.path[0].x - 
-          current_robot_transform.transform.translation.x;
-      const double dy =
-          path_request.path[0].y -
-          current_robot_transform.transform.translation.y;
-      const double dist_to_first_waypoint = sqrt(dx*dx + dy*dy);
+      const double dist_to_first_waypoint = path.distance_to(
+          0,
+          current_robot_transform.transform.translation.x,
+          current_robot_transform.transform.translation.y);
 
       ROS_INFO("distance to first waypoint: %.2f\n", dist_to_first_waypoint);
 
-      if (dist_to_first_waypoint > 
-          client_node_config.max_dist_to_first_waypoint)
+      const double max_segment_length = path.max_segment_length();
+      const bool first_waypoint_too_far =
+          dist_to_first_waypoint > 
+          client_node_config.max_dist_to_first_waypoint;
+      const bool waypoints_too_far =
+          client_node_config.max_dist_between_waypoints > 0.0 &&
+          max_segment_length > client_node_config.max_dist_between_waypoints;
+
+      if (first_waypoint_too_far || waypoints_too_far)
       {
-        ROS_WARN("distance was over threshold of %.2f ! Rejecting path,"
-            "waiting for next valid request.\n",
-            client_node_config.max_dist_to_first_waypoint);
+        if (first_waypoint_too_far)
+          ROS_WARN("distance was over threshold of %.2f ! Rejecting path,"
+              "waiting for next valid request.\n",
+              client_node_config.max_dist_to_first_waypoint);
+        else
+          ROS_WARN("distance between waypoints of %.2f was over threshold "
+              "of %.2f ! Rejecting path, waiting for next valid request.\n",
+              max_segment_length,
+              client_node_config.max_dist_between_waypoints);
         
+        send_request_ack(
+            messages::RequestAck::REQUEST_PATH, path_request.task_id, false);
+
         fields.move_base_client->cancelAllGoals();
         WriteLock goal_path_lock(goal_path_mutex);
         goal_path.clear();
@@ -503,8 +556,12 @@ bool ClientNode::read_path_request()
                   path_request.path[i].sec, path_request.path[i].nanosec)});
     }
 
+    send_request_ack(
+        messages::RequestAck::REQUEST_PATH, path_request.task_id, true);
+
     WriteLock task_id_lock(task_id_mutex);
     current_task_id = path_request.task_id;
+    current_task_request_type = messages::RequestAck::REQUEST_PATH;
 
     if (paused)
       paused = false;
@@ -520,6 +577,7 @@ bool ClientNode::read_destination_request()
   messages::DestinationRequest destination_request;
   if (fields.client->read_destination_request(destination_request) &&
       is_valid_request(
+          messages::RequestAck::REQUEST_DESTINATION,
           destination_request.fleet_name, destination_request.robot_name,
           destination_request.task_id))
   {
@@ -539,8 +597,13 @@ bool ClientNode::read_destination_request()
                 destination_request.destination.sec, 
                 destination_request.destination.nanosec)});
 
+    send_request_ack(
+        messages::RequestAck::REQUEST_DESTINATION,
+        destination_request.task_id, true);
+
     WriteLock task_id_lock(task_id_mutex);
     current_task_id = destination_request.task_id;
+    current_task_request_type = messages::RequestAck::REQUEST_DESTINATION;
 
     if (paused)
       paused = false;
@@ -691,9 +754,15 @@ void ClientNode::handle_requests()
 
 void ClientNode::update_thread_fn()
 {
+  // Instead of sleeping for the whole update period, wake up as soon as a
+  // new request arrives, so that commands are dispatched immediately.
+  const auto update_period = std::chrono::duration_cast<
+      std::chrono::nanoseconds>(std::chrono::duration<double>(
+          1.0 / client_node_config.update_frequency));
+
   while (node->ok())
   {
-    update_rate->sleep();
+    fields.client->wait_for_requests(update_period);
     ros::spinOnce();
 
     get_robot_transform();
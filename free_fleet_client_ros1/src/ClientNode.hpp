@@ -37,6 +37,8 @@
 
 #include <free_fleet/Client.hpp>
 #include <free_fleet/messages/Location.hpp>
+#include <free_fleet/messages/PathSoA.hpp>
+#include <free_fleet/messages/RequestAck.hpp>
 
 #include "ClientNodeConfig.hpp"
 
@@ -89,8 +91,6 @@ private:
 
   std::unique_ptr<ros::NodeHandle> node;
 
-  std::unique_ptr<ros::Rate> update_rate;
-
   std::unique_ptr<ros::Rate> publish_rate;
 
   // --------------------------------------------------------------------------
@@ -152,10 +152,14 @@ private:
   // Task handling
 
   bool is_valid_request(
+      uint32_t request_type,
       const std::string& request_fleet_name,
       const std::string& request_robot_name,
       const std::string& request_task_id);
 
+  void send_request_ack(
+      uint32_t request_type, const std::string& task_id, bool accepted);
+
   ipa_navigation_msgs::MoveBaseGoal location_to_move_base_goal(
       const messages::Location& location) const;
 
@@ -163,6 +167,9 @@ private:
 
   std::string current_task_id;
 
+  // Type of the request that current_task_id was accepted from
+  uint32_t current_task_request_type = messages::RequestAck::REQUEST_MODE;
+
   struct Goal
   {
     std::string level_name;
@@ -75,6 +75,8 @@ void ClientNodeConfig::print_config() const
   printf("  publish state frequency: %.1f\n", publish_frequency);
   printf("  maximum distance to first waypoint: %.1f\n", 
       max_dist_to_first_waypoint);
+  printf("  maximum distance between waypoints: %.1f\n",
+      max_dist_between_waypoints);
   printf("  TOPICS\n");
   printf("    battery state: %s\n", battery_state_topic.c_str());
   printf("    move base server: %s\n", move_base_server_name.c_str());
@@ -92,6 +94,12 @@ void ClientNodeConfig::print_config() const
   printf("    path request: %s\n", dds_path_request_topic.c_str());
   printf("    destination request: %s\n", 
       dds_destination_request_topic.c_str());
+  printf("    robot state delta: %s\n", dds_state_delta_topic.c_str());
+  printf("  state keyframe interval: %d\n", state_keyframe_interval);
+  printf("  state deadline: %.2f\n", dds_state_deadline);
+  printf("  state liveliness lease duration: %.2f\n",
+      dds_state_liveliness_lease_duration);
+  printf("  robot id announce interval: %d\n", robot_id_announce_interval);
 }
   
 ClientConfig ClientNodeConfig::get_client_config() const
@@ -102,6 +110,19 @@ ClientConfig ClientNodeConfig::get_client_config() const
   client_config.dds_mode_request_topic = dds_mode_request_topic;
   client_config.dds_path_request_topic = dds_path_request_topic;
   client_config.dds_destination_request_topic = dds_destination_request_topic;
+  client_config.dds_state_delta_topic = dds_state_delta_topic;
+  client_config.dds_state_qos.deadline = dds_state_deadline;
+  client_config.dds_state_qos.liveliness_lease_duration =
+      dds_state_liveliness_lease_duration;
+  client_config.state_keyframe_interval =
+      state_keyframe_interval > 0 ?
+          static_cast<size_t>(state_keyframe_interval) : 0;
+  client_config.fleet_name = fleet_name;
+  client_config.robot_name = robot_name;
+  client_config.robot_ids = robot_id_announce_interval > 0;
+  if (client_config.robot_ids)
+    client_config.robot_id_announce_interval =
+        static_cast<size_t>(robot_id_announce_interval);
   return client_config;
 }
 
@@ -139,6 +160,19 @@ ClientNodeConfig ClientNodeConfig::make()
   config.get_param_if_available(
       node_private_ns, "dds_destination_request_topic", 
       config.dds_destination_request_topic);
+  config.get_param_if_available(
+      node_private_ns, "dds_state_delta_topic", config.dds_state_delta_topic);
+  config.get_param_if_available(
+      node_private_ns, "state_keyframe_interval",
+      config.state_keyframe_interval);
+  config.get_param_if_available(
+      node_private_ns, "dds_state_deadline", config.dds_state_deadline);
+  config.get_param_if_available(
+      node_private_ns, "dds_state_liveliness_lease_duration",
+      config.dds_state_liveliness_lease_duration);
+  config.get_param_if_available(
+      node_private_ns, "robot_id_announce_interval",
+      config.robot_id_announce_interval);
   config.get_param_if_available(
       node_private_ns, "wait_timeout", config.wait_timeout);
   config.get_param_if_available(
@@ -148,6 +182,9 @@ ClientNodeConfig ClientNodeConfig::make()
   config.get_param_if_available(
       node_private_ns, "max_dist_to_first_waypoint", 
       config.max_dist_to_first_waypoint);
+  config.get_param_if_available(
+      node_private_ns, "max_dist_between_waypoints",
+      config.max_dist_between_waypoints);
   return config;
 }
 
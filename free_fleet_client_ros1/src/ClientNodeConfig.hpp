@@ -54,6 +54,20 @@ struct ClientNodeConfig
   std::string dds_mode_request_topic = "mode_request";
   std::string dds_path_request_topic = "path_request";
   std::string dds_destination_request_topic = "destination_request";
+  std::string dds_state_delta_topic = "robot_state_delta";
+  int state_keyframe_interval = 0;
+
+  // Deadline and liveliness lease duration in seconds of the robot states,
+  // which need to be no longer than those of a server tracking the robot
+  // presence for the robot states to be received at all. Infinite when not
+  // positive.
+  double dds_state_deadline = 0.0;
+  double dds_state_liveliness_lease_duration = 0.0;
+
+  // Addresses robot states and requests by a robot ID assigned by the server,
+  // with a full robot state announcing the robot name once every this many
+  // robot states. Disabled when not positive.
+  int robot_id_announce_interval = 0;
 
   double wait_timeout = 10.0;
   double update_frequency = 10.0;
@@ -61,6 +75,10 @@ struct ClientNodeConfig
 
   double max_dist_to_first_waypoint = 10.0;
 
+  // Maximum distance between consecutive waypoints of a path, paths with
+  // longer segments are rejected. Disabled when not positive.
+  double max_dist_between_waypoints = 0.0;
+
   void get_param_if_available(
       const ros::NodeHandle& node, const std::string& key, 
       std::string& param_out);